@@ -0,0 +1,222 @@
+/**
+ * @file benchArtNet.cpp
+ * @author your name (you@domain.com)
+ * @brief regression benchmark of the packet paths, ns/packet and heap allocations/packet over the
+ * in memory transport, fails if the heap is used after construction
+ * @version 0.1
+ * @date 2026-01-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetFakeTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+}
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *_memory = malloc(size ? size : 1);
+    if (_memory == nullptr) {
+#ifdef ARTNET_NO_EXCEPTIONS
+        abort();
+#else
+        throw std::bad_alloc();
+#endif
+    }
+    return _memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace {
+
+constexpr uint32_t iterations = 200000;
+constexpr uint16_t portCount = 64;
+constexpr uint16_t universeCount = 64;
+constexpr uint16_t artNzsLen = 18 + 64;
+
+ArtNetNode::portStorage<portCount> benchPorts;
+ArtNetController::controllerStorage<universeCount, 16> controllerTables;
+
+/**
+ * @brief node giving access to the construction of the poll replies
+ */
+class benchNode : public ArtNetNode {
+public:
+    benchNode(uint8_t *MAC) : ArtNetNode(0x0000, MAC, 6, benchPorts) {
+    }
+
+    using ArtNet::buildPollReply;
+};
+
+/**
+ * @brief run one step iterations times and print the cost per packet
+ *
+ * @param name name of the case
+ * @param packetsPerStep number of packets handled or built by one step
+ * @param step function running one step
+ */
+template<typename stepFunction>
+void runCase(const char *name, uint32_t packetsPerStep, stepFunction step) {
+
+    uint32_t _checksum = 0;
+    uint64_t _transmitted = ArtNetFakeTransport::getCounters().packets;
+    uint64_t _allocations = allocations.load(std::memory_order_relaxed);
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        _checksum += step(i);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+
+    double _packets = static_cast<double>(iterations) * packetsPerStep;
+    double _ns = std::chrono::duration<double, std::nano>(_end - _start).count() / _packets;
+    double _allocs = (allocations.load(std::memory_order_relaxed) - _allocations) / _packets;
+
+    printf("%-26s %9.2f ns/packet %6.3f allocs/packet %6.2f tx/packet (checksum %u)\n", name, _ns, _allocs,
+        (ArtNetFakeTransport::getCounters().packets - _transmitted) / _packets, _checksum);
+}
+
+uint64_t fakeMicros() {
+    static uint64_t _now = 0;
+    return _now += 25;
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t _senderIp[4] = {2, 0, 0, 1};
+
+    static benchNode _node(_mac);
+    _node.setUnicastCallback(ArtNetFakeTransport::sendUnicast);
+    _node.setTimeCallback(fakeMicros);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    uint8_t _artIpProg[33] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0xf8, 0x00, 14, 0, 0, 0x80};
+    uint8_t _artDataRequest[40] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x27, 0x00, 14, 0, 0, 0xff, 0xff, 0x00, 0x01};
+    uint8_t _artAddress[107] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x60, 0x00, 14, 0x7f, 1, 'b', 'e', 'n', 'c', 'h'};
+    uint8_t _artDmx[portCount][530];
+    uint8_t _artNzs[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x51, 0x00, 14, 0, 0x17, 0x00, 0x00, 0x00, 0x40};
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        const uint8_t _header[18] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+        memcpy(_artDmx[i], _header, sizeof(_header));
+        memset(_artDmx[i] + sizeof(_header), i, 512);
+        _artDmx[i][14] = static_cast<uint8_t>(i);
+    }
+
+    static ArtNetController _controller(0x0000, _mac, sizeof(_mac), controllerTables);
+
+    uint8_t _targetIp[4] = {2, 0, 0, 2};
+    uint8_t _dmx[512] = {};
+
+    for (uint16_t i = 0; i < universeCount; i++) {
+        uint16_t _idx;
+        _controller.addUniverse(i, _targetIp, sizeof(_targetIp), _idx);
+        _dmx[0] = static_cast<uint8_t>(i);
+        _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+    }
+
+    ArtNetFakeTransport::reset();
+
+    //everything from here on runs on the statically sized storage
+    uint64_t _constructed = allocations.load(std::memory_order_relaxed);
+
+    printf("node with %u ports, controller with %u universes, in memory transport\n", portCount, universeCount);
+
+    runCase("ArtPoll -> 16 replies", 1, [&](uint32_t) -> uint32_t {
+        return _node.handlePacket(_artPoll, sizeof(_artPoll), _senderIp, sizeof(_senderIp), 0x1936);
+    });
+
+    runCase("ArtPollReply build", 1, [&](uint32_t i) -> uint32_t {
+        _node.buildPollReply(static_cast<uint16_t>(i % (portCount / 4)));
+        return 0;
+    });
+
+    runCase("ArtIpProg (enabled)", 1, [&](uint32_t) -> uint32_t {
+        return _node.handlePacket(_artIpProg, sizeof(_artIpProg), _senderIp, sizeof(_senderIp), 0x1936);
+    });
+
+    runCase("ArtDataRequest -> reply", 1, [&](uint32_t i) -> uint32_t {
+        _artDataRequest[17] = static_cast<uint8_t>(i % 6);
+        return _node.handlePacket(_artDataRequest, sizeof(_artDataRequest), _senderIp, sizeof(_senderIp), 0x1936);
+    });
+
+    runCase("ArtDmx receive", 1, [&](uint32_t i) -> uint32_t {
+        uint8_t *_packet = _artDmx[i % portCount];
+        _packet[12] = static_cast<uint8_t>(i);
+        return _node.handlePacket(_packet, sizeof(_artDmx[0]), _senderIp, sizeof(_senderIp), 0x1936);
+    });
+
+    runCase("ArtNzs receive + output", 1, [&](uint32_t i) -> uint32_t {
+        _artNzs[14] = static_cast<uint8_t>(i % portCount);
+        uint32_t _status = _node.handlePacket(_artNzs, artNzsLen, _senderIp, sizeof(_senderIp), 0x1936);
+        return _status + _node.processNzsOutputs();
+    });
+
+    _controller.setUnicastCallback(ArtNetFakeTransport::sendUnicast);
+    //the Port-Addresses stay as they are, the cost is the transaction, the port map and the reply
+    memset(_artAddress + 96, 0x7f, 8);
+    _artAddress[104] = 0x7f;
+    _artAddress[105] = 0xff;
+    _artAddress[106] = 0x02;    //acLedNormal
+
+    runCase("ArtAddress -> reply", 1, [&](uint32_t i) -> uint32_t {
+        _artAddress[13] = static_cast<uint8_t>(i % (portCount / 4) + 1);
+        return _node.handlePacket(_artAddress, sizeof(_artAddress), _senderIp, sizeof(_senderIp), 0x1936);
+    });
+
+    _node.setChangeReplyWindow(10);
+
+    runCase("ArtAddress burst (10 ms)", 1, [&](uint32_t i) -> uint32_t {
+        _artAddress[13] = static_cast<uint8_t>(i % (portCount / 4) + 1);
+        uint32_t _status = _node.handlePacket(_artAddress, sizeof(_artAddress), _senderIp, sizeof(_senderIp), 0x1936);
+        _node.service();
+        return _status;
+    });
+
+    runCase("ArtDmx transmit unicast", universeCount, [&](uint32_t) -> uint32_t {
+        return _controller.transmitDmx();
+    });
+
+    _controller.setBatchCallback(ArtNetFakeTransport::sendBatch);
+    runCase("ArtDmx transmit batch", universeCount, [&](uint32_t) -> uint32_t {
+        return _controller.transmitDmx();
+    });
+
+    const ArtNetFakeTransport::txCounters &_counters = ArtNetFakeTransport::getCounters();
+    printf("transmitted %lu packets, %lu bytes, %lu batches\n", static_cast<unsigned long>(_counters.packets),
+        static_cast<unsigned long>(_counters.bytes), static_cast<unsigned long>(_counters.batches));
+
+    uint64_t _heapUse = allocations.load(std::memory_order_relaxed) - _constructed;
+    printf("heap allocations after construction: %lu\n", static_cast<unsigned long>(_heapUse));
+
+    return _heapUse == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file benchDispatch.cpp
+ * @author your name (you@domain.com)
+ * @brief microbenchmark of the opCode dispatcher in ArtNet::handlePacket for valid and malformed packets
+ * @version 0.1
+ * @date 2026-01-04
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNet.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint32_t iterations = 2000000;
+
+bool fakeUnicast(uint8_t *, uint16_t, uint8_t *, uint8_t, uint16_t) {
+    return true;
+}
+
+/**
+ * @brief minimal device type to get access to the callbacks of the base class
+ */
+class benchDevice : public ArtNet {
+public:
+    benchDevice(uint8_t *MAC) : ArtNet(0x0000, MAC, 6) {
+        callback_unicast = fakeUnicast;
+    }
+};
+
+/**
+ * @brief run handlePacket on the same packet and print the cost per packet
+ */
+void runCase(benchDevice &device, const char *name, uint8_t *packet, uint16_t packetLen) {
+
+    uint8_t _senderIp[4] = {2, 0, 0, 1};
+    uint32_t _checksum = 0;
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        _checksum += device.handlePacket(packet, packetLen, _senderIp, sizeof(_senderIp), 0x1936);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    double _ns = std::chrono::duration<double, std::nano>(_end - _start).count() / iterations;
+
+    printf("%-24s %8.2f ns/packet (status sum %u)\n", name, _ns, _checksum);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    benchDevice _device(_mac);
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    uint8_t _artIpProg[33] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0xf8, 0x00, 14};
+    uint8_t _unknownOp[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x77, 0x00, 14};
+    uint8_t _oldVersion[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 13};
+    uint8_t _garbage[530];
+
+    uint32_t _seed = 0x12345678;
+    for (uint16_t i = 0; i < sizeof(_garbage); i++) {
+        _seed = _seed * 1664525 + 1013904223;
+        _garbage[i] = static_cast<uint8_t>(_seed >> 24);
+    }
+
+    runCase(_device, "ArtPoll", _artPoll, sizeof(_artPoll));
+    runCase(_device, "ArtIpProg (disabled)", _artIpProg, sizeof(_artIpProg));
+    runCase(_device, "unknown opCode", _unknownOp, sizeof(_unknownOp));
+    runCase(_device, "unsupported version", _oldVersion, sizeof(_oldVersion));
+    runCase(_device, "truncated header", _artPoll, 6);
+    runCase(_device, "random garbage", _garbage, sizeof(_garbage));
+
+    const ArtNet::packetCounters &_counters = _device.getPacketCounters();
+    printf("received %u, ok %u, too short %u, invalid ident %u, bad version %u, unsupported opCode %u\n",
+        _counters.received.load(),
+        _counters.byStatus[ArtNet::psOk].load(),
+        _counters.byStatus[ArtNet::psTooShort].load(),
+        _counters.byStatus[ArtNet::psInvalidIdent].load(),
+        _counters.byStatus[ArtNet::psUnsupportedVersion].load(),
+        _counters.byStatus[ArtNet::psUnsupportedOpCode].load());
+
+    return 0;
+}
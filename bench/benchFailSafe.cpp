@@ -0,0 +1,120 @@
+/**
+ * @file benchFailSafe.cpp
+ * @author your name (you@domain.com)
+ * @brief cost of the fail-safe timer wheel per service() tick for nodes with many ports, while ArtDmx
+ * arrives and while all ports time out, on a simulated clock
+ * @version 0.1
+ * @date 2026-01-25
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint16_t timeOut = 1000;          //milliseconds
+constexpr uint32_t receiveTime = 10000;     //milliseconds of ArtDmx before the loss
+constexpr uint32_t lossTime = 3000;         //milliseconds after the loss
+constexpr uint8_t frameInterval = 25;       //milliseconds, 40 Hz
+
+uint64_t now = 0;
+uint32_t failSafeOutputs = 0;
+uint32_t wrongOutputs = 0;
+
+uint64_t fakeMicros() {
+    return now;
+}
+
+bool checkOutput(uint8_t *dmxData, uint16_t dmxDataSize, uint16_t portIdx) {
+
+    //frames carry their port index + 1 (never 0) in every slot, the fail-safe outputs zero
+    if (dmxData[0] == 0 && dmxData[dmxDataSize - 1] == 0) {
+        failSafeOutputs++;
+    }
+    else if (dmxData[0] != portIdx % 255 + 1) {
+        wrongOutputs++;
+    }
+    return true;
+}
+
+/**
+ * @brief run the simulated clock in steps of one millisecond and time service() on every step
+ *
+ * @return service() time per step in nanoseconds
+ */
+template <uint16_t portCount>
+double runSteps(ArtNetNode &node, uint32_t steps, bool receive) {
+
+    uint8_t _senderIp[4] = {2, 0, 0, 1};
+    uint8_t _dmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    double _serviceNs = 0;
+
+    for (uint32_t s = 0; s < steps; s++) {
+
+        now += 1000;
+
+        if (receive && s % frameInterval == 0) {
+            for (uint16_t i = 0; i < portCount; i++) {
+                _dmx[14] = i & 0xff;
+                _dmx[15] = i >> 8;
+                memset(_dmx + 18, i % 255 + 1, 512);
+                node.handlePacket(_dmx, sizeof(_dmx), _senderIp, sizeof(_senderIp), 0x1936);
+            }
+        }
+
+        auto _start = std::chrono::steady_clock::now();
+        node.service();
+        auto _end = std::chrono::steady_clock::now();
+
+        _serviceNs += std::chrono::duration<double, std::nano>(_end - _start).count();
+        node.processOutputs();
+    }
+
+    return _serviceNs / steps;
+}
+
+/**
+ * @brief feed ArtDmx to every port, stop it and count the ports falling back to zero
+ */
+template <uint16_t portCount>
+void runCase() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetNode::portStorage<portCount> _ports;
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), _ports);
+    _node.setTimeCallback(fakeMicros);
+    _node.setOutputDmxCallback(checkOutput);
+    _node.setFailSafe(ArtNet::fssOutputZero, timeOut);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    failSafeOutputs = 0;
+    wrongOutputs = 0;
+
+    double _receivingNs = runSteps<portCount>(_node, receiveTime, true);
+    uint32_t _early = failSafeOutputs;
+    double _lossNs = runSteps<portCount>(_node, lossTime, false);
+
+    printf("%4u ports: service %7.1f ns/tick receiving, %8.1f ns/tick timing out, %4u fail-safe outputs (%u early, %u wrong)\n",
+        portCount, _receivingNs, _lossNs, failSafeOutputs, _early, wrongOutputs);
+}
+
+}
+
+int main() {
+
+    runCase<4>();
+    runCase<64>();
+    runCase<256>();
+    runCase<1020>();
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file benchFarm.cpp
+ * @author your name (you@domain.com)
+ * @brief memory and CPU cost of virtual nodes, poll replies and ArtDmx per node in memory, the node count
+ * one core sustains and a run over loopback with the nodes on 127.1.0.0/16
+ * @version 0.1
+ * @date 2026-01-22
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetLinuxFarm.hpp>
+#include <ArtNetLinuxUdp.hpp>
+#include <ArtNetNodeFarm.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint16_t nodeCount = 16000;
+constexpr uint32_t dmxIterations = 4000000;
+constexpr uint8_t pollRounds = 20;
+constexpr double dmxRate = 44;              //frames per second and universe
+constexpr double pollInterval = 2.5;        //seconds between two ArtPoll of a controller
+constexpr uint16_t loopbackDmx = 2000;
+
+ArtNetNodeFarm::farmStorage<nodeCount> farmNodes;
+
+uint32_t replies = 0;
+
+uint16_t countReplies(const ArtNet::txPacket *, uint16_t packetCount) {
+    replies += packetCount;
+    return packetCount;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief a controller on a second socket polls part of the farm and sends ArtDmx to single nodes over loopback
+ */
+void runLoopback(ArtNetNodeFarm &farm) {
+
+    uint8_t _firstIp[4] = {127, 1, 0, 1};
+    farm.setFirstIp(_firstIp, sizeof(_firstIp));
+    farm.setBatchCallback(ArtNetLinuxUdp::sendBatch);
+
+    int _controller = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in _local = {};
+    _local.sin_family = AF_INET;
+    _local.sin_port = htons(0x1936);
+    _local.sin_addr.s_addr = htonl(0x7f000002);
+
+    //poll replies go to port 0x1936 of the controller, its own address keeps them apart from the farm
+    int _enable = 1;
+    setsockopt(_controller, SOL_SOCKET, SO_REUSEADDR, &_enable, sizeof(_enable));
+    setsockopt(_controller, SOL_SOCKET, SO_REUSEPORT, &_enable, sizeof(_enable));
+    int _receiveBuffer = 4 * 1024 * 1024;
+    setsockopt(_controller, SOL_SOCKET, SO_RCVBUF, &_receiveBuffer, sizeof(_receiveBuffer));
+
+    if (!ArtNetLinuxFarm::open(0x1936) || _controller < 0 || bind(_controller, reinterpret_cast<sockaddr*>(&_local), sizeof(_local)) != 0) {
+        printf("loopback: skipped, sockets could not be opened\n");
+        ArtNetLinuxFarm::close();
+        return;
+    }
+
+    //targeted ArtPoll for Port-Addresses 0:399, sent to the host so every node sees it
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14, 0x20, 0, 0x01, 0x8f, 0x00, 0x00};
+    sockaddr_in _target = {};
+    _target.sin_family = AF_INET;
+    _target.sin_port = htons(0x1936);
+    _target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(_controller, _artPoll, sizeof(_artPoll), 0, reinterpret_cast<sockaddr*>(&_target), sizeof(_target));
+
+    uint8_t _artDmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint16_t _sentDmx = 0;
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint16_t i = 0; i < loopbackDmx; i++) {
+
+        //every node gets one frame on its first port, unicast to its own ip
+        uint16_t _node = static_cast<uint16_t>(i * 7 % nodeCount);
+        uint8_t _ip[4];
+        farm.getNodeIp(_node, _ip);
+        memcpy(&_target.sin_addr.s_addr, _ip, 4);
+        _artDmx[12] = static_cast<uint8_t>(i % 255 + 1);
+        _artDmx[14] = static_cast<uint8_t>((_node * 4) & 0xff);
+        _artDmx[15] = static_cast<uint8_t>(((_node * 4) >> 8) & 0x7f);
+
+        if (sendto(_controller, _artDmx, sizeof(_artDmx), 0, reinterpret_cast<sockaddr*>(&_target), sizeof(_target)) == sizeof(_artDmx)) {
+            _sentDmx++;
+        }
+
+        ArtNetLinuxFarm::receive(farm, 64);
+    }
+
+    while (ArtNetLinuxFarm::receive(farm, 64) > 0) {
+    }
+
+    double _ns = elapsedNs(_start);
+
+    uint8_t _reply[1536];
+    uint16_t _replies = 0;
+    while (recv(_controller, _reply, sizeof(_reply), MSG_DONTWAIT) > 0) {
+        _replies++;
+    }
+
+    uint16_t _targeted = 0;
+    for (uint16_t n = 0; n < nodeCount; n++) {
+        _targeted += ((n * ArtNetNodeFarm::portsPerNode) & 0x7fff) <= 0x018f ? 1 : 0;
+    }
+
+    uint32_t _consumed = 0;
+    for (uint16_t i = 0; i < loopbackDmx; i++) {
+        ArtNetNodeFarm::virtualPortMetrics _metrics;
+        farm.getPortMetrics(static_cast<uint16_t>(i * 7 % nodeCount), 0, _metrics);
+        _consumed += _metrics.packets > 0 ? 1 : 0;
+    }
+
+    printf("loopback: %u of %u targeted nodes replied to ArtPoll, %u of %u unicast ArtDmx reached their node, %.1f us/packet\n",
+        _replies, _targeted, _consumed, _sentDmx, _ns / 1e3 / _sentDmx);
+
+    close(_controller);
+    ArtNetLinuxFarm::close();
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x00, 0x00};
+
+    static ArtNetNodeFarm _farm(0x0000, _mac, sizeof(_mac), farmNodes);
+    _farm.setBatchCallback(countReplies);
+
+    for (uint16_t n = 0; n < nodeCount; n++) {
+        for (uint8_t p = 0; p < ArtNetNodeFarm::portsPerNode; p++) {
+            _farm.configureNodePort(n, p, static_cast<uint16_t>((n * ArtNetNodeFarm::portsPerNode + p) & 0x7fff));
+        }
+    }
+
+    double _bytesPerNode = static_cast<double>(sizeof(farmNodes)) / nodeCount;
+    printf("%u virtual nodes: storage %zu bytes (%.1f bytes/node), farm object %zu bytes\n", nodeCount, sizeof(farmNodes),
+        _bytesPerNode, sizeof(ArtNetNodeFarm));
+
+    //broadcast ArtPoll, every node replies
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    uint8_t _controllerIp[4] = {2, 0, 0, 10};
+    uint8_t _broadcastIp[4] = {255, 255, 255, 255};
+
+    auto _start = std::chrono::steady_clock::now();
+    for (uint8_t i = 0; i < pollRounds; i++) {
+        _farm.handleFarmPacket(_artPoll, sizeof(_artPoll), _controllerIp, sizeof(_controllerIp), _broadcastIp, sizeof(_broadcastIp));
+    }
+    double _replyNs = elapsedNs(_start) / replies;
+
+    printf("ArtPoll to all nodes: %u replies, %.2f ns/reply\n", replies, _replyNs);
+
+    //unicast ArtDmx, one frame per node and port in turn
+    uint8_t _artDmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint32_t _checksum = 0;
+
+    _start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < dmxIterations; i++) {
+        uint16_t _node = static_cast<uint16_t>(i / ArtNetNodeFarm::portsPerNode % nodeCount);
+        uint16_t _portAddress = static_cast<uint16_t>(i % (nodeCount * ArtNetNodeFarm::portsPerNode) & 0x7fff);
+        uint8_t _nodeIp[4];
+        _farm.getNodeIp(_node, _nodeIp);
+        _artDmx[12] = static_cast<uint8_t>(i / (nodeCount * ArtNetNodeFarm::portsPerNode) % 255 + 1);
+        _artDmx[14] = static_cast<uint8_t>(_portAddress);
+        _artDmx[15] = static_cast<uint8_t>(_portAddress >> 8);
+        _checksum += _farm.handleFarmPacket(_artDmx, sizeof(_artDmx), _controllerIp, sizeof(_controllerIp), _nodeIp, sizeof(_nodeIp));
+    }
+    double _dmxNs = elapsedNs(_start) / dmxIterations;
+
+    ArtNetNodeFarm::virtualPortMetrics _metrics;
+    _farm.getPortMetrics(nodeCount - 1, 3, _metrics);
+    printf("unicast ArtDmx: %.2f ns/packet, last port %u frames %u gaps (checksum %u)\n", _dmxNs, _metrics.packets,
+        _metrics.sequenceGaps, _checksum);
+
+    //broadcast ArtDmx scans the Port-Addresses of all nodes
+    _start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < 20000; i++) {
+        _artDmx[14] = static_cast<uint8_t>(i);
+        _checksum += _farm.handleFarmPacket(_artDmx, sizeof(_artDmx), _controllerIp, sizeof(_controllerIp), _broadcastIp, sizeof(_broadcastIp));
+    }
+    printf("broadcast ArtDmx: %.2f ns/packet over %u ports\n", elapsedNs(_start) / 20000, nodeCount * ArtNetNodeFarm::portsPerNode);
+
+    //every node gets 4 universes at the dmx rate and replies to one controller every poll interval
+    double _nsPerNodeSecond = ArtNetNodeFarm::portsPerNode * dmxRate * _dmxNs + _replyNs / pollInterval;
+    double _maxNodes = 1e9 / _nsPerNodeSecond;
+    printf("sustainable on one core: %.0f nodes (4 universes at %.0f Hz, ArtPoll every %.1f s), %.1f MB of node state\n",
+        _maxNodes, dmxRate, pollInterval, _maxNodes * _bytesPerNode / 1e6);
+
+    runLoopback(_farm);
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file benchFootprint.cpp
+ * @author your name (you@domain.com)
+ * @brief RAM footprint of nodes and controllers per storage configuration, all memory is static so the
+ * sizes are known at compile time
+ * @version 0.1
+ * @date 2026-01-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace {
+
+/**
+ * @brief print the footprint of a node with portCount ports and nzsQueueLen queued ArtNzs frames per port
+ */
+template <uint16_t portCount, uint8_t nzsQueueLen = 2>
+void reportNode() {
+    size_t _storage = sizeof(ArtNetNode::portStorage<portCount, nzsQueueLen>);
+    printf("node       %5u ports      %3u nzs queue      object %6zu  storage %9zu  total %9zu bytes\n",
+        portCount, nzsQueueLen, sizeof(ArtNetNode), _storage, sizeof(ArtNetNode) + _storage);
+}
+
+/**
+ * @brief print the footprint of a controller with the given storage configuration
+ */
+template <uint16_t universeCount, uint16_t nodeSlots, uint16_t batchLen>
+void reportController() {
+    size_t _storage = sizeof(ArtNetController::controllerStorage<universeCount, nodeSlots, batchLen>);
+    printf("controller %5u universes %4u nodes %4u batch  object %6zu  storage %9zu  total %9zu bytes\n",
+        universeCount, nodeSlots, batchLen, sizeof(ArtNetController), _storage, sizeof(ArtNetController) + _storage);
+}
+
+}
+
+int main() {
+
+    reportNode<1, 0>();
+    reportNode<1>();
+    reportNode<4>();
+    reportNode<16>();
+    reportNode<64>();
+    reportNode<1020>();
+
+    reportController<1, 8, 1>();
+    reportController<4, 16, 4>();
+    reportController<64, 64, 64>();
+    reportController<1024, 256, 256>();
+    reportController<4096, 1024, 256>();
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file benchGateway.cpp
+ * @author your name (you@domain.com)
+ * @brief cost of the Art-Net <-> sACN gateway per packet in both directions and the latency of a round
+ * trip through two gateways over loopback multicast
+ * @version 0.1
+ * @date 2026-01-21
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetLinuxSacn.hpp>
+#include <ArtNetSacn.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint16_t mappingCount = 64;
+constexpr uint32_t iterations = 2000000;
+constexpr uint16_t roundTrips = 2000;
+
+ArtNetSacnGateway::gatewayStorage<mappingCount> toSacnPorts;
+ArtNetSacnGateway::gatewayStorage<mappingCount> toArtNetPorts;
+
+uint8_t lastPacket[ArtNetSacnGateway::sacnPacketLen];
+uint16_t lastPacketLen = 0;
+uint32_t sent = 0;
+
+/**
+ * @brief keeps the last packet so the next direction can be fed with it
+ */
+bool keepPacket(uint8_t *packet, uint16_t packetLen, uint8_t *, uint8_t, uint16_t) {
+    memcpy(lastPacket, packet, packetLen);
+    lastPacketLen = packetLen;
+    sent++;
+    return true;
+}
+
+bool countPacket(uint8_t *, uint16_t, uint8_t *, uint8_t, uint16_t) {
+    sent++;
+    return true;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief ArtDmx in, sACN out through one gateway and back to ArtDmx through a second one, over the
+ * multicast loopback of this host
+ */
+void runLoopback(ArtNetSacnGateway &toSacn, ArtNetSacnGateway &toArtNet) {
+
+    if (!ArtNetLinuxSacn::open(true) || !ArtNetLinuxSacn::joinUniverse(1)) {
+        printf("loopback multicast: skipped, sACN socket could not be opened or joined\n");
+        ArtNetLinuxSacn::close();
+        return;
+    }
+
+    toSacn.setSacnCallback(ArtNetLinuxSacn::sendUnicast);
+    toArtNet.setUnicastCallback(keepPacket);
+
+    uint8_t _artDmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _console[4] = {2, 0, 0, 10};
+    double _total = 0;
+    double _max = 0;
+    uint16_t _received = 0;
+
+    for (uint16_t i = 0; i < roundTrips; i++) {
+
+        memset(_artDmx + 18, static_cast<uint8_t>(i), 512);
+        sent = 0;
+
+        auto _start = std::chrono::steady_clock::now();
+        toSacn.handlePacket(_artDmx, sizeof(_artDmx), _console, sizeof(_console), 0x1936);
+
+        //the first gateway sees its own sACN as well and ignores it by its CID
+        while (sent == 0 && elapsedNs(_start) < 10e6) {
+            ArtNetLinuxSacn::receive(toArtNet, 8);
+        }
+
+        double _ns = elapsedNs(_start);
+
+        if (sent > 0 && lastPacket[18] == static_cast<uint8_t>(i) && lastPacket[529] == static_cast<uint8_t>(i)) {
+            _received++;
+            _total += _ns;
+            _max = _ns > _max ? _ns : _max;
+        }
+    }
+
+    ArtNetLinuxSacn::close();
+
+    if (_received == 0) {
+        printf("loopback multicast: skipped, no sACN came back (multicast route missing?)\n");
+        return;
+    }
+
+    printf("loopback multicast ArtDmx -> sACN -> ArtDmx: %u of %u frames, %.1f us mean, %.1f us max\n", _received,
+        roundTrips, _total / _received / 1e3, _max / 1e3);
+}
+
+}
+
+int main() {
+
+    uint8_t _macA[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t _macB[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x56};
+
+    static ArtNetSacnGateway _toSacn(0x0000, _macA, sizeof(_macA), toSacnPorts);
+    static ArtNetSacnGateway _toArtNet(0x0000, _macB, sizeof(_macB), toArtNetPorts);
+    _toSacn.setTimeCallback(nowMicros);
+    _toArtNet.setTimeCallback(nowMicros);
+
+    for (uint16_t i = 0; i < mappingCount; i++) {
+        _toSacn.mapArtNetToSacn(i, i, i + 1, 100);
+        _toArtNet.mapSacnToArtNet(i, i + 1, i);
+    }
+
+    //Art-Net -> sACN, the last mapping is the worst case of the scan
+    _toSacn.setSacnCallback(keepPacket);
+
+    uint8_t _artDmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _console[4] = {2, 0, 0, 10};
+    uint32_t _checksum = 0;
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        _artDmx[14] = static_cast<uint8_t>(i % mappingCount);
+        _artDmx[18] = static_cast<uint8_t>(i);
+        _checksum += _toSacn.handlePacket(_artDmx, sizeof(_artDmx), _console, sizeof(_console), 0x1936);
+    }
+
+    printf("ArtDmx -> sACN %.2f ns/packet, %u sent (checksum %u)\n", elapsedNs(_start) / iterations,
+        _toSacn.getGatewayCounters().toSacn.load(), _checksum);
+
+    //sACN -> Art-Net, one source per universe
+    _toArtNet.setUnicastCallback(countPacket);
+
+    uint8_t _sacn[ArtNetSacnGateway::sacnPacketLen];
+    memcpy(_sacn, lastPacket, lastPacketLen);
+    _checksum = 0;
+
+    _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint16_t _universe = static_cast<uint16_t>(i % mappingCount + 1);
+        _sacn[111] = static_cast<uint8_t>(i / mappingCount);
+        _sacn[113] = static_cast<uint8_t>(_universe >> 8);
+        _sacn[114] = static_cast<uint8_t>(_universe);
+        _checksum += _toArtNet.handleSacnPacket(_sacn, lastPacketLen, _console, sizeof(_console));
+    }
+
+    const ArtNetSacnGateway::gatewayCounters &_counters = _toArtNet.getGatewayCounters();
+
+    printf("sACN -> ArtDmx %.2f ns/packet, %u sent, %u out of order, %u invalid (checksum %u)\n",
+        elapsedNs(_start) / iterations, _counters.toArtNet.load(), _counters.sacnOutOfOrder.load(),
+        _counters.sacnInvalid.load(), _checksum);
+
+    runLoopback(_toSacn, _toArtNet);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file benchMerge.cpp
+ * @author your name (you@domain.com)
+ * @brief microbenchmark of the HTP/LTP merge of two sources on one universe
+ * @version 0.1
+ * @date 2026-01-06
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetNode.hpp>
+#include <ArtNetSimd.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint32_t iterations = 1000000;
+
+uint64_t fakeMicros = 0;
+
+uint64_t getFakeMicros() {
+    return fakeMicros;
+}
+
+/**
+ * @brief feed alternating frames of two sources into port 0 of the node
+ */
+void runCase(ArtNetNode &node, const char *name) {
+
+    uint8_t _packet[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _sourceA[4] = {2, 0, 0, 1};
+    uint8_t _sourceB[4] = {2, 0, 0, 2};
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        _packet[18 + (i & 511)] = static_cast<uint8_t>(i);
+        fakeMicros += 11000;
+        node.handlePacket(_packet, sizeof(_packet), (i & 1) ? _sourceB : _sourceA, 4, 0x1936);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    printf("%-28s %8.2f ns/packet\n", name, std::chrono::duration<double, std::nano>(_end - _start).count() / iterations);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    alignas(64) static uint8_t _a[512];
+    alignas(64) static uint8_t _b[512];
+    alignas(64) static uint8_t _out[512];
+
+    for (uint16_t i = 0; i < 512; i++) {
+        _a[i] = static_cast<uint8_t>(i * 7);
+        _b[i] = static_cast<uint8_t>(i * 13);
+    }
+
+    auto _start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        _a[i & 511]++;
+        dmxMergeHtp(_out, _a, _b, 512);
+    }
+    auto _end = std::chrono::steady_clock::now();
+    printf("%-28s %8.2f ns/universe (check %u)\n", "dmxMergeHtp 512 slots", std::chrono::duration<double, std::nano>(_end - _start).count() / iterations, _out[100]);
+
+    static ArtNetNode::portStorage<4> _htpPorts;
+    static ArtNetNode _htpNode(0x0000, _mac, sizeof(_mac), _htpPorts);
+    _htpNode.setTimeCallback(getFakeMicros);
+    _htpNode.configureOutputPort(0, 0);
+    runCase(_htpNode, "ArtDmx 2 sources HTP");
+
+    static ArtNetNode::portStorage<4> _ltpPorts;
+    static ArtNetNode _ltpNode(0x0000, _mac, sizeof(_mac), _ltpPorts);
+    _ltpNode.setTimeCallback(getFakeMicros);
+    _ltpNode.configureOutputPort(0, 0);
+    _ltpNode.setMergeMode(0, true);
+    runCase(_ltpNode, "ArtDmx 2 sources LTP");
+
+    return 0;
+}
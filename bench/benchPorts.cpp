@@ -0,0 +1,82 @@
+/**
+ * @file benchPorts.cpp
+ * @author your name (you@domain.com)
+ * @brief cost of ArtDmx receive and ArtPoll handling for nodes with many ports
+ * @version 0.1
+ * @date 2026-01-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint32_t iterations = 200000;
+
+uint32_t repliesSent = 0;
+
+bool countUnicast(uint8_t *, uint16_t, uint8_t *, uint8_t, uint16_t) {
+    repliesSent++;
+    return true;
+}
+
+/**
+ * @brief configure every port of the node with its own universe and measure DMX and poll handling
+ */
+template <uint16_t portCount>
+void runCase() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t _senderIp[4] = {2, 0, 0, 1};
+    uint8_t _dmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _poll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+
+    static ArtNetNode::portStorage<portCount> _ports;
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), _ports);
+    _node.setUnicastCallback(countUnicast);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint16_t _portAddress = static_cast<uint16_t>((i * 7) % portCount);
+        _dmx[14] = _portAddress & 0xff;
+        _dmx[15] = _portAddress >> 8;
+        _node.handlePacket(_dmx, sizeof(_dmx), _senderIp, sizeof(_senderIp), 0x1936);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    double _dmxNs = std::chrono::duration<double, std::nano>(_end - _start).count() / iterations;
+
+    repliesSent = 0;
+    _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations / 100; i++) {
+        _node.handlePacket(_poll, sizeof(_poll), _senderIp, sizeof(_senderIp), 0x1936);
+    }
+
+    _end = std::chrono::steady_clock::now();
+    double _pollNs = std::chrono::duration<double, std::nano>(_end - _start).count() / (iterations / 100);
+
+    printf("%4u ports: ArtDmx %8.2f ns/packet, ArtPoll %9.2f ns/poll (%u replies per poll)\n",
+        portCount, _dmxNs, _pollNs, repliesSent / (iterations / 100));
+}
+
+}
+
+int main() {
+
+    runCase<4>();
+    runCase<64>();
+    runCase<256>();
+    runCase<1020>();
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file benchRdm.cpp
+ * @author your name (you@domain.com)
+ * @brief RDM sweep over simulated nodes, compares the sweep time for different pipeline windows and
+ * measures the assembly of a large paged table of devices
+ * @version 0.1
+ * @date 2026-01-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint8_t nodeCount = 8;
+constexpr uint8_t portsPerNode = 4;
+constexpr uint16_t uidsPerPort = 64;
+constexpr uint16_t uidCount = nodeCount * portsPerNode * uidsPerPort;
+constexpr uint16_t largeTodUids = 4000;
+
+constexpr uint64_t lineTime = 3000;         //microseconds for one RDM transaction on a dmx line
+constexpr uint64_t networkDelay = 500;      //microseconds one way
+constexpr uint16_t maxEvents = 1024;
+
+ArtNetController::controllerStorage<1, 64, 1> controllerTables;
+ArtNetController::rdmStorage<largeTodUids + uidCount, 128> rdmTables;
+
+/**
+ * @brief response of a simulated node, delivered once the simulated time reaches due
+ */
+struct responseEvent {
+    uint64_t due;
+    uint8_t nodeIp[4];
+    uint8_t packet[25 + 256];
+    uint16_t packetLen;
+    bool used;
+};
+
+responseEvent events[maxEvents];
+uint64_t portBusyUntil[nodeCount][portsPerNode];
+uint64_t simNow = 0;
+uint32_t completed = 0;
+uint32_t timedOut = 0;
+
+uint64_t getSimMicros() {
+    return simNow;
+}
+
+/**
+ * @brief simulated node, every port answers one request after the other and turns it into a response
+ */
+bool nodeReceive(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t, uint16_t) {
+
+    uint8_t _node = targetIp[3];
+    uint8_t _port = packet[24] % portsPerNode;
+
+    responseEvent *_event = nullptr;
+    for (responseEvent &_candidate : events) {
+        if (!_candidate.used) {
+            _event = &_candidate;
+            break;
+        }
+    }
+
+    if (_event == nullptr || _node >= nodeCount) {
+        return false;
+    }
+
+    uint64_t &_busyUntil = portBusyUntil[_node][_port];
+    uint64_t _start = simNow + networkDelay > _busyUntil ? simNow + networkDelay : _busyUntil;
+    _busyUntil = _start + lineTime;
+
+    //the response swaps the UIDs and answers with the response command class
+    memcpy(_event->packet, packet, packetLen);
+    uint8_t *_rdm = _event->packet + 25;
+    memcpy(_rdm + 2, packet + 25 + 8, 6);
+    memcpy(_rdm + 8, packet + 25 + 2, 6);
+    _rdm[19] = packet[25 + 19] + 1;
+
+    memcpy(_event->nodeIp, targetIp, 4);
+    _event->packetLen = packetLen;
+    _event->due = _busyUntil + networkDelay;
+    _event->used = true;
+
+    return true;
+}
+
+bool broadcastNothing(uint8_t *, uint16_t, uint16_t) {
+    return true;
+}
+
+void onResult(uint16_t, ArtNetController::rdmResults result, const uint8_t *, uint16_t) {
+    if (result == ArtNetController::rrResponse) {
+        completed++;
+    }
+    else {
+        timedOut++;
+    }
+}
+
+/**
+ * @brief advance the simulated time to the next response and deliver all responses due
+ */
+void deliverNext(ArtNetController &controller) {
+
+    uint64_t _next = UINT64_MAX;
+    for (const responseEvent &_event : events) {
+        if (_event.used && _event.due < _next) {
+            _next = _event.due;
+        }
+    }
+
+    simNow = _next != UINT64_MAX ? _next : simNow + 1000;
+
+    for (responseEvent &_event : events) {
+        if (_event.used && _event.due <= simNow) {
+            _event.used = false;
+            controller.handlePacket(_event.packet, _event.packetLen, _event.nodeIp, 4, 0x1936);
+        }
+    }
+
+    controller.service();
+}
+
+/**
+ * @brief build the ArtTodData blocks of one node and Port-Address and pass them to the controller
+ */
+void reportTod(ArtNetController &controller, uint8_t node, uint16_t portAddress, uint16_t count, uint32_t deviceBase) {
+
+    uint8_t _ip[4] = {2, 0, 0, node};
+
+    for (uint16_t _block = 0; _block * 200 < count; _block++) {
+
+        uint8_t _packet[28 + 200 * 6] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x81, 0x00, 14, 1, 1};
+        uint8_t _uids = count - _block * 200 > 200 ? 200 : static_cast<uint8_t>(count - _block * 200);
+
+        _packet[21] = portAddress >> 8;
+        _packet[23] = portAddress & 0xff;
+        _packet[24] = count >> 8;
+        _packet[25] = count & 0xff;
+        _packet[26] = static_cast<uint8_t>(_block);
+        _packet[27] = _uids;
+
+        for (uint8_t i = 0; i < _uids; i++) {
+            uint32_t _device = deviceBase + _block * 200 + i;
+            uint8_t _uid[6] = {0x7a, 0x70, static_cast<uint8_t>(_device >> 24), static_cast<uint8_t>(_device >> 16),
+                static_cast<uint8_t>(_device >> 8), static_cast<uint8_t>(_device)};
+            memcpy(_packet + 28 + i * 6, _uid, 6);
+        }
+
+        controller.handlePacket(_packet, 28 + _uids * 6, _ip, sizeof(_ip), 0x1936);
+    }
+}
+
+/**
+ * @brief queue GET DEVICE_INFO for every responder and run the simulation until all answered
+ */
+void runSweep(ArtNetController &controller, uint8_t window) {
+
+    controller.setRdmPipeline(window, 200, 2);
+    memset(portBusyUntil, 0, sizeof(portBusyUntil));
+    completed = 0;
+    timedOut = 0;
+    simNow = 0;
+
+    static uint64_t _uids[nodeCount * portsPerNode][uidsPerPort];
+    uint8_t _request[26] = {0x01, 24};
+    _request[8] = 0x7a;
+    _request[9] = 0x70;
+    _request[19] = 0x20;
+    _request[21] = 0x60;
+
+    for (uint16_t _portAddress = 0; _portAddress < nodeCount * portsPerNode; _portAddress++) {
+        controller.getTod(_portAddress, _uids[_portAddress], uidsPerPort);
+    }
+
+    auto _start = std::chrono::steady_clock::now();
+
+    //the requests are interleaved over the Port-Addresses so no node waits behind the queue of another
+    for (uint16_t i = 0; i < uidsPerPort; i++) {
+
+        for (uint16_t _portAddress = 0; _portAddress < nodeCount * portsPerNode; _portAddress++) {
+
+            for (uint8_t k = 0; k < 6; k++) {
+                _request[2 + k] = static_cast<uint8_t>(_uids[_portAddress][i] >> (40 - 8 * k));
+            }
+
+            uint16_t _idx;
+            while (!controller.queueRdm(_portAddress, _request, sizeof(_request), _idx)) {
+                deliverNext(controller);
+            }
+        }
+    }
+
+    while (controller.getRdmPending() > 0) {
+        deliverNext(controller);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    double _ns = std::chrono::duration<double, std::nano>(_end - _start).count() / uidCount;
+
+    printf("window %u: sweep of %u responders %8.1f ms simulated, %u responses, %u timeouts, %7.1f ns CPU/request\n",
+        window, uidCount, simNow / 1000.0, completed, timedOut, _ns);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetController _controller(0x0000, _mac, sizeof(_mac), controllerTables, rdmTables);
+    _controller.setTimeCallback(getSimMicros);
+    _controller.setUnicastCallback(nodeReceive);
+    _controller.setBroadcastCallback(broadcastNothing);
+    _controller.setRdmCallback(onResult);
+
+    auto _start = std::chrono::steady_clock::now();
+    reportTod(_controller, 200, 0x7fff, largeTodUids, 0);
+    auto _end = std::chrono::steady_clock::now();
+
+    printf("table of devices: %u responders in 20 blocks, %.1f ns/UID\n", _controller.getTodSize(),
+        std::chrono::duration<double, std::nano>(_end - _start).count() / largeTodUids);
+
+    //a second full table with one responder less removes it
+    reportTod(_controller, 200, 0x7fff, largeTodUids - 1, 0);
+    printf("after shrinking the table: %u responders\n", _controller.getTodSize());
+
+    for (uint8_t n = 0; n < nodeCount; n++) {
+        for (uint8_t p = 0; p < portsPerNode; p++) {
+            reportTod(_controller, n, n * portsPerNode + p, uidsPerPort, 0x10000 + (n * portsPerNode + p) * uidsPerPort);
+        }
+    }
+
+    printf("%u nodes x %u ports x %u responders, %lu us line time, %lu us network delay\n", nodeCount, portsPerNode,
+        uidsPerPort, static_cast<unsigned long>(lineTime), static_cast<unsigned long>(networkDelay));
+
+    runSweep(_controller, 1);
+    runSweep(_controller, 4);
+    runSweep(_controller, 16);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file benchReplay.cpp
+ * @author your name (you@domain.com)
+ * @brief end to end throughput of a node fed from a capture file without network, replays a capture
+ * given on the command line or a generated show (ArtDmx bursts with ArtSync, timecode, polls)
+ * @version 0.1
+ * @date 2026-01-20
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetCapture.hpp>
+#include <ArtNetFakeTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint16_t portCount = 64;
+constexpr uint64_t showTime = 2000000000;       //nanoseconds
+constexpr uint64_t framePeriod = 25000000;      //40 Hz
+constexpr uint64_t burstSpacing = 20000;        //between the universes of one frame
+constexpr uint64_t timeCodePeriod = 40000000;
+constexpr uint64_t pollPeriod = 500000000;
+constexpr uint64_t captureSize = 64ULL * 1024 * 1024;
+
+ArtNetNode::portStorage<portCount> nodePorts;
+
+/**
+ * @brief write a generated show into a capture file
+ */
+bool generateShow(const char *path) {
+
+    if (!ArtNetCapture::open(path, captureSize)) {
+        return false;
+    }
+
+    uint8_t _console[4] = {2, 0, 0, 10};
+    uint8_t _artDmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _artSync[14] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x52, 0x00, 14};
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    uint8_t _artTimeCode[19] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x97, 0x00, 14, 0, 0, 0, 0, 0, 1, 1};
+    uint8_t _sequence = 1;
+    uint32_t _timeCodeFrame = 0;
+
+    for (uint64_t _frame = 0; _frame < showTime; _frame += framePeriod) {
+
+        for (uint16_t i = 0; i < portCount; i++) {
+            _artDmx[12] = _sequence;
+            _artDmx[14] = static_cast<uint8_t>(i);
+            memset(_artDmx + 18, static_cast<uint8_t>(_frame / framePeriod + i), 512);
+            ArtNetCapture::append(_frame + i * burstSpacing, _artDmx, sizeof(_artDmx), _console, sizeof(_console), 0x1936);
+        }
+
+        ArtNetCapture::append(_frame + portCount * burstSpacing, _artSync, sizeof(_artSync), _console, sizeof(_console), 0x1936);
+        _sequence = _sequence == 255 ? 1 : _sequence + 1;
+
+        //timecode and polls fall between the bursts
+        for (; _timeCodeFrame * timeCodePeriod < _frame + framePeriod; _timeCodeFrame++) {
+            _artTimeCode[14] = static_cast<uint8_t>(_timeCodeFrame % 25);
+            _artTimeCode[15] = static_cast<uint8_t>(_timeCodeFrame / 25 % 60);
+            ArtNetCapture::append(_timeCodeFrame * timeCodePeriod + 1500000, _artTimeCode, sizeof(_artTimeCode), _console,
+                sizeof(_console), 0x1936);
+        }
+
+        if (_frame % pollPeriod == 0) {
+            ArtNetCapture::append(_frame + framePeriod / 2, _artPoll, sizeof(_artPoll), _console, sizeof(_console), 0x1936);
+        }
+    }
+
+    ArtNetCapture::close();
+
+    return true;
+}
+
+void printRun(const char *name, const ArtNetReplay::replayStats &stats) {
+
+    double _ns = static_cast<double>(stats.elapsed) / stats.packets;
+
+    printf("%-28s %8u packets %8.1f ms %8.2f ns/packet %6.2f Mpackets/s, lateness %7.1f us mean %8.1f us max, %u ok\n",
+        name, stats.packets, stats.elapsed / 1e6, _ns, 1000.0 / _ns, stats.totalLateness / 1e3 / stats.packets,
+        stats.maxLateness / 1e3, stats.byStatus[ArtNet::psOk]);
+}
+
+}
+
+int main(int argc, char **argv) {
+
+    const char *_path = argc > 1 ? argv[1] : "benchReplay.cap";
+
+    if (argc <= 1 && !generateShow(_path)) {
+        printf("capture file %s could not be created\n", _path);
+        return 1;
+    }
+
+    ArtNetReplay _replay;
+
+    if (!_replay.open(_path)) {
+        printf("%s is not a capture file\n", _path);
+        return 1;
+    }
+
+    printf("%s: %u packets over %.1f ms\n", _path, _replay.getRecordCount(), _replay.getDuration() / 1e6);
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), nodePorts);
+    _node.setUnicastCallback(ArtNetFakeTransport::sendUnicast);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    ArtNetReplay::replayStats _stats;
+
+    _replay.run(_node, 0, _stats);
+    printRun("as fast as possible", _stats);
+
+    _replay.run(_node, 1000, _stats);
+    printRun("10x", _stats);
+
+    _replay.run(_node, 100, _stats);
+    printRun("original speed", _stats);
+
+    //the capture hook on the receive path, replayed into a second capture
+    if (ArtNetCapture::open("benchReplayHook.cap", captureSize)) {
+
+        _node.setCaptureCallback(ArtNetCapture::record);
+        _replay.run(_node, 0, _stats);
+        _node.setCaptureCallback(nullptr);
+        ArtNetCapture::close();
+
+        printRun("as fast as possible + hook", _stats);
+        printf("hook recorded %u packets, %u dropped\n", ArtNetCapture::getCounters().recorded, ArtNetCapture::getCounters().dropped);
+    }
+
+    return 0;
+}
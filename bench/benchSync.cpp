@@ -0,0 +1,112 @@
+/**
+ * @file benchSync.cpp
+ * @author your name (you@domain.com)
+ * @brief measures how far apart the outputs of all ports land with and without ArtSync
+ * @version 0.1
+ * @date 2026-01-08
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t frameCount = 20000;
+constexpr uint8_t portCount = 4;
+
+uint64_t outputTime[portCount];
+std::atomic<uint32_t> outputMask{0};
+
+uint64_t getMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool recordOutput(uint8_t *, uint16_t, uint16_t portIdx) {
+    outputTime[portIdx] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    outputMask.fetch_or(1u << portIdx, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief send one frame to all ports, optionally followed by ArtSync, and collect the spread
+ * between the first and the last output of each frame
+ */
+void runCase(const char *name, bool useSync) {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t _sourceIp[4] = {2, 0, 0, 1};
+    uint8_t _dmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _sync[14] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x52, 0x00, 14, 0, 0};
+
+    static ArtNetNode::portStorage<portCount> _ports;
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), _ports);
+    _node.setTimeCallback(getMicros);
+    _node.setOutputDmxCallback(recordOutput);
+    _node.enableSync(useSync);
+
+    for (uint8_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    std::atomic<bool> _stop{false};
+    std::thread _outputThread([&]() {
+        while (!_stop.load(std::memory_order_relaxed)) {
+            if (_node.processOutputs() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<double> _spread;
+    _spread.reserve(frameCount);
+
+    for (uint32_t f = 0; f < frameCount; f++) {
+
+        outputMask.store(0, std::memory_order_relaxed);
+
+        for (uint8_t i = 0; i < portCount; i++) {
+            _dmx[14] = i;
+            _dmx[18] = static_cast<uint8_t>(f);
+            _node.handlePacket(_dmx, sizeof(_dmx), _sourceIp, sizeof(_sourceIp), 0x1936);
+            //controllers space the universes of one frame out on the wire
+            std::this_thread::yield();
+        }
+
+        if (useSync) {
+            _node.handlePacket(_sync, sizeof(_sync), _sourceIp, sizeof(_sourceIp), 0x1936);
+        }
+
+        while (outputMask.load(std::memory_order_acquire) != (1u << portCount) - 1) {
+            std::this_thread::yield();
+        }
+
+        uint64_t _first = *std::min_element(outputTime, outputTime + portCount);
+        uint64_t _last = *std::max_element(outputTime, outputTime + portCount);
+        _spread.push_back(static_cast<double>(_last - _first) / 1000.0);
+    }
+
+    _stop = true;
+    _outputThread.join();
+
+    std::sort(_spread.begin(), _spread.end());
+    printf("%-16s spread between ports: median %8.2f us, p99 %8.2f us, max %8.2f us\n", name,
+        _spread[_spread.size() / 2], _spread[_spread.size() * 99 / 100], _spread.back());
+}
+
+}
+
+int main() {
+
+    runCase("immediate", false);
+    runCase("ArtSync", true);
+
+    return 0;
+}
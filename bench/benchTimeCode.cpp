@@ -0,0 +1,241 @@
+/**
+ * @file benchTimeCode.cpp
+ * @author your name (you@domain.com)
+ * @brief timecode chain over a simulated network: generator of a controller with a skewed clock, network
+ * jitter and a drop-out, clock error of the receiving node against the last packet plus elapsed time
+ * @version 0.1
+ * @date 2026-01-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetNode.hpp>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr int64_t sourceSkew = 80;          //ppm, clock of the controller against the clock of the node
+constexpr uint64_t networkDelay = 1000;     //microseconds
+constexpr uint32_t networkJitter = 800;     //microseconds, uniform
+constexpr uint64_t runTime = 60000000;      //microseconds
+constexpr uint64_t dropOutStart = 30000000;
+constexpr uint64_t dropOutTime = 1000000;
+constexpr uint64_t sampleInterval = 997;
+constexpr uint16_t maxInFlight = 64;
+constexpr uint32_t iterations = 2000000;
+
+ArtNetNode::portStorage<4> nodePorts;
+ArtNetController::controllerStorage<1, 4, 1> controllerTables;
+
+struct inFlight {
+    uint8_t packet[19];
+    uint64_t due;
+    bool used;
+};
+
+inFlight network[maxInFlight];
+uint64_t simNow = 0;
+uint32_t randomState = 0x2545f491;
+
+uint64_t nodeMicros() {
+    return simNow;
+}
+
+uint64_t sourceMicros() {
+    return simNow + simNow * sourceSkew / 1000000;
+}
+
+uint32_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+/**
+ * @brief network between controller and node, every packet is delayed by the delay plus a random jitter
+ */
+bool sendToNetwork(uint8_t *packet, uint16_t, uint8_t *, uint8_t, uint16_t) {
+
+    for (inFlight &_slot : network) {
+        if (!_slot.used) {
+            memcpy(_slot.packet, packet, sizeof(_slot.packet));
+            _slot.due = simNow + networkDelay + nextRandom() % (networkJitter + 1);
+            _slot.used = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief error of a clock in microseconds, accumulated over all samples
+ */
+struct errorStats {
+    double sum;
+    double sumSquares;
+    uint32_t count;
+
+    void add(double error) {
+        sum += error;
+        sumSquares += error * error;
+        count++;
+    }
+
+    double mean() const {
+        return sum / count;
+    }
+
+    double deviation() const {
+        return sqrt(sumSquares / count - mean() * mean());
+    }
+};
+
+/**
+ * @brief run the chain for one frame type and print the accuracy of the clock and the generator
+ */
+void runChain(ArtNetController &controller, uint8_t type, const char *name) {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x56};
+    ArtNetNode node(0x0000, _mac, sizeof(_mac), nodePorts);
+    node.setTimeCallback(nodeMicros);
+
+    uint8_t _nodeIp[4] = {2, 0, 0, 1};
+    ArtNet::timeCode _start = {10, 0, 0, 0, type, 0};
+    int64_t _startValue = ArtNet::timeCodeFramesToMicros(ArtNet::timeCodeToFrames(_start), type);
+
+    memset(network, 0, sizeof(network));
+    simNow = 0;
+    controller.startTimeCode(_start);
+
+    errorStats _clockError = {};
+    errorStats _naiveError = {};
+    double _dropOutError = 0;
+    int64_t _lastValue = -1;
+    uint64_t _lastReceived = 0;
+    uint64_t _nextSample = sampleInterval;
+    uint64_t _nextFrame = 0;
+
+    while (simNow < runTime) {
+
+        //the generator runs on the skewed clock of the controller, convert its due time to simulated time
+        if (simNow >= _nextFrame) {
+            uint64_t _due = controller.serviceTimeCode();
+            _nextFrame = (_due * 1000000 + 1000000 + sourceSkew - 1) / (1000000 + sourceSkew);
+        }
+
+        bool _dropOut = simNow >= dropOutStart && simNow < dropOutStart + dropOutTime;
+
+        for (inFlight &_slot : network) {
+            if (_slot.used && _slot.due <= simNow) {
+                _slot.used = false;
+                if (!_dropOut) {
+                    //timestamped on arrival as the transport does
+                    node.handlePacket(_slot.packet, sizeof(_slot.packet), _nodeIp, sizeof(_nodeIp), 0x1936, simNow);
+                    ArtNet::timeCode _tc = {_slot.packet[17], _slot.packet[16], _slot.packet[15], _slot.packet[14], type, 0};
+                    _lastValue = ArtNet::timeCodeFramesToMicros(ArtNet::timeCodeToFrames(_tc), type);
+                    _lastReceived = simNow;
+                }
+            }
+        }
+
+        if (simNow >= _nextSample) {
+
+            _nextSample += sampleInterval;
+
+            ArtNet::timeCode _tc;
+            uint32_t _offset;
+            double _true = static_cast<double>(_startValue + static_cast<int64_t>(sourceMicros()));
+
+            if (node.getTimeCode(_tc, _offset) && _lastValue >= 0) {
+
+                double _clock = static_cast<double>(ArtNet::timeCodeFramesToMicros(ArtNet::timeCodeToFrames(_tc), type) + _offset);
+
+                if (simNow >= dropOutStart && simNow < dropOutStart + dropOutTime + 100000) {
+                    //the error at the end of the drop-out, before the clock is disciplined again
+                    if (simNow < dropOutStart + dropOutTime) {
+                        _dropOutError = _clock - _true;
+                    }
+                }
+                else if (simNow > 2000000) {
+                    _clockError.add(_clock - _true);
+                    _naiveError.add(static_cast<double>(_lastValue + static_cast<int64_t>(simNow - _lastReceived)) - _true);
+                }
+            }
+        }
+
+        //advance to the next event
+        uint64_t _next = _nextSample < _nextFrame ? _nextSample : _nextFrame;
+        for (const inFlight &_slot : network) {
+            if (_slot.used && _slot.due < _next) {
+                _next = _slot.due;
+            }
+        }
+        simNow = _next > simNow ? _next : simNow + 1;
+    }
+
+    controller.stopTimeCode();
+
+    ArtNet::timeCodeStats _stats;
+    node.getTimeCodeStats(_stats);
+    const ArtNetController::timeCodeGeneratorStats &_generator = controller.getTimeCodeGeneratorStats();
+
+    printf("%-14s clock error %7.1f us mean, %6.1f us sd (last packet + elapsed %6.1f us sd), after 1 s drop-out %7.1f us\n",
+        name, _clockError.mean(), _clockError.deviation(), _naiveError.deviation(), _dropOutError - _clockError.mean());
+    printf("%-14s skew %d ppm, jitter %u us, max %u us, %u relocks, %u drop-outs; generator %u frames, %u skipped, max lateness %u us\n",
+        "", _stats.skew, _stats.jitter, _stats.maxJitter, _stats.relocks, _stats.dropOuts, _generator.sent, _generator.skipped,
+        _generator.maxLateness);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetController _controller(0x0000, _mac, sizeof(_mac), controllerTables);
+    _controller.setTimeCallback(sourceMicros);
+    _controller.setUnicastCallback(sendToNetwork);
+
+    //cost of the receive path, one packet per frame
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), nodePorts);
+    _node.setTimeCallback(nodeMicros);
+
+    uint8_t _packet[19] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x97, 0x00, 14, 0, 0, 0, 0, 0, 10, ArtNet::ttEbu};
+    uint8_t _senderIp[4] = {2, 0, 0, 2};
+    uint32_t _checksum = 0;
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        ArtNet::timeCode _tc;
+        ArtNet::framesToTimeCode(i, ArtNet::ttEbu, _tc);
+        _packet[14] = _tc.frames;
+        _packet[15] = _tc.seconds;
+        _packet[16] = _tc.minutes;
+        _packet[17] = _tc.hours;
+        simNow = i * 40000ULL;
+        _checksum += _node.handlePacket(_packet, sizeof(_packet), _senderIp, sizeof(_senderIp), 0x1936);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+
+    printf("ArtTimeCode receive + discipline %.2f ns/packet (checksum %u)\n",
+        std::chrono::duration<double, std::nano>(_end - _start).count() / iterations, _checksum);
+
+    printf("source skew %ld ppm, network delay %lu us + %u us jitter\n", static_cast<long>(sourceSkew),
+        static_cast<unsigned long>(networkDelay), networkJitter);
+
+    runChain(_controller, ArtNet::ttFilm, "film 24");
+    runChain(_controller, ArtNet::ttEbu, "ebu 25");
+    runChain(_controller, ArtNet::ttDropFrame, "drop frame 30");
+    runChain(_controller, ArtNet::ttSmpte, "smpte 30");
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file benchTransmit.cpp
+ * @author your name (you@domain.com)
+ * @brief loopback benchmark of the ArtDmx transmit engine of ArtNetController
+ * @version 0.1
+ * @date 2026-01-10
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetLinuxUdp.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint16_t universeCount = 4096;
+constexpr uint32_t tickCount = 200;
+
+ArtNetController::controllerStorage<universeCount, 64> controllerTables;
+
+uint64_t fakeMicros = 0;
+
+uint64_t getFakeMicros() {
+    return fakeMicros;
+}
+
+double getCpuMicros() {
+    rusage _usage;
+    getrusage(RUSAGE_SELF, &_usage);
+    return (_usage.ru_utime.tv_sec + _usage.ru_stime.tv_sec) * 1e6 + _usage.ru_utime.tv_usec + _usage.ru_stime.tv_usec;
+}
+
+/**
+ * @brief transmit all universes for a number of ticks and print the throughput
+ */
+void runCase(ArtNetController &controller, const char *name) {
+
+    uint8_t _dmx[512];
+    uint64_t _sent = 0;
+
+    double _cpuStart = getCpuMicros();
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t t = 0; t < tickCount; t++) {
+
+        for (uint16_t i = 0; i < universeCount; i += 64) {
+            _dmx[0] = static_cast<uint8_t>(t);
+            controller.setUniverseData(i, _dmx, sizeof(_dmx));
+        }
+
+        //44 Hz refresh
+        fakeMicros += 22727;
+        _sent += controller.transmitDmx();
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    double _cpu = getCpuMicros() - _cpuStart;
+    double _seconds = std::chrono::duration<double>(_end - _start).count();
+
+    printf("%-20s %10.0f packets/s, %8.1f us CPU per 1000 universes, %llu of %llu sent\n", name,
+        _sent / _seconds, _cpu / tickCount / (universeCount / 1000.0),
+        static_cast<unsigned long long>(_sent), static_cast<unsigned long long>(tickCount) * universeCount);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t _loopback[4] = {127, 0, 0, 1};
+
+    //sink for the packets, never read so the kernel drops what does not fit
+    int _sink = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in _sinkAddress = {};
+    _sinkAddress.sin_family = AF_INET;
+    _sinkAddress.sin_port = htons(0x1936);
+    _sinkAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(_sink, reinterpret_cast<sockaddr*>(&_sinkAddress), sizeof(_sinkAddress));
+
+    if (!ArtNetLinuxUdp::open(0)) {
+        printf("failed to open socket\n");
+        return 1;
+    }
+
+    static ArtNetController _controller(0x0000, _mac, sizeof(_mac), controllerTables);
+
+    for (uint16_t i = 0; i < universeCount; i++) {
+        uint16_t _universeIdx;
+        _controller.addUniverse(i, _loopback, sizeof(_loopback), _universeIdx);
+    }
+
+    _controller.setUnicastCallback(ArtNetLinuxUdp::sendUnicast);
+    runCase(_controller, "sendto per packet");
+
+    _controller.setBatchCallback(ArtNetLinuxUdp::sendBatch);
+    runCase(_controller, "sendmmsg batches");
+
+    //only every 64th universe changes per tick
+    _controller.setTimeCallback(getFakeMicros);
+    _controller.enableDeltaMode(true);
+    runCase(_controller, "sendmmsg delta mode");
+
+    const ArtNetController::txCounters &_counters = _controller.getTxCounters();
+    printf("delta mode: %u changed, %u keep-alive, %u saved unchanged, %u saved by rate limit\n",
+        _counters.sentChanged, _counters.sentKeepAlive, _counters.savedUnchanged, _counters.savedRateLimit);
+
+    ArtNetLinuxUdp::close();
+    close(_sink);
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file benchTransport.cpp
+ * @author your name (you@domain.com)
+ * @brief loopback throughput of the Linux receive path for different numbers of worker threads
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetLinuxTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+constexpr uint16_t artNetPort = 0x1936;
+constexpr uint32_t packetCount = 400000;
+constexpr uint16_t portCount = 64;
+constexpr uint8_t sendBatchLen = 64;
+constexpr uint16_t ringSize = 4096;
+
+ArtNetNode::portStorage<portCount> ports;
+ArtNetLinuxTransport::rxSlot ring[ringSize];
+
+/**
+ * @brief blast ArtDmx packets over all universes to the local ArtNet port
+ */
+void sendPackets() {
+
+    int _fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    int _bufferSize = 4 * 1024 * 1024;
+    setsockopt(_fd, SOL_SOCKET, SO_SNDBUF, &_bufferSize, sizeof(_bufferSize));
+
+    sockaddr_in _target = {};
+    _target.sin_family = AF_INET;
+    _target.sin_port = htons(artNetPort);
+    _target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    static uint8_t _packets[sendBatchLen][530];
+    mmsghdr _messages[sendBatchLen];
+    iovec _vectors[sendBatchLen];
+
+    for (uint8_t i = 0; i < sendBatchLen; i++) {
+        const uint8_t _header[18] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+        memcpy(_packets[i], _header, sizeof(_header));
+        _packets[i][14] = static_cast<uint8_t>(i % portCount);
+
+        _vectors[i].iov_base = _packets[i];
+        _vectors[i].iov_len = sizeof(_packets[i]);
+
+        memset(&_messages[i].msg_hdr, 0, sizeof(_messages[i].msg_hdr));
+        _messages[i].msg_hdr.msg_name = &_target;
+        _messages[i].msg_hdr.msg_namelen = sizeof(_target);
+        _messages[i].msg_hdr.msg_iov = &_vectors[i];
+        _messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    for (uint32_t sent = 0; sent < packetCount; sent += sendBatchLen) {
+        for (uint8_t i = 0; i < sendBatchLen; i++) {
+            _packets[i][12] = static_cast<uint8_t>(sent / sendBatchLen);
+            _packets[i][18] = static_cast<uint8_t>(sent);
+        }
+        sendmmsg(_fd, _messages, sendBatchLen, 0);
+    }
+
+    close(_fd);
+}
+
+/**
+ * @brief wait until the handled packets stop increasing
+ *
+ * @return number of handled packets
+ */
+template<typename countFunction>
+uint32_t waitIdle(countFunction count, std::chrono::steady_clock::time_point &lastProgress) {
+
+    uint32_t _handled = count();
+
+    while (std::chrono::steady_clock::now() - lastProgress < std::chrono::milliseconds(200)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        uint32_t _now = count();
+        if (_now != _handled) {
+            _handled = _now;
+            lastProgress = std::chrono::steady_clock::now();
+        }
+    }
+
+    return _handled;
+}
+
+void printResult(const char *name, uint32_t handled, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+
+    double _seconds = std::chrono::duration<double>(end - start).count();
+    printf("%-22s %8.3f Mpps handled, %6.2f %% lost\n", name, handled / _seconds / 1e6,
+        100.0 * (packetCount - handled) / packetCount);
+}
+
+/**
+ * @brief baseline: one thread, one recvfrom per packet
+ */
+void runPlainLoop(ArtNetNode &node) {
+
+    int _fd = socket(AF_INET, SOCK_DGRAM, 0);
+    int _enable = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &_enable, sizeof(_enable));
+    int _bufferSize = 4 * 1024 * 1024;
+    setsockopt(_fd, SOL_SOCKET, SO_RCVBUF, &_bufferSize, sizeof(_bufferSize));
+    timeval _timeOut = {0, 50000};
+    setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &_timeOut, sizeof(_timeOut));
+
+    sockaddr_in _address = {};
+    _address.sin_family = AF_INET;
+    _address.sin_port = htons(artNetPort);
+    _address.sin_addr.s_addr = htonl(INADDR_ANY);
+    bind(_fd, reinterpret_cast<sockaddr*>(&_address), sizeof(_address));
+
+    std::atomic<uint32_t> _handled{0};
+    std::atomic<bool> _stop{false};
+
+    std::thread _receiver([&]() {
+        uint8_t _buffer[1536];
+        while (!_stop.load(std::memory_order_relaxed)) {
+            sockaddr_in _sender = {};
+            socklen_t _senderLen = sizeof(_sender);
+            ssize_t _len = recvfrom(_fd, _buffer, sizeof(_buffer), 0, reinterpret_cast<sockaddr*>(&_sender), &_senderLen);
+            if (_len > 0) {
+                node.handlePacket(_buffer, static_cast<uint16_t>(_len), reinterpret_cast<uint8_t*>(&_sender.sin_addr.s_addr), 4, artNetPort);
+                _handled.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    auto _start = std::chrono::steady_clock::now();
+    sendPackets();
+    auto _end = std::chrono::steady_clock::now();
+    uint32_t _total = waitIdle([&]() { return _handled.load(); }, _end);
+
+    _stop = true;
+    _receiver.join();
+    close(_fd);
+
+    printResult("recvfrom, 1 thread", _total, _start, _end);
+}
+
+void runTransport(ArtNetNode &node, uint8_t workerCount) {
+
+    ArtNetLinuxTransport _transport(node, ring, ringSize, workerCount);
+
+    if (!_transport.start(artNetPort)) {
+        printf("could not start the transport\n");
+        return;
+    }
+
+    const ArtNetLinuxTransport::rxCounters &_counters = _transport.getRxCounters();
+    auto _count = [&]() {
+        uint64_t _sum = 0;
+        for (uint8_t i = 0; i < workerCount; i++) {
+            _sum += _counters.handled[i].load(std::memory_order_relaxed);
+        }
+        return static_cast<uint32_t>(_sum);
+    };
+
+    auto _start = std::chrono::steady_clock::now();
+    sendPackets();
+    auto _end = std::chrono::steady_clock::now();
+    uint32_t _total = waitIdle(_count, _end);
+
+    _transport.stop();
+
+    char _name[32];
+    snprintf(_name, sizeof(_name), "recvmmsg, %u worker%s", workerCount, workerCount > 1 ? "s" : "");
+    printResult(_name, _total, _start, _end);
+    printf("%-22s %8.1f packets/batch, ring full %u\n", "", static_cast<double>(_counters.received.load()) / _counters.batches.load(),
+        _counters.ringFull.load());
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), ports);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    printf("%u ArtDmx packets over %u universes, %u cores\n", packetCount, portCount, std::thread::hardware_concurrency());
+
+    runPlainLoop(_node);
+
+    for (uint8_t _workers : {1, 2, 4, 8}) {
+        runTransport(_node, _workers);
+    }
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+/**
+ * @file benchUring.cpp
+ * @author your name (you@domain.com)
+ * @brief loopback comparison of the io_uring backend against plain socket loops, receive and transmit
+ * @version 0.1
+ * @date 2026-01-13
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetLinuxUdp.hpp>
+#include <ArtNetLinuxUring.hpp>
+#include <ArtNetNode.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+constexpr uint16_t artNetPort = 0x1936;
+constexpr uint32_t packetCount = 400000;
+constexpr uint16_t portCount = 64;
+constexpr uint8_t sendBatchLen = 64;
+constexpr uint16_t universeCount = 1024;
+constexpr uint16_t txRounds = 200;
+
+ArtNetNode::portStorage<portCount> ports;
+ArtNetController::controllerStorage<universeCount, 16> controllerTables;
+
+uint64_t threadCpuNanos() {
+    timespec _now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &_now);
+    return static_cast<uint64_t>(_now.tv_sec) * 1000000000ULL + _now.tv_nsec;
+}
+
+/**
+ * @brief blast ArtDmx packets over all universes to the local ArtNet port
+ */
+void sendPackets() {
+
+    int _fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    sockaddr_in _target = {};
+    _target.sin_family = AF_INET;
+    _target.sin_port = htons(artNetPort);
+    _target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    static uint8_t _packets[sendBatchLen][530];
+    mmsghdr _messages[sendBatchLen];
+    iovec _vectors[sendBatchLen];
+
+    for (uint8_t i = 0; i < sendBatchLen; i++) {
+        const uint8_t _header[18] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+        memcpy(_packets[i], _header, sizeof(_header));
+        _packets[i][14] = static_cast<uint8_t>(i % portCount);
+
+        _vectors[i].iov_base = _packets[i];
+        _vectors[i].iov_len = sizeof(_packets[i]);
+
+        memset(&_messages[i].msg_hdr, 0, sizeof(_messages[i].msg_hdr));
+        _messages[i].msg_hdr.msg_name = &_target;
+        _messages[i].msg_hdr.msg_namelen = sizeof(_target);
+        _messages[i].msg_hdr.msg_iov = &_vectors[i];
+        _messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    for (uint32_t sent = 0; sent < packetCount; sent += sendBatchLen) {
+        for (uint8_t i = 0; i < sendBatchLen; i++) {
+            _packets[i][18] = static_cast<uint8_t>(sent);
+        }
+        sendmmsg(_fd, _messages, sendBatchLen, 0);
+        //keep the loopback queue below the receive buffer so both loops see the same load
+        if ((sent / sendBatchLen) % 16 == 15) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    close(_fd);
+}
+
+void printReceive(const char *name, uint32_t handled, double seconds, uint64_t cpuNanos) {
+    printf("%-26s %8.3f Mpps, %7.1f ns cpu/packet, %5.2f %% lost\n", name, handled / seconds / 1e6,
+        static_cast<double>(cpuNanos) / (handled ? handled : 1), 100.0 * (packetCount - handled) / packetCount);
+}
+
+/**
+ * @brief run a receive loop on its own thread while the packets are sent, stops once no packet
+ * arrived for 200 ms
+ */
+template<typename loopFunction>
+void runReceive(const char *name, loopFunction receiveSome) {
+
+    std::atomic<uint32_t> _handled{0};
+    std::atomic<bool> _stop{false};
+    std::atomic<uint64_t> _cpu{0};
+
+    std::thread _receiver([&]() {
+        uint64_t _start = threadCpuNanos();
+        while (!_stop.load(std::memory_order_relaxed)) {
+            _handled.fetch_add(receiveSome(), std::memory_order_relaxed);
+        }
+        _cpu = threadCpuNanos() - _start;
+    });
+
+    auto _start = std::chrono::steady_clock::now();
+    sendPackets();
+
+    auto _lastProgress = std::chrono::steady_clock::now();
+    uint32_t _seen = _handled.load();
+    while (std::chrono::steady_clock::now() - _lastProgress < std::chrono::milliseconds(200)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (_handled.load() != _seen) {
+            _seen = _handled.load();
+            _lastProgress = std::chrono::steady_clock::now();
+        }
+    }
+
+    _stop = true;
+    _receiver.join();
+
+    //the idle tail is not part of the measurement
+    double _seconds = std::chrono::duration<double>(_lastProgress - _start).count();
+    printReceive(name, _handled.load(), _seconds, _cpu.load());
+}
+
+void benchReceive(ArtNetNode &node) {
+
+    //baseline: one recvfrom per packet
+    {
+        int _fd = socket(AF_INET, SOCK_DGRAM, 0);
+        int _enable = 1;
+        setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &_enable, sizeof(_enable));
+        int _bufferSize = 4 * 1024 * 1024;
+        setsockopt(_fd, SOL_SOCKET, SO_RCVBUF, &_bufferSize, sizeof(_bufferSize));
+        timeval _timeOut = {0, 50000};
+        setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &_timeOut, sizeof(_timeOut));
+
+        sockaddr_in _address = {};
+        _address.sin_family = AF_INET;
+        _address.sin_port = htons(artNetPort);
+        _address.sin_addr.s_addr = htonl(INADDR_ANY);
+        bind(_fd, reinterpret_cast<sockaddr*>(&_address), sizeof(_address));
+
+        runReceive("recvfrom loop", [&]() -> uint32_t {
+            uint8_t _buffer[1536];
+            sockaddr_in _sender = {};
+            socklen_t _senderLen = sizeof(_sender);
+            ssize_t _len = recvfrom(_fd, _buffer, sizeof(_buffer), 0, reinterpret_cast<sockaddr*>(&_sender), &_senderLen);
+            if (_len <= 0) {
+                return 0;
+            }
+            node.handlePacket(_buffer, static_cast<uint16_t>(_len), reinterpret_cast<uint8_t*>(&_sender.sin_addr.s_addr), 4, artNetPort);
+            return 1;
+        });
+
+        close(_fd);
+    }
+
+    //io_uring, the ring has to be used by the thread that created it
+    {
+        std::atomic<bool> _started{false};
+        ArtNetLinuxUring *_backend = nullptr;
+
+        runReceive("io_uring multishot recvmsg", [&]() -> uint32_t {
+            if (_backend == nullptr) {
+                static ArtNetLinuxUring _uring(node);
+                _backend = &_uring;
+                _started = _backend->start(artNetPort, 1024);
+                if (!_started) {
+                    printf("io_uring backend not available\n");
+                }
+            }
+            return _started ? _backend->processEvents(50000) : 0;
+        });
+
+        if (_started) {
+            const ArtNetLinuxUring::uringCounters &_counters = _backend->getCounters();
+            printf("%-26s %8.1f packets/wait, rearmed %u, truncated %lu\n", "",
+                static_cast<double>(_counters.received) / (_counters.waits ? _counters.waits : 1),
+                _counters.receiveRearmed, static_cast<unsigned long>(_counters.truncated));
+            _backend->stop();
+        }
+    }
+}
+
+/**
+ * @brief transmit all universes of the controller txRounds times and report the cpu time per packet
+ */
+void runTransmit(const char *name, ArtNetController &controller, ArtNetLinuxUring *backend) {
+
+    uint64_t _start = threadCpuNanos();
+    auto _wallStart = std::chrono::steady_clock::now();
+    uint32_t _sent = 0;
+
+    for (uint16_t r = 0; r < txRounds; r++) {
+        _sent += controller.transmitDmx();
+        if (backend != nullptr) {
+            backend->processEvents(0);
+        }
+    }
+
+    uint64_t _cpu = threadCpuNanos() - _start;
+    double _seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _wallStart).count();
+
+    printf("%-26s %8.3f Mpps, %7.1f ns cpu/packet, %u packets\n", name, _sent / _seconds / 1e6,
+        static_cast<double>(_cpu) / (_sent ? _sent : 1), _sent);
+}
+
+bool sendSingle(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort) {
+    return ArtNetLinuxUdp::sendUnicast(packet, packetLen, targetIp, targetIpLen, targetPort);
+}
+
+void benchTransmit() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x56};
+    uint8_t _targetIp[4] = {127, 0, 0, 1};
+    uint8_t _dmx[512] = {};
+
+    static ArtNetController _controller(0x0000, _mac, sizeof(_mac), controllerTables);
+
+    for (uint16_t i = 0; i < universeCount; i++) {
+        uint16_t _idx;
+        _controller.addUniverse(i, _targetIp, sizeof(_targetIp), _idx);
+        _dmx[0] = static_cast<uint8_t>(i);
+        _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+    }
+
+    //nobody listens on the target port, the kernel drops every packet the same way for all variants
+    printf("transmit %u universes x %u rounds over loopback\n", universeCount, txRounds);
+
+    if (ArtNetLinuxUdp::open(0)) {
+        _controller.setUnicastCallback(sendSingle);
+        _controller.setBatchCallback(nullptr);
+        runTransmit("sendto per packet", _controller, nullptr);
+
+        _controller.setBatchCallback(ArtNetLinuxUdp::sendBatch);
+        runTransmit("sendmmsg batch", _controller, nullptr);
+        ArtNetLinuxUdp::close();
+    }
+
+    static ArtNetLinuxUring _uring(_controller);
+    if (_uring.start(0, 64)) {
+        runTransmit("io_uring send_zc fixed", _controller, &_uring);
+        const ArtNetLinuxUring::uringCounters &_counters = _uring.getCounters();
+        printf("%-26s %lu sent, %u failed, %u copied by the kernel, %u waits for slots\n", "",
+            static_cast<unsigned long>(_counters.sent), _counters.sendFailed, _counters.sendCopied, _counters.txFull);
+        _uring.stop();
+    }
+    else {
+        printf("io_uring backend not available\n");
+    }
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetNode _node(0x0000, _mac, sizeof(_mac), ports);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        _node.configureOutputPort(i, i);
+    }
+
+    printf("receive %u ArtDmx packets over %u universes\n", packetCount, portCount);
+    benchReceive(_node);
+
+    benchTransmit();
+
+    return 0;
+}
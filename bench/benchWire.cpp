@@ -0,0 +1,143 @@
+/**
+ * @file benchWire.cpp
+ * @author your name (you@domain.com)
+ * @brief compares the wire codec against hand written byte access and raw casts of the packet
+ * @version 0.1
+ * @date 2026-01-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNet.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+constexpr uint32_t iterations = 20000000;
+constexpr uint16_t packetCount = 64;
+
+/**
+ * @brief gives access to the layouts of the base class
+ */
+class wireLayouts : public ArtNet {
+public:
+    using ArtNet::artDmxLayout;
+    using ArtNet::artPollReplyLayout;
+};
+
+typedef wireLayouts::artDmxLayout dmx;
+typedef wireLayouts::artPollReplyLayout pollReply;
+
+uint8_t packets[packetCount][dmx::length];
+
+template<typename readFunction>
+void runRead(const char *name, readFunction readHeader) {
+
+    uint32_t _checksum = 0;
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        _checksum += readHeader(packets[i % packetCount]);
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    double _ns = std::chrono::duration<double, std::nano>(_end - _start).count() / iterations;
+
+    printf("%-28s %6.2f ns/packet (checksum %u)\n", name, _ns, _checksum);
+}
+
+template<typename writeFunction>
+void runWrite(const char *name, writeFunction writeHeader) {
+
+    auto _start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        writeHeader(packets[i % packetCount], static_cast<uint16_t>(i));
+    }
+
+    auto _end = std::chrono::steady_clock::now();
+    double _ns = std::chrono::duration<double, std::nano>(_end - _start).count() / iterations;
+
+    uint32_t _checksum = 0;
+    for (uint16_t i = 0; i < packetCount; i++) {
+        _checksum += packets[i][14] + packets[i][16];
+    }
+
+    printf("%-28s %6.2f ns/packet (checksum %u)\n", name, _ns, _checksum);
+}
+
+}
+
+int main() {
+
+    for (uint16_t i = 0; i < packetCount; i++) {
+        const uint8_t _header[18] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+        memcpy(packets[i], _header, sizeof(_header));
+        packets[i][14] = static_cast<uint8_t>(i);
+        packets[i][15] = static_cast<uint8_t>(i >> 4);
+        packets[i][174 + (i & 3)] = 0x80;
+    }
+
+    printf("ArtDmx header: opCode, protVer, Port-Address, length\n");
+
+    runRead("hand written shifts", [](const uint8_t *packet) -> uint32_t {
+        uint16_t _opCode = static_cast<uint16_t>(packet[8] | (packet[9] << 8));
+        uint16_t _protVer = static_cast<uint16_t>((packet[10] << 8) | packet[11]);
+        uint16_t _portAddress = static_cast<uint16_t>(((packet[15] & 0x7f) << 8) | packet[14]);
+        uint16_t _length = static_cast<uint16_t>((packet[16] << 8) | packet[17]);
+        return _opCode + _protVer + _portAddress + _length;
+    });
+
+    runRead("memcpy + byte swap", [](const uint8_t *packet) -> uint32_t {
+        uint16_t _opCode, _protVer, _portAddress, _length;
+        memcpy(&_opCode, packet + 8, 2);
+        memcpy(&_protVer, packet + 10, 2);
+        memcpy(&_portAddress, packet + 14, 2);
+        memcpy(&_length, packet + 16, 2);
+        return _opCode + __builtin_bswap16(_protVer) + (_portAddress & 0x7fff) + __builtin_bswap16(_length);
+    });
+
+    runRead("wireReader", [](const uint8_t *packet) -> uint32_t {
+        wireReader<dmx> _packet(packet);
+        return _packet.get<dmx::opCode>() + _packet.get<dmx::protVer>() +
+            (_packet.get<dmx::portAddress>() & 0x7fff) + _packet.get<dmx::dataLength>();
+    });
+
+    runWrite("hand written shifts", [](uint8_t *packet, uint16_t value) {
+        packet[14] = value & 0xff;
+        packet[15] = (value >> 8) & 0x7f;
+        packet[16] = value >> 8;
+        packet[17] = value & 0xff;
+    });
+
+    runWrite("wireWriter", [](uint8_t *packet, uint16_t value) {
+        wireWriter<dmx> _packet(packet);
+        _packet.set<dmx::portAddress>(value & 0x7fff);
+        _packet.set<dmx::dataLength>(value);
+    });
+
+    printf("ArtPollReply port flags: isOutput of 4 ports\n");
+
+    runRead("hand written masks", [](const uint8_t *packet) -> uint32_t {
+        uint32_t _outputs = 0;
+        for (uint8_t i = 0; i < 4; i++) {
+            _outputs += (packet[174 + i] >> 7) & 1;
+        }
+        return _outputs;
+    });
+
+    runRead("wireReader", [](const uint8_t *packet) -> uint32_t {
+        wireReader<pollReply> _packet(packet);
+        uint32_t _outputs = 0;
+        for (uint8_t i = 0; i < 4; i++) {
+            _outputs += _packet.get<pollReply::isOutput>(i);
+        }
+        return _outputs;
+    });
+
+    return 0;
+}
@@ -8,11 +8,197 @@
  * @copyright Copyright (c) 2025
  * 
  */
+#pragma once
+
 #include <stdint.h>
+#include <array>
+#include <atomic>
+#include <ArtNetWire.hpp>
 
+//builds without exception support report configuration errors through the node report instead of throwing
+#if !defined(ARTNET_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS)
+#define ARTNET_NO_EXCEPTIONS
+#endif
 
 class ArtNet {
-private:
+public:
+    /**
+     * @brief result of handling a single incoming packet, also used as index into the packet counters
+     */
+    enum packetStatus {
+        psOk                    = 0,
+        psTooShort              = 1,
+        psInvalidIdent          = 2,
+        psUnsupportedVersion    = 3,
+        psUnsupportedOpCode     = 4,
+        psInvalidContent        = 5,
+        psTransmitFailed        = 6,
+        psCount                 = 7,
+    };
+
+    /**
+     * @brief enum of possible node report codes
+     * 
+     */
+    enum nodeReportCodes {
+        rcDebug         = 0x0000,
+        rcPowerOk       = 0x0001,
+        rcPowerFail     = 0x0002,
+        rcSocketWr1     = 0x0003,
+        rcParseFail     = 0x0004,
+        rcUdpFail       = 0x0005,
+        rcShNameOk      = 0x0006,
+        rcLoNameOk      = 0x0007,
+        rcDmxError      = 0x0008,
+        rcDmxUdpFull    = 0x0009,
+        rcDmxRxFull     = 0x000a,
+        rcSwitchErr     = 0x000b,
+        rcConfigErr     = 0x000c,
+        rcDmxShort      = 0x000d,
+        rcFirmwareFail  = 0x000e,
+        rcUserFail      = 0x000f,
+        rcFactoryRes    = 0x0010,
+    };
+
+    static constexpr uint8_t reportCodeCount = rcFactoryRes + 1;
+
+    /**
+     * @brief diagnostic priorities of ArtDiagData, a controller only receives messages at or above
+     * the priority requested in its ArtPoll
+     */
+    enum diagPriorities {
+        dpLow           = 0x10,
+        dpMed           = 0x40,
+        dpHigh          = 0x80,
+        dpCritical      = 0xe0,
+        dpVolatile      = 0xf0,
+    };
+
+    /**
+     * @brief counters of a single opCode
+     */
+    struct opCodeCounters {
+        std::atomic<uint32_t> packets;
+        std::atomic<uint32_t> bytes;
+    };
+
+    /**
+     * @brief counters of handled packets, indexed by packetStatus, updated with relaxed atomics so
+     * that several receive threads can share one device
+     */
+    struct packetCounters {
+        std::atomic<uint32_t> received;
+        std::atomic<uint32_t> byStatus[psCount];
+        std::atomic<uint32_t> byReportCode[reportCodeCount];    //failures mapped to node report codes
+        opCodeCounters byOpCode[256];                           //indexed by the high byte of the opCode
+    };
+
+    /**
+     * @brief plain copy of the packet counters, taken without stopping the receive path
+     */
+    struct metricsSnapshot {
+        uint32_t received;
+        uint32_t byStatus[psCount];
+        uint32_t byReportCode[reportCodeCount];
+        uint32_t opCodePackets[256];
+        uint32_t opCodeBytes[256];
+    };
+
+    /**
+     * @brief part of the device an incoming packet acts on, used to spread packets over receive threads
+     */
+    enum packetScope {
+        scopeInvalid            = 0,    //no ArtNet packet, only counted
+        scopeUniverse           = 1,    //addressed to a single Port-Address
+        scopeDevice             = 2,    //acts on the whole device
+        scopeTime               = 3,    //timing only, handled by a single receive thread without waiting for the others
+    };
+
+    /**
+     * @brief descriptor of one packet of a transmit batch, the data is not copied
+     */
+    struct txPacket {
+        const uint8_t *data;
+        uint16_t dataLen;
+        const uint8_t *targetIp;
+        uint16_t targetPort;
+    };
+
+    /**
+     * @brief possible data requests to be send to the device
+     */
+    enum dataRequestCodes {
+        drPoll = 0x0000,
+        drUrlProduct = 0x0001,
+        drUrlUserGuide = 0x0002,
+        drUrlSupport = 0x0003,
+        drUrlPersUdr = 0x0004,
+        drUrlPersGdtf = 0x0005,
+        drStartManSpec = 0x8000,
+    };
+
+    /**
+     * @brief behaviour of the outputs after their data stopped, reported in the poll reply
+     */
+    enum failSafeStates {
+        fssLastState    = 0b00,     //keep the last frame
+        fssOutputZero   = 0b01,
+        fssOutputFull   = 0b10,
+        fssPlayScene    = 0b11,     //output the scene recorded by acFailRecord
+    };
+
+    /**
+     * @brief frame types of ArtTimeCode
+     */
+    enum timeCodeTypes {
+        ttFilm                  = 0,    //24 fps
+        ttEbu                   = 1,    //25 fps
+        ttDropFrame             = 2,    //29.97 fps, drop frame counting
+        ttSmpte                 = 3,    //30 fps
+    };
+
+    /**
+     * @brief timecode value as carried by ArtTimeCode
+     */
+    struct timeCode {
+        uint8_t hours;
+        uint8_t minutes;
+        uint8_t seconds;
+        uint8_t frames;
+        uint8_t type;           //timeCodeTypes
+        uint8_t streamId;       //0 -> master stream
+    };
+
+    /**
+     * @brief date and time carried by ArtTimeSync
+     */
+    struct wallClock {
+        uint16_t year;
+        uint8_t month;          //1:12
+        uint8_t day;            //1:31
+        uint8_t weekDay;        //0 -> sunday
+        uint8_t hours;
+        uint8_t minutes;
+        uint8_t seconds;
+        bool daylightSaving;
+        bool program;           //the sender asks to set the real time clock
+    };
+
+    /**
+     * @brief state of the clock disciplined by the received timecode, all times in microseconds
+     */
+    struct timeCodeStats {
+        uint32_t received;      //packets of the followed stream
+        uint32_t relocks;       //clock set without smoothing: first packet, jump of the timecode or hold time expired
+        uint32_t dropOuts;      //gaps of more than timeCodeDropOutFrames bridged by extrapolation
+        uint32_t jitter;        //smoothed deviation of the packet spacing from the timecode spacing (as RFC 3550)
+        uint32_t maxJitter;     //largest single deviation
+        int32_t phaseError;     //deviation of the last packet from the disciplined clock
+        int32_t skew;           //rate of the source against the local clock, ppm
+        bool locked;
+    };
+
+protected:
     static constexpr uint16_t libraryVersion = 0;
     static constexpr uint16_t maxUrlLen = 64;
     static_assert(maxUrlLen >= sizeof("https://github.com/BrokuLP/Artnet"), "default url must be shorter than maxUrlLen");
@@ -24,18 +210,61 @@ private:
     static constexpr uint8_t artAddressPacketLen      = 107;
     static constexpr uint8_t artDataRequestPacketLen = 40;
     static constexpr uint8_t artDataReplyPacketLen = 20;
+    static constexpr uint8_t minArtDataRequestLen = 18;
 
     static constexpr uint16_t maxArtDataReplyPayloadLen = 512;
 
+    static constexpr uint8_t artDmxHeaderLen    = 18;
+    static constexpr uint8_t minArtDmxLen       = artDmxHeaderLen + 2;
+    static constexpr uint16_t maxDmxSlots       = 512;
+    static constexpr uint8_t minArtNzsLen       = artDmxHeaderLen + 1;
+    static constexpr uint8_t vlcStartCode       = 0x91;
+    static constexpr uint8_t artVlcHeaderLen    = 22;
+    static constexpr uint8_t artSyncPacketLen   = 14;
+    static constexpr uint8_t artTodRequestPacketLen = 56;
+    static constexpr uint8_t artTodDataHeaderLen = 28;
+    static constexpr uint8_t maxTodDataUids     = 200;
+    static constexpr uint8_t artTodControlPacketLen = 24;
+    static constexpr uint8_t artRdmHeaderLen    = 24;
+    static constexpr uint16_t maxRdmPacketLen   = 256;  //RDM message without start code, including the checksum
+    static constexpr uint8_t minRdmPacketLen    = 25;
+    static constexpr uint8_t rdmUidLen          = 6;
+    static constexpr uint8_t minArtTodDataLen   = artTodDataHeaderLen;
+    static constexpr uint8_t minArtRdmLen       = artRdmHeaderLen + minRdmPacketLen;
+    static constexpr uint8_t artDiagDataHeaderLen = 18;
+    static constexpr uint8_t artTimeCodePacketLen = 19;
+    static constexpr uint8_t artTimeSyncPacketLen = 24;
+    static constexpr uint16_t maxDiagDataLen    = 512;
+
     static constexpr uint8_t ipAddressLen       = 4;
     static constexpr uint8_t macAddressLen      = 6;
     static constexpr uint16_t artNetPort        = 0x1936;
     static constexpr uint8_t artPollTimeOut     = 3; //seconds
+    static constexpr uint8_t mergeTimeOut       = 10; //seconds
+    static constexpr uint8_t syncTimeOut        = 4; //seconds
+    static constexpr uint8_t defaultRefreshRate = 44; //Hz
+    static constexpr uint8_t maxAcnPriority     = 200;
+    static constexpr uint8_t maxPendingReplies  = 16;
     static constexpr uint8_t minArtPollLen      = 14;
     static constexpr uint16_t minProtVersion    = 14;
     static constexpr uint16_t protVersion       = 14;
     static constexpr uint8_t artNetIdentLen     = 8;
     static constexpr uint8_t minArtIpProgPacketLen = 207;
+    static constexpr uint8_t minArtPollReplyLen = 207;
+
+    static constexpr uint8_t timeCodeTypeCount  = ttSmpte + 1;
+    static constexpr uint16_t timeCodeHold      = 2000; //milliseconds, default
+    static constexpr uint8_t timeCodeRelockFrames = 2;  //larger errors are taken as a jump of the timecode
+    static constexpr uint8_t timeCodeDropOutFrames = 3;
+    static constexpr int64_t maxTimeCodeSkew    = 1000000; //ppb
+    static constexpr int64_t timeCodePhaseGain  = 32;   //the phase follows 1/32 of the error per packet
+    static constexpr int64_t timeCodeRateGain   = 2048; //the rate follows 1/2048 of the error per elapsed time
+    static constexpr uint8_t timeSyncProgram    = 0xaa;
+
+    //labelled frames per second and exact frame period (periodMicros / periodFrames) of every timeCodeType
+    static constexpr uint8_t timeCodeRates[timeCodeTypeCount] = {24, 25, 30, 30};
+    static constexpr uint32_t timeCodePeriodMicros[timeCodeTypeCount] = {1000000, 1000000, 1001000, 1000000};
+    static constexpr uint32_t timeCodePeriodFrames[timeCodeTypeCount] = {24, 25, 30, 30};
 
     static constexpr uint8_t artNetIdent[artNetIdentLen] = {'A', 'r', 't','-','N','e', 't', 0x00};
 
@@ -97,30 +326,6 @@ private:
         opDirectoryReply    = 0x9b00,
     };
 
-    /**
-     * @brief enum of possible node report codes
-     * 
-     */
-    enum nodeReportCodes {
-        rcDebug         = 0x0000,
-        rcPowerOk       = 0x0001,
-        rcPowerFail     = 0x0002,
-        rcSocketWr1     = 0x0003,
-        rcParseFail     = 0x0004,
-        rcUdpFail       = 0x0005,
-        rcShNameOk      = 0x0006,
-        rcLoNameOk      = 0x0007,
-        rcDmxError      = 0x0008,
-        rcDmxUdpFull    = 0x0009,
-        rcDmxRxFull     = 0x000a,
-        rcSwitchErr     = 0x000b,
-        rcConfigErr     = 0x000c,
-        rcDmxShort      = 0x000d,
-        rcFirmwareFail  = 0x000e,
-        rcUserFail      = 0x000f,
-        rcFactoryRes    = 0x0010,
-    };
-
     /**
      * @brief enum with possible indicator states for artNetPollReply
      * 
@@ -152,13 +357,6 @@ private:
         ptcDali      = 0b000110,
     };
 
-    enum failSafeStates {
-        fssLastState    = 0b00,
-        fssOutputZero   = 0b01,
-        fssOutputFull   = 0b10,
-        fssPlayScene    = 0b11,
-    };
-
     enum backgroundQueuePolicys {
         bqpStatusNone       = 0,
         bqpStatusAdvisory   = 1,
@@ -167,19 +365,6 @@ private:
         bqpDisabled         = 4,
     };
 
-    /**
-     * @brief possible data requests to be send to the device
-     */
-    enum dataRequestCodes {
-        drPoll = 0x0000,
-        drUrlProduct = 0x0001,
-        drUrlUserGuide = 0x0002,
-        drUrlSupport = 0x0003,
-        drUrlPersUdr = 0x0004,
-        drUrlPersGdtf = 0x0005,
-        drStartManSpec = 0x8000,
-    };
-
     /**
      * @brief possible commands to be used in ArtAddressPackets
      */
@@ -259,11 +444,22 @@ private:
         acBqp15         = 0xef,
     };
 
+    /**
+     * @brief possible commands of ArtTodControl packets
+     */
+    enum todControlCommands {
+        tcNone          = 0x00,
+        tcFlush         = 0x01,     //full discovery, the node answers with its new table
+        tcEnd           = 0x02,
+        tcIncOn         = 0x03,     //enable incremental discovery
+        tcIncOff        = 0x04,
+    };
+
     /**
      * @brief configuration of a specific port on the node
      */
     struct portConfig {
-        uint8_t universe;
+        uint16_t portAddress;
         bool isInput;
         bool isOutput;
     };
@@ -272,12 +468,14 @@ private:
      * @brief struct to hold the configuration of the device
      */
     struct configuration {
+        uint8_t shortName[18] = "Artnet";
+        uint8_t longName[64] = "BrokuLP Artnet";
+        uint8_t nodeReport[64] = "#0001 [0000] ok";
         uint8_t urlProduct[maxUrlLen] = "https://github.com/BrokuLP/Artnet";
         uint8_t urlUserGuide[maxUrlLen] = "https://github.com/BrokuLP/Artnet";
         uint8_t urlSupport[maxUrlLen] = "https://github.com/BrokuLP/Artnet";
         uint8_t urlPersGdtf[maxUrlLen] = "https://github.com/BrokuLP/Artnet";
         uint8_t urlPersUdr[maxUrlLen] = "https://github.com/BrokuLP/Artnet";
-        portConfig ports[4];
         uint8_t ipAddress[ipAddressLen];
         uint8_t macAddress[macAddressLen];
         styleCodes deviceStyle;
@@ -294,222 +492,461 @@ private:
         bool dhcpEnabled;
     };
 
-    struct commonHeader{
-        uint8_t ident[artNetIdentLen];
+    /**
+     * @brief wire layouts of the packets, every field carries its offset, size and byte order.
+     * packets are read and written in place through wireReader / wireWriter, never through casts
+     */
+    struct artHeaderLayout {
+        static constexpr uint16_t length = 10;
+        typedef wireBytes<0, artNetIdentLen> ident;
+        typedef wireField<8, 2, woLittleEndian> opCode;
+    };
+
+    struct artProtVerLayout : artHeaderLayout {
+        static constexpr uint16_t length = 12;
+        typedef wireField<10, 2, woBigEndian> protVer;
+    };
+
+    /**
+     * @brief layout of an artPoll packet
+     */
+    struct artPollLayout : artProtVerLayout {
+        static constexpr uint16_t length = artPollPacketLen;
+        typedef wireBits<12, 5> targetModeEnable;
+        typedef wireBits<12, 4> VLCDisable;
+        typedef wireBits<12, 3> diagMsgIsUnicast;
+        typedef wireBits<12, 2> sendDiagMsg;
+        typedef wireBits<12, 1> sendReplyOnChange;
+        typedef wireField<13, 1> diagPriority;
+        typedef wireField<14, 2, woBigEndian> targetPortAddressTop;
+        typedef wireField<16, 2, woBigEndian> targetPortAddressBottom;
+        typedef wireField<18, 2, woBigEndian> estaMan;
+        typedef wireField<20, 2, woBigEndian> oem;
+    };
+    static_assert(artPollLayout::oem::end == artPollPacketLen, "artPollLayout does not match artPollPacketLen");
+
+    /**
+     * @brief layout of an artPollReply packet, per port fields hold 4 bytes (one per port of the page)
+     */
+    struct artPollReplyLayout : artHeaderLayout {
+        static constexpr uint16_t length = artIpProgPacketPacketLen;
+        typedef wireBytes<10, ipAddressLen> ipAddress;
+        typedef wireField<14, 2, woLittleEndian> port;
+        typedef wireField<16, 2, woBigEndian> versionInfo;
+        typedef wireField<18, 1> netSwitch;
+        typedef wireField<19, 1> subSwitch;
+        typedef wireField<20, 2, woBigEndian> oemCode;
+        typedef wireField<22, 1> ubeaVersion;
+        typedef wireBits<23, 6, 2> indicatorState;
+        typedef wireBits<23, 4, 2> portProgAuthority;
+        typedef wireBits<23, 2> romBootEnable;
+        typedef wireBits<23, 1> rdmAvailable;
+        typedef wireBits<23, 0> ubeaPresent;
+        typedef wireField<24, 2, woLittleEndian> estaMan;
+        typedef wireBytes<26, 18> portName;
+        typedef wireBytes<44, 64> longName;
+        typedef wireBytes<108, 64> nodeReport;
+        typedef wireField<172, 2, woBigEndian> numPorts;
+        typedef wireBits<174, 7, 1, 4> isOutput;
+        typedef wireBits<174, 6, 1, 4> isInput;
+        typedef wireBits<174, 0, 6, 4> portType;
+        typedef wireBits<178, 7, 1, 4> inputDataReceived;
+        typedef wireBits<178, 3, 1, 4> inputDisabled;
+        typedef wireBits<178, 2, 1, 4> inputReceiveErrors;
+        typedef wireBits<178, 0, 1, 4> inputFromSacn;      //GoodInput, input is fed by sACN
+        typedef wireBits<182, 7, 1, 4> outputActive;
+        typedef wireBits<182, 3, 1, 4> isMergingArtNet;
+        typedef wireBits<182, 2, 1, 4> shortCircuitDetect;
+        typedef wireBits<182, 1, 1, 4> ltpIsMergeMode;
+        typedef wireBits<182, 0, 1, 4> outputToSacn;       //GoodOutputA, output transmits sACN
+        typedef wireBytes<186, 4> swIn;
+        typedef wireBytes<190, 4> swOut;
+        typedef wireField<194, 1> acnPriority;
+        typedef wireField<195, 1> swMacro;
+        typedef wireField<196, 1> swRemote;
+        typedef wireField<200, 1> style;
+        typedef wireBytes<201, macAddressLen> MAC;
+        typedef wireBytes<207, ipAddressLen> bindIp;
+        typedef wireField<211, 1> bindIndex;
+        typedef wireBits<212, 7> supportsRDM;
+        typedef wireBits<212, 6> supportsSwitching;
+        typedef wireBits<212, 5> isSquawking;
+        typedef wireBits<212, 4> sACNSupported;
+        typedef wireBits<212, 3> longAddressSupport;
+        typedef wireBits<212, 2> capableOfDHCP;
+        typedef wireBits<212, 1> isDHCPConfigured;
+        typedef wireBits<212, 0> supportsWebConf;
+        typedef wireBits<213, 7, 1, 4> rdmDisabled;
+        typedef wireBits<213, 6, 1, 4> outputStyleContinuous;
+        typedef wireBits<213, 5, 1, 4> discoveryNotRunning;
+        typedef wireBits<213, 4, 1, 4> bckgDiscoveryDisabled;
+        typedef wireBits<217, 6, 2> failSafeState;
+        typedef wireBits<217, 5> progFailSafeSupported;
+        typedef wireBits<217, 4> llrpSupported;
+        typedef wireBits<217, 3> portDirSwSupported;
+        typedef wireBits<217, 2> rdmNetSupported;
+        typedef wireBits<217, 1> bckgQueueSupported;
+        typedef wireBits<217, 0> bckgDisConfSupport;
+        typedef wireBytes<218, 6> defaultRespUid;
+        typedef wireField<224, 2, woBigEndian> user;
+        typedef wireField<226, 2, woBigEndian> refreshRate;
+        typedef wireField<228, 1> backgroundQueuePolicy;
+        typedef wireBytes<229, 10> filler;
+    };
+    static_assert(artPollReplyLayout::filler::end == artIpProgPacketPacketLen, "artPollReplyLayout does not match its length");
+
+    /**
+     * @brief storage of one complete artPollReply as sent on the wire
+     */
+    struct ArtPollReplyPacket {
+        uint8_t data[artPollReplyLayout::length];
+    };
+
+    struct artIpProgLayout : artProtVerLayout {
+        static constexpr uint16_t length = artIpProgPacketLen;
+        typedef wireBits<14, 7> programmingEnable;
+        typedef wireBits<14, 6> dhcpEnable;
+        typedef wireBits<14, 4> progDefaultGateWay;
+        typedef wireBits<14, 3> resetToDefault;
+        typedef wireBits<14, 2> programIpAddress;
+        typedef wireBits<14, 1> programSubNetMask;
+        typedef wireBits<14, 0> programPort;
+        typedef wireBytes<16, ipAddressLen> progIp;
+        typedef wireBytes<20, ipAddressLen> progSm;
+        typedef wireField<24, 2, woBigEndian> progPort;  //deprecated
+        typedef wireBytes<26, ipAddressLen> progDg;
+    };
+    static_assert(artIpProgLayout::progDg::end <= artIpProgPacketLen, "artIpProgLayout does not match artIpProgPacketLen");
+
+    struct artIpProgReplyLayout : artProtVerLayout {
+        static constexpr uint16_t length = artIpProgReplyLen;
+        typedef wireBytes<16, ipAddressLen> progIp;
+        typedef wireBytes<20, ipAddressLen> progSm;
+        typedef wireField<24, 2, woBigEndian> progPort;  //deprecated
+        typedef wireBits<26, 6> dhcpEnabled;
+        typedef wireBytes<28, ipAddressLen> progDg;
+        typedef wireBytes<32, 2> spare;
+    };
+    static_assert(artIpProgReplyLayout::spare::end == artIpProgReplyLen, "artIpProgReplyLayout does not match artIpProgReplyLen");
+
+    struct artAddressLayout : artProtVerLayout {
+        static constexpr uint16_t length = artAddressPacketLen;
+        typedef wireField<12, 1> netSwitch;
+        typedef wireField<13, 1> bindIndex;
+        typedef wireBytes<14, 18> portName;
+        typedef wireBytes<32, 64> longName;
+        typedef wireBytes<96, 4> swIn;
+        typedef wireBytes<100, 4> swOut;
+        typedef wireField<104, 1> subSwitch;
+        typedef wireField<105, 1> acnPriority;
+        typedef wireField<106, 1> command;
+    };
+    static_assert(artAddressLayout::command::end == artAddressPacketLen, "artAddressLayout does not match artAddressPacketLen");
+
+    struct artDataRequestLayout : artProtVerLayout {
+        static constexpr uint16_t length = artDataRequestPacketLen;
+        typedef wireField<12, 2, woBigEndian> estaMan;
+        typedef wireField<14, 2, woBigEndian> oemCode;
+        typedef wireField<16, 2, woBigEndian> request;
+        typedef wireBytes<18, 22> spare;
+    };
+    static_assert(artDataRequestLayout::spare::end == artDataRequestPacketLen, "artDataRequestLayout does not match artDataRequestPacketLen");
+
+    struct artDataReplyLayout : artProtVerLayout {
+        static constexpr uint16_t length = artDataReplyPacketLen + maxArtDataReplyPayloadLen;
+        typedef wireField<12, 2, woBigEndian> estaMan;
+        typedef wireField<14, 2, woBigEndian> oemCode;
+        typedef wireField<16, 2, woBigEndian> request;
+        typedef wireField<18, 2, woBigEndian> payloadLen;
+        typedef wireBytes<20, maxArtDataReplyPayloadLen> payload;
+    };
+    static_assert(artDataReplyLayout::payloadLen::end == artDataReplyPacketLen, "artDataReplyLayout does not match artDataReplyPacketLen");
+
+    /**
+     * @brief layout of an artDmx packet, SubUni and Net form the Port-Address low byte first
+     */
+    struct artDmxLayout : artProtVerLayout {
+        static constexpr uint16_t length = artDmxHeaderLen + maxDmxSlots;
+        typedef wireField<12, 1> sequence;
+        typedef wireField<13, 1> physical;
+        typedef wireField<14, 2, woLittleEndian> portAddress;
+        typedef wireField<14, 1> subUni;
+        typedef wireField<15, 1> net;
+        typedef wireField<16, 2, woBigEndian> dataLength;
+        typedef wireBytes<artDmxHeaderLen, maxDmxSlots> data;
+    };
+    static_assert(artDmxLayout::dataLength::end == artDmxHeaderLen, "artDmxLayout does not match artDmxHeaderLen");
+
+    struct artNzsLayout : artProtVerLayout {
+        static constexpr uint16_t length = artDmxHeaderLen + maxDmxSlots;
+        typedef wireField<12, 1> sequence;
+        typedef wireField<13, 1> startCode;
+        typedef wireField<14, 2, woLittleEndian> portAddress;
+        typedef wireField<16, 2, woBigEndian> dataLength;
+        typedef wireBytes<artDmxHeaderLen, maxDmxSlots> data;
+    };
+    static_assert(artNzsLayout::dataLength::end == artDmxHeaderLen, "artNzsLayout does not match artDmxHeaderLen");
+
+    /**
+     * @brief layout of the VLC data carried in the data of an ArtNzs packet with start code 0x91,
+     * offsets are relative to the start of the data
+     */
+    struct artVlcLayout {
+        static constexpr uint16_t length = maxDmxSlots;
+        typedef wireBytes<0, 3> magic;
+        typedef wireBits<3, 7> ieee;
+        typedef wireBits<3, 6> reply;
+        typedef wireBits<3, 5> beacon;
+        typedef wireField<4, 2, woBigEndian> transaction;
+        typedef wireField<6, 2, woBigEndian> slotAddress;
+        typedef wireField<8, 2, woBigEndian> payloadCount;
+        typedef wireField<10, 2, woBigEndian> payloadChecksum;
+        typedef wireField<13, 1> depth;
+        typedef wireField<14, 2, woBigEndian> frequency;
+        typedef wireField<16, 2, woBigEndian> modulation;
+        typedef wireField<18, 2, woBigEndian> payloadLanguage;
+        typedef wireField<20, 2, woBigEndian> beaconRepeat;
+        typedef wireBytes<artVlcHeaderLen, maxDmxSlots - artVlcHeaderLen> payload;
+    };
+    static_assert(artVlcLayout::beaconRepeat::end == artVlcHeaderLen, "artVlcLayout does not match artVlcHeaderLen");
+
+    //manufacturer id and sub-code identifying VLC data
+    static constexpr uint8_t vlcMagic[3] = {0x41, 0x4c, 0x45};
+
+    struct artTodRequestLayout : artProtVerLayout {
+        static constexpr uint16_t length = artTodRequestPacketLen;
+        typedef wireField<21, 1> net;
+        typedef wireField<22, 1> command;
+        typedef wireField<23, 1> addressCount;
+        typedef wireBytes<24, 32> addresses;
+    };
+    static_assert(artTodRequestLayout::addresses::end == artTodRequestPacketLen, "artTodRequestLayout does not match artTodRequestPacketLen");
+
+    struct artTodDataLayout : artProtVerLayout {
+        static constexpr uint16_t length = artTodDataHeaderLen + maxTodDataUids * rdmUidLen;
+        typedef wireField<12, 1> rdmVer;
+        typedef wireField<13, 1> port;
+        typedef wireField<20, 1> bindIndex;
+        typedef wireField<21, 1> net;
+        typedef wireField<22, 1> commandResponse;
+        typedef wireField<23, 1> address;
+        typedef wireField<24, 2, woBigEndian> uidTotal;
+        typedef wireField<26, 1> blockCount;
+        typedef wireField<27, 1> uidCount;
+        typedef wireBytes<artTodDataHeaderLen, maxTodDataUids * rdmUidLen> tod;
+    };
+    static_assert(artTodDataLayout::uidCount::end == artTodDataHeaderLen, "artTodDataLayout does not match artTodDataHeaderLen");
+
+    struct artTodControlLayout : artProtVerLayout {
+        static constexpr uint16_t length = artTodControlPacketLen;
+        typedef wireField<21, 1> net;
+        typedef wireField<22, 1> command;
+        typedef wireField<23, 1> address;
+    };
+    static_assert(artTodControlLayout::address::end == artTodControlPacketLen, "artTodControlLayout does not match artTodControlPacketLen");
+
+    struct artRdmLayout : artProtVerLayout {
+        static constexpr uint16_t length = artRdmHeaderLen + maxRdmPacketLen;
+        typedef wireField<12, 1> rdmVer;
+        typedef wireField<19, 1> fifoAvail;
+        typedef wireField<20, 1> fifoMax;
+        typedef wireField<21, 1> net;
+        typedef wireField<22, 1> command;
+        typedef wireField<23, 1> address;
+        typedef wireBytes<artRdmHeaderLen, maxRdmPacketLen> rdmPacket;
+    };
+    static_assert(artRdmLayout::address::end == artRdmHeaderLen, "artRdmLayout does not match artRdmHeaderLen");
+
+    /**
+     * @brief layout of an RDM message as carried in ArtRdm, the start code 0xcc is not transmitted
+     */
+    struct rdmLayout {
+        static constexpr uint16_t length = maxRdmPacketLen;
+        typedef wireField<0, 1> subStartCode;
+        typedef wireField<1, 1> messageLength;      //counted from the start code, without the checksum
+        typedef wireBytes<2, rdmUidLen> destinationUid;
+        typedef wireBytes<8, rdmUidLen> sourceUid;
+        typedef wireField<14, 1> transaction;
+        typedef wireField<15, 1> portId;            //response type in responses
+        typedef wireField<16, 1> messageCount;
+        typedef wireField<17, 2, woBigEndian> subDevice;
+        typedef wireField<19, 1> commandClass;
+        typedef wireField<20, 2, woBigEndian> parameterId;
+        typedef wireField<22, 1> parameterDataLength;
+    };
+
+    struct artSyncLayout : artProtVerLayout {
+        static constexpr uint16_t length = artSyncPacketLen;
+        typedef wireField<12, 1> aux1;
+        typedef wireField<13, 1> aux2;
+    };
+    static_assert(artSyncLayout::aux2::end == artSyncPacketLen, "artSyncLayout does not match artSyncPacketLen");
+
+    struct artDiagDataLayout : artProtVerLayout {
+        static constexpr uint16_t length = artDiagDataHeaderLen + maxDiagDataLen;
+        typedef wireField<13, 1> diagPriority;
+        typedef wireField<14, 1> logicalPort;
+        typedef wireField<16, 2, woBigEndian> dataLength;
+        typedef wireBytes<artDiagDataHeaderLen, maxDiagDataLen> data;
+    };
+    static_assert(artDiagDataLayout::dataLength::end == artDiagDataHeaderLen, "artDiagDataLayout does not match artDiagDataHeaderLen");
+
+    struct artTimeCodeLayout : artProtVerLayout {
+        static constexpr uint16_t length = artTimeCodePacketLen;
+        typedef wireField<13, 1> streamId;
+        typedef wireField<14, 1> frames;
+        typedef wireField<15, 1> seconds;
+        typedef wireField<16, 1> minutes;
+        typedef wireField<17, 1> hours;
+        typedef wireField<18, 1> type;
+    };
+    static_assert(artTimeCodeLayout::type::end == artTimeCodePacketLen, "artTimeCodeLayout does not match artTimeCodePacketLen");
+
+    struct artTimeSyncLayout : artProtVerLayout {
+        static constexpr uint16_t length = artTimeSyncPacketLen;
+        typedef wireField<14, 1> prog;
+        typedef wireField<15, 1> seconds;
+        typedef wireField<16, 1> minutes;
+        typedef wireField<17, 1> hours;
+        typedef wireField<18, 1> day;
+        typedef wireField<19, 1> month;          //0:11
+        typedef wireField<20, 2, woBigEndian> year;  //years since 1900
+        typedef wireField<22, 1> weekDay;
+        typedef wireField<23, 1> daylightSaving;
+    };
+    static_assert(artTimeSyncLayout::daylightSaving::end == artTimeSyncPacketLen, "artTimeSyncLayout does not match artTimeSyncPacketLen");
+
+    /**
+     * @brief signature of the handlers called by the opCode dispatcher, the packet is already
+     * checked for a valid header, the minimum length and (if required) the protocol version
+     */
+    typedef packetStatus (ArtNet::*packetHandler)(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief entry of the opCode dispatch table
+     */
+    struct dispatchEntry {
         uint16_t opCode;
-    }__attribute__((__packed__));
-    static_assert(sizeof(commonHeader) == 10, "common header has invalid size");
+        uint16_t minLen;
+        bool hasProtVer;
+        packetHandler handler;
+    };
 
     /**
-     * @brief packet structure of an artPoll packet
-     * 
+     * @brief dispatch table indexed by the high byte of the opCode, built at compile time
      */
-    struct artPollPacket{
-        commonHeader artHeader;
-        uint16_t protVer;
-        struct{
-            unsigned int padding            : 2;
-            unsigned int targetModeEnable   : 1;
-            unsigned int VLCEnable          : 1;
-            unsigned int diagMsgIsUnicast   : 1;
-            unsigned int sendDiagMsg        : 1;
-            unsigned int sendReplyOnChange  : 1;
-            unsigned int deprecated         : 1;
-        }__attribute__((__packed__)) flags;
-        uint8_t diagPriority;
-        uint16_t targetPortAddressTop;
-        uint16_t targetPortAddressBottom;
-        uint16_t estaMan;
-        uint16_t oem;
-    }__attribute__((__packed__));
-    static_assert(sizeof(artPollPacket) == artPollPacketLen, "artPollPacket has incorrect size");
-
-    struct ArtPollReplyPacket{
-        commonHeader artHeader;
-        uint8_t ipAddress[4];
-        uint16_t port;
-        uint16_t versionInfo;
-        uint8_t netSwitch;
-        uint8_t subSwitch;
-        uint16_t oemCode;
-        uint8_t ubeaVersion;
-        struct {
-            unsigned int indicatorState     : 2;
-            unsigned int portProgAuthority  : 2;
-            unsigned int padding            : 1;
-            unsigned int romBootEnable      : 1;
-            unsigned int rdmAvailable       : 1;
-            unsigned int ubeaPresent        : 1;
-        }__attribute__((__packed__)) status1;
-        uint16_t estaMan;
-        uint8_t portName[18];
-        uint8_t longName[64];
-        uint8_t nodeReport[64];
-        uint16_t numPorts;
-        struct {
-            unsigned int isInput    : 1;
-            unsigned int isOutput   : 1;
-            unsigned int type       : 5;
-        }__attribute__((__packed__)) portTypes[4];
-        struct {
-            unsigned int dataReceived       : 1;
-            unsigned int dmx512HasTestPkg   : 1;
-            unsigned int dmx512HasSIP       : 1;
-            unsigned int dmx512HasTextPkg   : 1;
-            unsigned int inputDisabled      : 1;
-            unsigned int receiveErrors      : 1;
-            unsigned int padding            : 1;
-            unsigned int convertToSacn      : 1;
-        }__attribute__((__packed__)) goodInput[4];
-        struct {
-            unsigned int isActive           : 1;
-            unsigned int dmx512HasTestPkg   : 1;
-            unsigned int dmx512HasSIP       : 1;
-            unsigned int dmx512HasTextPkg   : 1;
-            unsigned int isMergingArtNet    : 1;
-            unsigned int shortCircuitDetect : 1;
-            unsigned int ltpIsMergeMode     : 1;
-            unsigned int convertFromSacn    : 1;
-        }__attribute__((__packed__)) goodOutputA[4];
-        uint8_t swIn[4];
-        uint8_t swOut[4];
-        uint8_t acnPriority;
-        struct {
-            unsigned int macro8Active   : 1;
-            unsigned int macro7Active   : 1;
-            unsigned int macro6Active   : 1;
-            unsigned int macro5Active   : 1;
-            unsigned int macro4Active   : 1;
-            unsigned int macro3Active   : 1;
-            unsigned int macro2Active   : 1;
-            unsigned int macro1Active   : 1;
-        }__attribute__((__packed__)) swMacro;
-        struct {
-            unsigned int remote8Active  : 1;
-            unsigned int remote7Active  : 1;
-            unsigned int remote6Active  : 1;
-            unsigned int remote5Active  : 1;
-            unsigned int remote4Active  : 1;
-            unsigned int remote3Active  : 1;
-            unsigned int remote2Active  : 1;
-            unsigned int remote1Active  : 1;
-        }__attribute__((__packed__)) swRemote;
-        uint8_t spare[3];
-        uint8_t style;
-        uint8_t MAC[6];
-        uint8_t bindIp[4];
-        uint8_t bindIndex;
-        struct {
-            unsigned int supportsRDM        : 1;
-            unsigned int supportsSwitching  : 1;
-            unsigned int isSquawking        : 1;
-            unsigned int sACNSupported      : 1;
-            unsigned int longAddressSupport : 1;
-            unsigned int capableOfDHCP      : 1;
-            unsigned int isDHCPConfigured   : 1;
-            unsigned int supportsWebConf    : 1;
-        }__attribute__((__packed__)) status2;
-        struct {
-            unsigned int rdmDisabled            : 1;
-            unsigned int outputStyleContinuous  : 1;
-            unsigned int discoveryNotRunning    : 1;
-            unsigned int bckgDiscoveryDisabled  : 1;
-            unsigned int padding                : 4;
-        }__attribute__((__packed__)) goodOutputB[4];
-        struct {
-            unsigned int failSafeState          : 2;
-            unsigned int progFailSafeSupported  : 1;
-            unsigned int llrpSupported          : 1;
-            unsigned int portDirSwSupported     : 1;
-            unsigned int rdmNetSupported        : 1;
-            unsigned int bckgQueueSupported     : 1;
-            unsigned int bckgDisConfSupport     : 1;
-        }__attribute__((__packed__)) status3;
-        uint8_t defaultRespUid[6];
-        uint16_t user;
-        uint16_t refreshRate;
-        uint8_t backgroundQueuePolicy;
-        uint8_t Filler[10];
-    }__attribute__((__packed__));
-    static_assert(sizeof(ArtPollReplyPacket) == artIpProgPacketPacketLen, "ArtPollReplyPacket has invalid size");
-
-    struct ArtIpProgPacket {
-        commonHeader artHeader;
-        uint16_t protVersion;
-        uint8_t filler[2];
-        struct {
-            unsigned int programmingEnable  : 1;
-            unsigned int dhcpEnable         : 1;
-            unsigned int padding            : 1;
-            unsigned int progDefaultGateWay : 1;
-            unsigned int resetToDefault     : 1;
-            unsigned int programIpAddress   : 1;
-            unsigned int programSubNetMask  : 1;
-            unsigned int programPort        : 1;
-        }__attribute__((__packed__)) command;
-        uint8_t filler4;
-        uint8_t progIp[4];
-        uint8_t progSm[4];
-        uint8_t progDg[4];
-        uint8_t spare[5];
-    }__attribute__((__packed__));
-    static_assert(sizeof(ArtIpProgPacket) == artIpProgPacketLen, "ArtIpProgPacket has invalid size");
-    
-    struct ArtIpProgReply{
-        commonHeader artHeader;
-        uint16_t protVersion;
-        uint8_t filler[4];
-        uint8_t progIp[4];
-        uint8_t progSm[4];
-        uint16_t progPort; //deprecated
-        struct {
-            unsigned int padding        : 1;
-            unsigned int dhcpEnabled    : 1;
-            unsigned int padding1       : 6;
-        }__attribute__((__packed__)) status;
-        uint8_t spare2;
-        uint8_t progDg[4];
-        uint8_t spare3[2];
-    }__attribute__((__packed__));
-    static_assert(sizeof(ArtIpProgReply) == artIpProgReplyLen, "ArtIpProgReply has invalid size");
-
-    struct ArtAddressPacket {
-        commonHeader artHeader;
-        uint16_t protVersion;
-        uint8_t netSwitch;
-        uint8_t bindIndex;
-        uint8_t portName[18];
-        uint8_t longName[64];
-        uint8_t swIn[4];
-        uint8_t swOut[4];
-        uint8_t subSwitch;
-        uint8_t acnPriority;
-        uint8_t command;
-    }__attribute__((__packed__));
-    static_assert(sizeof(ArtAddressPacket) == artAddressPacketLen, "ArtAddressPacket has invalid size");
-    
-    struct ArtDataRequestPacket {
-        commonHeader artHeader;
-        uint16_t protVersion;
-        uint16_t estaMan;
-        uint16_t oemCode;
-        uint16_t request;
-        uint8_t spare[22];
-    }__attribute__((__packed__));
-    static_assert(sizeof(ArtDataRequestPacket) == artDataRequestPacketLen, "ArtDataRequestPacket has invalid size");
-
-    struct ArtDataReplyPacket {
-        commonHeader artHeader;
-        uint16_t protVersion;
-        uint16_t estaMan;
-        uint16_t oemCode;
-        uint16_t request;
-        uint16_t payloadLen;
-    }__attribute__((__packed__));
-    static_assert(sizeof(ArtDataReplyPacket) == artDataReplyPacketLen, "artDataReplyPacket has invalid size");
+    static const std::array<dispatchEntry, 256> dispatchTable;
+
+    /**
+     * @brief build the dispatch table from the list of handled opCodes
+     */
+    static constexpr std::array<dispatchEntry, 256> buildDispatchTable();
+
+    /**
+     * @brief poll reply scheduled for a later point in time
+     */
+    struct pendingReply {
+        uint8_t targetIp[ipAddressLen];
+        uint64_t due;   //microseconds
+        bool used;
+    };
 
     //private storage stuff
-    struct configuration sysConf;
+    struct configuration sysConf = {};
+    packetCounters counters = {};
+
+    //ports of the device, the storage is provided by the device type, 4 ports form one page
+    portConfig *ports = nullptr;
+    uint16_t numPorts = 0;
+
+    //complete wire images of the poll replies (one per page), rebuilt only after the configuration changed
+    ArtPollReplyPacket pollReply;
+    ArtPollReplyPacket *pollReplies = &pollReply;
+    uint16_t numPollPages = 1;
+    std::atomic<bool> pollReplyDirty{true};
+
+    uint16_t replyJitterMax = 0;    //milliseconds
+    std::atomic<bool> receiveServiceExternal{false};
+    uint32_t replyRandom = 0x9e3779b9;
+    pendingReply pendingReplies[maxPendingReplies] = {};
+
+    //controller which asked for diagnostics with its last ArtPoll
+    uint8_t diagTargetIp[ipAddressLen] = {};
+
+    //indicator state reported in the poll reply, set by ArtAddress
+    uint8_t indicator = isNormal;
+
+    //poll reply announcing a change, changes inside the window are sent as one reply. receive threads only
+    //merge their target into changeReplyTarget, the window is owned by service()
+    std::atomic<uint32_t> changeReplyTarget{0};     //ip of the receivers, 0 -> none requested, all ones -> broadcast
+    uint16_t changeReplyWindow = 0;                 //milliseconds
+    uint64_t changeReplyDue = 0;                    //microseconds
+    uint32_t changeReplyIp = 0;
+    bool changeReplyScheduled = false;
+
+    //drPoll and the URL requests are answered from replies encoded when the configuration changes
+    static constexpr uint8_t cachedDataReplyCount = drUrlPersGdtf + 1;
+
+    /**
+     * @brief complete wire image of an ArtDataReply
+     */
+    struct dataReplyImage {
+        uint8_t data[artDataReplyPacketLen + maxUrlLen];
+        uint16_t length;
+    };
+
+    dataReplyImage dataReplies[cachedDataReplyCount] = {};
+
+    //header encoded once, the payload is filled by the handler of manufacturer specific requests
+    uint8_t manSpecReply[artDataReplyLayout::length] = {};
+
+    /**
+     * @brief clock disciplined by the received timecode, the timecode is kept in microseconds since 00:00:00:00,
+     * written by the receive thread handling timecode and read through timeClockSequence
+     */
+    struct timeCodeClock {
+        uint64_t baseTime;          //local time of the reference point
+        int64_t baseValue;          //timecode at the reference point
+        uint64_t lastReceived;
+        int64_t lastValue;
+        int64_t skew;               //ppb, reported in ppm
+        uint32_t jitterScaled;      //jitter * 16
+        uint8_t type;
+        uint8_t streamId;
+        timeCodeStats stats;
+    };
+
+    timeCodeClock timeClock = {};
+    std::atomic<uint32_t> timeClockSequence{0};     //odd while the clock is updated
+    uint8_t timeCodeStream = 0;
+    uint64_t timeCodeHoldTime = timeCodeHold * 1000ULL;
+
+    /**
+     * @brief node report code of every packetStatus, rcDebug -> not reported
+     */
+    static constexpr nodeReportCodes statusReportCodes[psCount] = {
+        rcDebug,        //psOk
+        rcParseFail,    //psTooShort
+        rcParseFail,    //psInvalidIdent
+        rcParseFail,    //psUnsupportedVersion
+        rcDebug,        //psUnsupportedOpCode, valid packet not handled by this device type
+        rcParseFail,    //psInvalidContent
+        rcUdpFail,      //psTransmitFailed
+    };
+
+    /**
+     * @brief count the result of a handled packet
+     * 
+     * @param status result of the packet handling
+     * @return the passed status
+     */
+    packetStatus countStatus(packetStatus status) {
+        counters.byStatus[status].fetch_add(1, std::memory_order_relaxed);
+        if (statusReportCodes[status] != rcDebug) {
+            counters.byReportCode[statusReportCodes[status]].fetch_add(1, std::memory_order_relaxed);
+        }
+        return status;
+    }
 
     /**
      * @brief calculate the default ip as outlined in the ArtNet spec
@@ -522,10 +959,89 @@ private:
      * @param packet pointer to the incoming packet
      * @param packetLen length of the incoming packet in bytes
      * 
-     * @exception <packet is too small>
-     * @exception <protocol version not supported>
+     * @retval psTransmitFailed -> reply could not be transmitted
+     */
+    virtual packetStatus handleArtPoll(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artAddress packets, the packet is applied as one transaction: the new
+     * names, net, sub-net and Port-Addresses of the bound page are staged and written together with the
+     * acnPriority and the command, followed by a single portsChanged() and one change reply to the sender. the Linux transport
+     * handles ArtAddress while all receive threads wait, so no packet sees a partly applied configuration
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psInvalidContent -> bind index of a page the device does not have, nothing applied
+     * @retval psTransmitFailed -> change reply could not be transmitted
      */
-    void handleArtPoll(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+    packetStatus handleArtAddress(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief apply the command of an ArtAddress packet, handles the indicator commands. device types
+     * extend it by the commands of their ports, unsupported commands are ignored
+     *
+     * @param command one of artAddressCommands
+     * @param page page of 4 ports the packet is bound to
+     */
+    virtual void applyAddressCommand(uint8_t command, uint16_t page);
+
+    /**
+     * @brief called after the Port-Addresses or directions of the ports were changed by ArtAddress,
+     * device types rebuild their lookup structures here
+     */
+    virtual void portsChanged();
+
+    /**
+     * @brief apply the acnPriority of an ArtAddress packet, device types converting to sACN override it
+     *
+     * @param priority sACN priority, valid range 0:200
+     * @param page page of 4 ports the packet is bound to
+     */
+    virtual void applyAcnPriority(uint8_t priority, uint16_t page);
+
+    /**
+     * @brief request the poll reply announcing a change, may be called from any receive thread. requests
+     * until the next service() are merged into one reply which is broadcast if they came for different targets
+     *
+     * @param targetIp receiver of the reply
+     */
+    void requestChangeReply(const uint8_t *targetIp);
+
+    /**
+     * @brief open the change reply window for the requests merged since the last call, or widen the
+     * receiver of the open window. only called by service()
+     *
+     * @param target ip of the receivers as merged by requestChangeReply()
+     * @retval false -> window 0 and the reply could not be transmitted
+     */
+    bool scheduleChangeReply(uint32_t target);
+
+    /**
+     * @brief function to handle artDataRequest packets, cached requests are answered with a single send,
+     * manufacturer specific requests are passed to the data request callback. requests for another OEM
+     * code (other than 0xffff) and unknown requests are not answered
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psTransmitFailed -> reply could not be transmitted
+     */
+    packetStatus handleArtDataRequest(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief get the URL of the configuration answering a data request
+     *
+     * @return URL, nullptr for drPoll and requests without URL
+     */
+    uint8_t *dataRequestUrl(uint16_t request);
+
+    /**
+     * @brief encode the cached ArtDataReply of a request from the configuration
+     *
+     * @param request drPoll or one of the URL requests
+     */
+    void buildDataReply(uint16_t request);
 
     /**
      * @brief function to handle artProg packets, does not support reprogramming of port
@@ -533,19 +1049,166 @@ private:
      * @param packet pointer to the incoming packet
      * @param packetLen length of the incoming packet in bytes
      * 
-     * @exception <packet is too small>
-     * @exception <protocol version not supported>
+     * @retval psTransmitFailed -> reply could not be transmitted
      */
-    void handleArtProg(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+    packetStatus handleArtProg(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artPollReply packets, only used by controllers
+     * 
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     * 
+     * @retval psUnsupportedOpCode -> device type does not handle replies
+     */
+    virtual packetStatus handleArtPollReply(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artDmx packets, only used by nodes
+     * 
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     * 
+     * @retval psUnsupportedOpCode -> device type does not output dmx
+     */
+    virtual packetStatus handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artSync packets, only used by nodes
+     * 
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     * 
+     * @retval psUnsupportedOpCode -> device type does not output dmx
+     */
+    virtual packetStatus handleArtSync(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artNzs packets (including VLC), only used by nodes
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psUnsupportedOpCode -> device type does not output dmx
+     */
+    virtual packetStatus handleArtNzs(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artTodData packets, only used by controllers
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psUnsupportedOpCode -> device type does not keep a table of devices
+     */
+    virtual packetStatus handleArtTodData(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artRdm packets
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psUnsupportedOpCode -> device type does not support RDM
+     */
+    virtual packetStatus handleArtRdm(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief function to handle artTimeCode packets received without a timestamp of the transport
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psInvalidContent -> type or timecode out of range
+     */
+    packetStatus handleArtTimeCode(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief handle an artTimeCode packet, discipline the clock if it belongs to the followed stream
+     *
+     * @param packet pointer to the incoming packet, at least artTimeCodePacketLen bytes
+     * @param receivedAt local time the packet was received in microseconds
+     *
+     * @retval psInvalidContent -> type or timecode out of range
+     */
+    packetStatus receiveTimeCode(const uint8_t *packet, uint64_t receivedAt);
+
+    /**
+     * @brief function to handle artTimeSync packets
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psUnsupportedOpCode -> no time sync callback set
+     */
+    packetStatus handleArtTimeSync(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief move the clock towards a received timecode with an alpha-beta filter (timeCodePhaseGain,
+     * timeCodeRateGain), errors beyond timeCodeRelockFrames set the clock directly
+     *
+     * @param tc received timecode
+     * @param receivedAt local time the packet was received in microseconds
+     */
+    void disciplineClock(const timeCode &tc, uint64_t receivedAt);
+
+    /**
+     * @brief consistent copy of the timecode clock, safe while timecode is received on another thread
+     */
+    void readClock(timeCodeClock &clock) const;
+
+    /**
+     * @brief extrapolate the timecode of a clock to a local time
+     *
+     * @return timecode in microseconds since 00:00:00:00, wrapped at midnight
+     */
+    static int64_t predictClock(const timeCodeClock &clock, uint64_t now);
+
+    /**
+     * @brief wrap a difference of two timecodes into half a day around 0
+     */
+    static int64_t wrapTimeCodeDiff(int64_t difference, uint8_t type);
+
     /**
      * @brief function to transmit an ArtNetPollReply packet
      * 
      * @param targetIp the IPv4 of the controller to respond to
      * @param targetIpLen number of bytes in the controller IP
      * 
-     * @exception <failed to transmit packet> -> udp transmission callback returned an error
+     * @retval true -> packet transmitted
+     * @retval false -> udp transmission callback returned an error
+     */
+    bool sendArtPollReply(uint8_t *targetIp, uint8_t targetIpLen);
+
+    /**
+     * @brief build the cached poll reply of a page from the configuration
+     * 
+     * @param page page of 4 ports, transmitted with bind index page + 1
+     */
+    void buildPollReply(uint16_t page);
+
+    /**
+     * @brief set the storage of the ports, has to be called by device types with ports before use
+     * 
+     * @param portStorage array of port configurations
+     * @param portCount number of ports
+     * @param replyStorage array of one poll reply per page of 4 ports
+     */
+    void setPortStorage(portConfig *portStorage, uint16_t portCount, ArtPollReplyPacket *replyStorage);
+
+    /**
+     * @brief rebuild the cached poll reply before it is sent next, has to be called whenever
+     * a field of the poll reply changes
+     */
+    void markPollReplyDirty();
+
+    /**
+     * @brief function to fill the port status of a poll reply, implemented by device types with ports
+     * 
+     * @param reply poll reply to update
+     * @param page page of 4 ports the reply belongs to
      */
-    void sendArtPollReply(uint8_t *targetIp, uint8_t targetIpLen);
+    virtual void updatePortStatus(ArtPollReplyPacket &reply, uint16_t page);
 
     /**
      * @brief function to transmit an artIpProgReplyPacket
@@ -567,17 +1230,34 @@ private:
 
     bool (*callback_readNetSwitch)(void) = nullptr;
     bool (*callback_unicast)(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort) = nullptr;
-    bool (*callback_updateIpAddress)(uint8_t *address, uint8_t addressLen);
-    bool (*callback_updateSubNetMask)(uint8_t *mask, uint8_t maskLen);
-    bool (*callback_updateGateWay)(uint8_t *gateWay, uint8_t gateWayLen);
-    void (*callback_getNetworkConf)(uint8_t *adr, uint8_t *mask, uint8_t *gateWay, uint8_t bufLen);
+    int32_t (*callback_dataRequest)(uint16_t request, uint8_t *payload, uint16_t maxPayloadLen) = nullptr;
+    bool (*callback_updateIpAddress)(uint8_t *address, uint8_t addressLen) = nullptr;
+    bool (*callback_updateSubNetMask)(uint8_t *mask, uint8_t maskLen) = nullptr;
+    bool (*callback_updateGateWay)(uint8_t *gateWay, uint8_t gateWayLen) = nullptr;
+    void (*callback_getNetworkConf)(uint8_t *adr, uint8_t *mask, uint8_t *gateWay, uint8_t bufLen) = nullptr;
+    uint64_t (*callback_getMicros)(void) = nullptr;
+    uint16_t (*callback_sendBatch)(const txPacket *packets, uint16_t packetCount) = nullptr;
+    void (*callback_timeCode)(const timeCode &tc, uint64_t receivedAt) = nullptr;
+    void (*callback_timeSync)(const wallClock &clock, uint64_t receivedAt) = nullptr;
+    void (*callback_capture)(const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen, uint16_t port) = nullptr;
 
 public:
     //constructors
     ArtNet(ArtNet &other) = delete;
     ArtNet(ArtNet &&other) = delete;
+
+    /**
+     * @brief create the device
+     *
+     * @param oemCode oem code reported in the poll replies
+     * @param MAC mac address of the device
+     * @param MACLen number of bytes in MAC
+     *
+     * @exception <invalid MAC> MAC too short, with ARTNET_NO_EXCEPTIONS the missing bytes are zero
+     * and rcConfigErr is counted instead
+     */
     ArtNet(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen);
-    ~ArtNet();
+    virtual ~ArtNet();
 
     /**
      * @brief function to update the ip of the device
@@ -585,18 +1265,249 @@ public:
      * @param newAddress new ip address
      * @param newAdressLen number of bytes in the new address
      * 
-     * @exception <new address too short> new address too short, address not updated
+     * @exception <new address too short> new address too short, address not updated, with
+     * ARTNET_NO_EXCEPTIONS rcConfigErr is counted instead
      */
     void updateIp(uint8_t *newAddress, uint8_t newAdressLen);
 
     /**
-     * @brief function to handle packets, has to implemented by device type classes
+     * @brief function to set the net and sub-net part of the Port-Address of all ports,
+     * keeps the universe of every port
+     * @param netSwitch net of the device, valid range 0:127
+     * @param subSwitch sub-net of the device, valid range 0:15
+     */
+    virtual void setNetSubSwitch(uint8_t netSwitch, uint8_t subSwitch);
+
+    /**
+     * @brief set the monotonic time source used for all timeouts
+     * 
+     * @param callback function returning the time in microseconds
+     */
+    void setTimeCallback(uint64_t (*callback)(void));
+
+    /**
+     * @brief set the function used to transmit single unicast packets
+     * 
+     * @param callback function to transmit a packet, returns true on success
+     */
+    void setUnicastCallback(bool (*callback)(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort));
+
+    /**
+     * @brief set the function called with every packet at the entry of handlePacket, before any check,
+     * e.g. ArtNetCapture::record. called on the receive threads
+     *
+     * @param callback function receiving the packet, nullptr -> no capture
+     */
+    void setCaptureCallback(void (*callback)(const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen,
+        uint16_t port));
+
+    /**
+     * @brief set the function used to transmit a batch of packets with a single system call
+     * 
+     * @param callback function to transmit the packets, returns the number of transmitted packets
+     */
+    void setBatchCallback(uint16_t (*callback)(const txPacket *packets, uint16_t packetCount));
+
+    /**
+     * @brief delay poll replies by a random time to spread the replies of many nodes,
+     * requires the time callback, the delayed replies are sent by serviceReceive()
+     * 
+     * @param maxDelay maximum delay in milliseconds, 0 -> reply immediately
+     */
+    void setReplyJitter(uint16_t maxDelay);
+
+    /**
+     * @brief merge the poll replies announcing a change (ArtAddress or, if a controller asked for it,
+     * any change of the poll reply) into one reply per window, requires the time callback and
+     * periodic calls of service(). changes outside of ArtAddress are always sent from service()
+     *
+     * @param window length of the window in milliseconds, 0 -> one reply per change
+     */
+    void setChangeReplyWindow(uint16_t window);
+
+    /**
+     * @brief get the current time from the time callback, transports use it to timestamp packets on arrival
+     * 
+     * @return time in microseconds, 0 if no time callback is set
+     */
+    uint64_t getMicros() const {
+        return callback_getMicros != nullptr ? callback_getMicros() : 0;
+    }
+
+    /**
+     * @brief handle all time based tasks, has to be called periodically (e.g. every millisecond)
+     */
+    virtual void service();
+
+    /**
+     * @brief handle the time based tasks which share state with the packet handlers (e.g. leaving
+     * sync mode, sending delayed poll replies), has to run where no packet is handled at the same time.
+     * called by service() unless a transport with parallel receive threads took it over with
+     * setReceiveServiceExternal()
+     */
+    virtual void serviceReceive();
+
+    /**
+     * @brief let a transport call serviceReceive() while its receive threads wait, service() skips it then
+     *
+     * @param external true -> serviceReceive() is called by the transport
+     */
+    void setReceiveServiceExternal(bool external);
+
+    /**
+     * @brief function to handle packets, checks the header once and dispatches by opCode,
+     * malformed packets are counted and never throw
      * 
      * @param packet        pointer to the incoming packet
      * @param packetLen     length of the incomin packet
      * @param senderIp      pointer to the ip of the sender
      * @param senderIpLen   number of bytes in the ip of the sender
      * @param port          port the packet was received on
+     * @param receivedAt    local time the transport received the packet (getMicros), 0 -> taken by the handler,
+     *                      only used for scopeTime packets
+     * @return result of the packet handling
+     */
+    virtual packetStatus handlePacket(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen, uint16_t port,
+        uint64_t receivedAt = 0);
+
+    /**
+     * @brief find out which part of the device a packet acts on without handling it,
+     * packets of one universe have to be handled in order, packets of different universes
+     * may be handled in parallel
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet
+     * @param portAddress Port-Address of the packet, only set for scopeUniverse
+     * @return scope of the packet
+     */
+    static packetScope classifyPacket(const uint8_t *packet, uint16_t packetLen, uint16_t &portAddress);
+
+    /**
+     * @brief get the counters of all handled packets
+     */
+    const packetCounters &getPacketCounters() const {
+        return counters;
+    }
+
+    /**
+     * @brief copy all packet counters, safe to call while packets are handled on other threads
+     *
+     * @param snapshot destination of the counters
+     */
+    void getMetrics(metricsSnapshot &snapshot) const;
+
+    /**
+     * @brief count a failure detected outside of the device, e.g. by the transport
+     *
+     * @param code node report code of the failure
+     */
+    void reportFailure(nodeReportCodes code);
+
+    /**
+     * @brief transmit an ArtDiagData message, only sent if the last ArtPoll asked for diagnostics
+     * at or below the priority, unicast or broadcast as requested by the controller
+     *
+     * @param priority priority of the message, diagPriorities
+     * @param logicalPort port the message relates to, 0 -> whole device
+     * @param text null terminated message, truncated to 511 characters
+     * @retval true -> message transmitted
+     * @retval false -> not requested or transmission failed
+     */
+    bool sendDiagData(uint8_t priority, uint8_t logicalPort, const char *text);
+
+    /**
+     * @brief transmit an ArtTimeCode packet
+     *
+     * @param tc timecode to transmit
+     * @param targetIp ip of the receiver, nullptr -> broadcast
+     * @param targetIpLen number of bytes in targetIp
+     * @retval true -> packet transmitted
+     * @retval false -> no unicast callback or transmission failed
+     */
+    bool sendTimeCode(const timeCode &tc, uint8_t *targetIp = nullptr, uint8_t targetIpLen = 0);
+
+    /**
+     * @brief set the URL answering a data request, the reply is encoded here and sent unchanged afterwards
+     *
+     * @param request one of drUrlProduct, drUrlUserGuide, drUrlSupport, drUrlPersUdr, drUrlPersGdtf
+     * @param url null terminated URL, cut to maxUrlLen - 1 characters
+     * @retval true -> URL set
+     * @retval false -> request has no URL
+     */
+    bool setUrl(uint16_t request, const char *url);
+
+    /**
+     * @brief set the function answering manufacturer specific data requests (drStartManSpec and above)
+     *
+     * @param callback function writing the payload of the reply for a request, returns the payload length
+     * or a negative value if the request is not supported (no reply is sent)
+     */
+    void setDataRequestCallback(int32_t (*callback)(uint16_t request, uint8_t *payload, uint16_t maxPayloadLen));
+
+    /**
+     * @brief set the function called for every valid ArtTimeCode, called on the receive thread
+     *
+     * @param callback function receiving the timecode and the local time it was received
+     */
+    void setTimeCodeCallback(void (*callback)(const timeCode &tc, uint64_t receivedAt));
+
+    /**
+     * @brief set the function called for every ArtTimeSync, ArtTimeSync is ignored without it
+     *
+     * @param callback function receiving the date and time and the local time it was received
+     */
+    void setTimeSyncCallback(void (*callback)(const wallClock &clock, uint64_t receivedAt));
+
+    /**
+     * @brief select the timecode stream the clock follows
+     *
+     * @param streamId stream of the ArtTimeCode packets, 0 -> master
+     * @param holdTime the clock is extrapolated for up to this time in milliseconds after the last packet
+     */
+    void setTimeCodeSource(uint8_t streamId, uint16_t holdTime);
+
+    /**
+     * @brief read the disciplined timecode clock, between packets and during a drop-out of up to the hold
+     * time the timecode is extrapolated with the measured rate of the source. requires the time callback
+     *
+     * @param tc current timecode
+     * @param frameOffset time since the start of the current frame in microseconds
+     * @retval true -> clock locked to the source
+     * @retval false -> no timecode within the hold time, tc is not changed
+     */
+    bool getTimeCode(timeCode &tc, uint32_t &frameOffset) const;
+
+    /**
+     * @brief copy the statistics of the timecode clock, safe while timecode is received on another thread
+     *
+     * @param stats destination of the statistics
+     */
+    void getTimeCodeStats(timeCodeStats &stats) const;
+
+    /**
+     * @brief number of frames since 00:00:00:00, drop frame timecode skips the labels 0 and 1 of every
+     * minute except every tenth
+     */
+    static uint32_t timeCodeToFrames(const timeCode &tc);
+
+    /**
+     * @brief timecode of a frame number, inverse of timeCodeToFrames
+     *
+     * @param frames frames since 00:00:00:00, wrapped at midnight
+     * @param type timeCodeTypes
+     * @param tc destination, the streamId is not changed
+     */
+    static void framesToTimeCode(uint32_t frames, uint8_t type, timeCode &tc);
+
+    /**
+     * @brief number of frames of a day
+     */
+    static uint32_t timeCodeFramesPerDay(uint8_t type);
+
+    /**
+     * @brief start of a frame in microseconds since 00:00:00:00, exact to 1 microsecond for every type
      */
-    void virtual handlePacket(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen, uint16_t port);
+    static int64_t timeCodeFramesToMicros(uint64_t frames, uint8_t type) {
+        return static_cast<int64_t>(frames * timeCodePeriodMicros[type] / timeCodePeriodFrames[type]);
+    }
 };
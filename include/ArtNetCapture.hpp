@@ -0,0 +1,191 @@
+/**
+ * @file ArtNetCapture.hpp
+ * @author your name (you@domain.com)
+ * @brief capture of received packets into a memory mapped file and time accurate replay into a device,
+ * works without network when the device transmits through ArtNetFakeTransport
+ * @version 0.1
+ * @date 2026-01-20
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <ArtNetWire.hpp>
+#include <stdint.h>
+#include <atomic>
+
+
+/**
+ * @brief recorder of received packets, all functions are static so record() can be installed as
+ * capture callback of a device. the file is little endian:
+ *
+ * file header (32 bytes)   magic "ArtCap", version, start time, record bytes, record count
+ * record (16 bytes + data) timestamp in ns since open, length, port, sender ip, data padded to 8 bytes
+ */
+class ArtNetCapture {
+public:
+    static constexpr uint16_t fileVersion = 1;
+    static constexpr uint8_t magicLen = 6;
+    static constexpr uint8_t magic[magicLen] = {'A', 'r', 't', 'C', 'a', 'p'};
+    static constexpr uint8_t fileHeaderLen = 32;
+    static constexpr uint8_t recordHeaderLen = 16;
+    static constexpr uint8_t recordAlign = 8;
+
+    struct fileHeaderLayout {
+        static constexpr uint16_t length = fileHeaderLen;
+        typedef wireBytes<0, magicLen> magic;
+        typedef wireField<6, 2, woLittleEndian> version;
+        typedef wireField<8, 4, woLittleEndian> startTimeLow;        //CLOCK_REALTIME at open in ns, for reference
+        typedef wireField<12, 4, woLittleEndian> startTimeHigh;
+        typedef wireField<16, 4, woLittleEndian> recordBytesLow;     //bytes of records following the header
+        typedef wireField<20, 4, woLittleEndian> recordBytesHigh;
+        typedef wireField<24, 4, woLittleEndian> recordCount;
+        typedef wireBytes<28, 4> reserved;
+    };
+    static_assert(fileHeaderLayout::reserved::end == fileHeaderLen, "fileHeaderLayout does not match fileHeaderLen");
+
+    struct recordLayout {
+        static constexpr uint16_t length = recordHeaderLen;
+        typedef wireField<0, 4, woLittleEndian> timestampLow;
+        typedef wireField<4, 4, woLittleEndian> timestampHigh;
+        typedef wireField<8, 2, woLittleEndian> packetLen;
+        typedef wireField<10, 2, woLittleEndian> port;
+        typedef wireBytes<12, 4> senderIp;
+    };
+    static_assert(recordLayout::senderIp::end == recordHeaderLen, "recordLayout does not match recordHeaderLen");
+
+    /**
+     * @brief counters of the recorder
+     */
+    struct captureCounters {
+        uint32_t recorded;
+        uint32_t dropped;       //file full
+        uint64_t bytes;         //record bytes in the file
+    };
+
+    /**
+     * @brief size of a record in the file
+     */
+    static constexpr uint32_t recordSize(uint16_t packetLen) {
+        return (recordHeaderLen + packetLen + recordAlign - 1) & ~static_cast<uint32_t>(recordAlign - 1);
+    }
+
+private:
+    static std::atomic<uint8_t*> file;     //stored last by open(), record() only runs once it is set
+    static uint64_t capacity;
+    static uint64_t startTime;
+    static int fileFd;
+    static std::atomic<uint64_t> writeOffset;
+    static std::atomic<uint32_t> recorded;
+    static std::atomic<uint32_t> dropped;
+
+public:
+    /**
+     * @brief create the capture file and map it, an open capture is closed first
+     *
+     * @param path path of the file, truncated if it exists
+     * @param maxSize size of the mapping in bytes, packets beyond it are dropped and counted
+     * @retval true -> file ready for recording
+     * @retval false -> file could not be created or mapped
+     */
+    static bool open(const char *path, uint64_t maxSize);
+
+    /**
+     * @brief finish the header, unmap the file and cut it to the recorded size. has to be called
+     * after the receive threads stopped calling record()
+     */
+    static void close();
+
+    /**
+     * @brief record a packet with the current CLOCK_MONOTONIC time, usable as capture callback and safe
+     * to call from several receive threads at once
+     */
+    static void record(const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen, uint16_t port);
+
+    /**
+     * @brief record a packet with a given timestamp, e.g. to build a capture from generated traffic
+     *
+     * @param timestamp time since the start of the capture in nanoseconds
+     * @retval true -> packet recorded
+     * @retval false -> no capture open or file full
+     */
+    static bool append(uint64_t timestamp, const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen,
+        uint16_t port);
+
+    /**
+     * @brief get the counters of the open or last capture
+     */
+    static captureCounters getCounters();
+};
+
+/**
+ * @brief replay of a capture file into a device, the packets are handed to handlePacket in file order
+ */
+class ArtNetReplay {
+public:
+    /**
+     * @brief result of one replay
+     */
+    struct replayStats {
+        uint32_t packets;
+        uint64_t bytes;
+        uint32_t byStatus[ArtNet::psCount];
+        uint64_t elapsed;           //nanoseconds
+        uint64_t maxLateness;       //nanoseconds a packet was handed over after its due time
+        uint64_t totalLateness;
+    };
+
+private:
+    static constexpr uint64_t spinTime = 200000;   //nanoseconds before a packet is due the replay stops sleeping
+
+    uint8_t *file = nullptr;
+    uint64_t fileSize = 0;
+    uint64_t recordBytes = 0;
+    uint32_t recordCount = 0;
+
+public:
+    ArtNetReplay() = default;
+    ArtNetReplay(ArtNetReplay &other) = delete;
+    ArtNetReplay(ArtNetReplay &&other) = delete;
+    ~ArtNetReplay();
+
+    /**
+     * @brief map a capture file read only, a mapped file is closed first
+     *
+     * @retval true -> valid capture file
+     * @retval false -> file missing, not a capture or of an unsupported version
+     */
+    bool open(const char *path);
+
+    /**
+     * @brief unmap the capture file
+     */
+    void close();
+
+    /**
+     * @brief get the number of packets in the capture
+     */
+    uint32_t getRecordCount() const {
+        return recordCount;
+    }
+
+    /**
+     * @brief get the time between the first and the last packet in nanoseconds
+     */
+    uint64_t getDuration() const;
+
+    /**
+     * @brief feed the capture into a device, the device transmits through its callbacks
+     * (e.g. ArtNetFakeTransport to run without network)
+     *
+     * @param device device handling the packets
+     * @param speed replay speed in percent of the original, 100 -> original timing, 1000 -> 10 times
+     * faster, 0 -> as fast as possible
+     * @param stats result of the replay
+     * @retval true -> all records replayed
+     * @retval false -> no file mapped or a record is damaged, stats hold the records before it
+     */
+    bool run(ArtNet &device, uint32_t speed, replayStats &stats);
+};
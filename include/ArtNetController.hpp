@@ -8,26 +8,661 @@
  * @copyright Copyright (c) 2025
  * 
  */
+#pragma once
+
 #include <ArtNet.hpp>
+#include <atomic>
+
+
+
+class ArtNetController : public ArtNet{
+public:
+    static constexpr uint8_t cacheLineLen = 64;
+    static constexpr uint8_t maxSubscribers = 8;
+
+    /**
+     * @brief transmit state of one universe, holds the complete ArtDmx packet as sent on the wire
+     */
+    struct alignas(cacheLineLen) txUniverse {
+        uint8_t packet[artDmxHeaderLen + maxDmxSlots];
+        uint8_t targetIp[ipAddressLen];
+        uint16_t portAddress;
+        uint16_t length;
+        bool active;
+        bool changed;
+        std::atomic<uint32_t> minInterval;  //microseconds, derived from the refresh rate of the receiving node
+        uint64_t lastSent;                  //microseconds
+
+        //nodes outputting this universe, written by discovery and read lock-free by the sender
+        std::atomic<uint32_t> subscriberSequence;
+        std::atomic<uint8_t> subscriberCount;
+        std::atomic<uint16_t> subscriberOverflow;
+        std::atomic<uint32_t> subscriberIps[maxSubscribers];
+        uint8_t subscriberRefs[maxSubscribers];     //outputs of the ip on this universe (pages and ports), owned by the writer
+    };
+
+    /**
+     * @brief node found through its ArtPollReply, identified by its ip and bind index
+     */
+    struct discoveredNode {
+        uint8_t ip[ipAddressLen];
+        uint8_t bindIndex;
+        uint8_t state;
+        uint16_t outputAddresses[4];
+        uint8_t outputCount;
+        uint16_t refreshRate;
+        uint64_t lastSeen;      //microseconds
+    };
+
+    /**
+     * @brief entry of the table of devices, the entries are sorted by Port-Address and UID so the
+     * UIDs of one Port-Address form one sorted array
+     */
+    struct todEntry {
+        uint64_t key;                       //Port-Address << 48 | UID
+        uint8_t nodeIp[ipAddressLen];       //node the responder is connected to
+        uint8_t bindIndex;
+        uint8_t generation;                 //full table the entry was last reported in
+    };
+
+    /**
+     * @brief result of a queued RDM request
+     */
+    enum rdmResults {
+        rrResponse  = 0,
+        rrTimeout   = 1,
+    };
+
+    /**
+     * @brief counters of the dmx transmission
+     */
+    struct txCounters {
+        uint32_t sent;
+        uint32_t sentChanged;
+        uint32_t sentKeepAlive;
+        uint32_t savedUnchanged;
+        uint32_t savedRateLimit;
+    };
+
+    /**
+     * @brief counters of the timecode generator, lateness is the time between the due time of a frame
+     * and its transmission in microseconds
+     */
+    struct timeCodeGeneratorStats {
+        uint32_t sent;
+        uint32_t skipped;           //frames not sent because the generator was serviced too late
+        uint32_t lateness;          //smoothed
+        uint32_t maxLateness;
+    };
+
+private:
+    static constexpr uint16_t dmxKeepAliveTime = 1000; //milliseconds
+    static constexpr uint8_t nodeTimeOut = 2 * artPollTimeOut; //seconds
+    static constexpr uint16_t noUniverse = 0xffff;
+
+    /**
+     * @brief states of a slot in the node table
+     */
+    enum nodeStates {
+        nsEmpty     = 0,
+        nsUsed      = 1,
+        nsDeleted   = 2,
+    };
+
+    /**
+     * @brief slot of the Port-Address lookup table
+     */
+    struct universeMapEntry {
+        uint16_t portAddress;
+        uint16_t universeIdx;
+    };
+
+    /**
+     * @brief size of the Port-Address lookup table, a power of two with at most 50% load
+     */
+    static constexpr uint16_t universeMapSize(uint16_t universeCount) {
+        uint16_t _size = 8;
+        while (_size < 2 * universeCount) {
+            _size *= 2;
+        }
+        return _size;
+    }
+
+    /**
+     * @brief states of a slot in the RDM request pool
+     */
+    enum rdmRequestStates {
+        rsFree      = 0,
+        rsQueued    = 1,
+        rsInFlight  = 2,
+    };
+
+    /**
+     * @brief RDM request, holds the complete ArtRdm packet so retries are sent without rebuilding it
+     */
+    struct rdmRequest {
+        uint8_t packet[artRdmHeaderLen + maxRdmPacketLen];
+        uint16_t packetLen;
+        uint8_t nodeIp[ipAddressLen];
+        uint8_t state;
+        uint8_t retries;
+        uint64_t sentAt;                    //microseconds
+    };
+
+    static constexpr uint8_t maxTodAssemblies = 8;
+
+    /**
+     * @brief full table of devices of one node and Port-Address being received in blocks
+     */
+    struct todAssembly {
+        uint8_t nodeIp[ipAddressLen];
+        uint16_t portAddress;
+        uint16_t received;
+        uint16_t total;
+        uint8_t bindIndex;
+        uint8_t generation;
+        bool active;
+    };
+
+    /**
+     * @brief pipelining of the RDM requests
+     */
+    struct rdmPipelineConfig {
+        uint8_t window;                     //requests in flight per node
+        uint16_t timeOut;                   //milliseconds
+        uint8_t retries;
+    };
+
+public:
+    /**
+     * @brief statically sized storage of a controller, everything the controller needs besides the
+     * object itself, no memory is allocated after construction
+     *
+     * @tparam universeCount number of transmitted universes, valid range 1:16384
+     * @tparam nodeSlots number of slots of the discovery table, should be about twice the expected number of nodes
+     * @tparam batchLen number of packets handed to the batch callback at once
+     */
+    template <uint16_t universeCount, uint16_t nodeSlots, uint16_t batchLen = 256>
+    struct controllerStorage {
+        static_assert(universeCount > 0 && universeCount <= 0x4000, "a controller supports up to 16384 universes");
+        static_assert(nodeSlots > 0, "the discovery table needs at least one slot");
+        static_assert(batchLen > 0, "the transmit batch needs at least one packet");
+
+        txUniverse universes[universeCount];
+        universeMapEntry universeMap[universeMapSize(universeCount)];
+        discoveredNode nodes[nodeSlots];
+        txPacket batch[batchLen];
+        uint8_t batchIps[batchLen][ipAddressLen];
+    };
 
+    /**
+     * @brief statically sized storage of the table of devices and the RDM request pool
+     *
+     * @tparam uidCount number of responders over all Port-Addresses
+     * @tparam requestSlots number of RDM requests queued or in flight at once
+     */
+    template <uint16_t uidCount, uint16_t requestSlots = 64>
+    struct rdmStorage {
+        static_assert(uidCount > 0, "the table of devices needs at least one entry");
+        static_assert(requestSlots > 0, "the RDM engine needs at least one request slot");
 
+        todEntry tod[uidCount];
+        rdmRequest requests[requestSlots];
+    };
 
-class ArtNetController : private ArtNet{
 private:
-    
+    txUniverse *universes;
+    uint16_t universeCount = 0;
+    uint16_t universeTableSize;
+    bool deltaMode = false;
+    txCounters transmitCounters = {};
+
+    //Port-Address -> index in the universe table
+    universeMapEntry *universeMap;
+    uint16_t universeMapMask;
+
+    discoveredNode *nodes;
+    uint16_t nodeTableSize;
+    uint16_t nodeCount = 0;
+    bool unicastMode = false;
+
+    //the node table, the universe map and the subscriber seqlocks have one writer at a time, ArtPollReply
+    //on the receive thread and expireNodes() / addUniverse() on the application thread take this lock
+    std::atomic_flag discoveryLock = ATOMIC_FLAG_INIT;
+
+    txPacket *txBatch;
+    uint8_t (*txBatchIps)[ipAddressLen];
+    uint16_t maxBatchLen;
+
+    //table of devices, sorted by key
+    todEntry *tod;
+    uint16_t todCapacity;
+    uint16_t todCount = 0;
+    uint8_t todGeneration = 0;
+    todAssembly todAssemblies[maxTodAssemblies] = {};
+
+    rdmRequest *rdmRequests;
+    uint16_t rdmRequestSlots;
+    uint16_t rdmNextSlot = 0;
+    uint8_t rdmTransaction = 0;
+    rdmPipelineConfig rdmPipeline = {4, 200, 2};
+
+    /**
+     * @brief timecode generator, frame n is due at startTime + n frame periods so the rate never drifts
+     */
+    struct timeCodeGenerator {
+        uint64_t startTime;         //microseconds
+        uint64_t frameIndex;        //frames since the start, the next frame to send
+        uint32_t startFrame;        //frames since 00:00:00:00 of the first frame
+        uint32_t latenessScaled;    //lateness * 16
+        uint8_t type;
+        uint8_t streamId;
+        bool running;
+        timeCodeGeneratorStats stats;
+    };
+
+    timeCodeGenerator timeCodeOut = {};
+
+    void (*callback_rdmResult)(uint16_t requestIdx, rdmResults result, const uint8_t *rdmPacket, uint16_t rdmPacketLen) = nullptr;
+    void (*callback_todChanged)(uint16_t portAddress) = nullptr;
+
+    /**
+     * @brief create a controller on caller owned storage, used by the storage constructors
+     */
+    ArtNetController(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, txUniverse *universeTable, uint16_t universeTableLen,
+        universeMapEntry *universeMapStorage, uint16_t mapSize, discoveredNode *nodeTable, uint16_t nodeTableLen,
+        txPacket *batch, uint8_t (*batchIps)[ipAddressLen], uint16_t batchLen,
+        todEntry *todStorage, uint16_t todLen, rdmRequest *requestStorage, uint16_t requestLen);
+
+    /**
+     * @brief find a universe by its Port-Address
+     *
+     * @param portAddress 15 bit Port-Address
+     * @return index in the universe table, noUniverse if the Port-Address is not transmitted
+     */
+    uint16_t findUniverse(uint16_t portAddress) const;
+
     /**
      * @brief function to handle incoming artPollReplyPacket
-     * 
+     *
      * @param packet pointer to the incoming packet
      * @param packetLen length of the incoming packet in bytes
      */
-    void handleArtPollReply(void *packet, uint16_t packetLen);
+    packetStatus handleArtPollReply(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
 
-    bool (*callback_broadcast)(uint8_t *packet, uint8_t packetLen, uint16_t port);
+    /**
+     * @brief transmit the collected batch, falls back to single unicasts if no batch callback is set
+     *
+     * @param packetCount number of packets in txBatch
+     * @return number of transmitted packets
+     */
+    uint16_t flushBatch(uint16_t packetCount);
+
+    /**
+     * @brief add the packet of a universe to the transmit batch, flushes the batch once it is full
+     *
+     * @param universe universe to transmit
+     * @param targetIp ip to send the packet to, has to stay valid until the batch is flushed
+     * @param batchLen number of packets in the batch, updated
+     * @param sent number of transmitted packets, updated
+     */
+    void queuePacket(const txUniverse &universe, const uint8_t *targetIp, uint16_t &batchLen, uint16_t &sent);
+
+    /**
+     * @brief holds the discovery lock while in scope, the writers are short and rare so waiting spins
+     */
+    struct discoveryGuard {
+        std::atomic_flag &lock;
+
+        explicit discoveryGuard(std::atomic_flag &flag) : lock(flag) {
+            while (lock.test_and_set(std::memory_order_acquire)) {
+            }
+        }
+
+        ~discoveryGuard() {
+            lock.clear(std::memory_order_release);
+        }
+    };
+
+    /**
+     * @brief find the slot of a node in the node table
+     *
+     * @param ip ip of the node
+     * @param bindIndex bind index of the node
+     * @param insert true -> return a free slot if the node is unknown
+     * @return pointer to the slot, nullptr if not found or the table is full
+     */
+    discoveredNode *findNodeSlot(const uint8_t *ip, uint8_t bindIndex, bool insert);
+
+    /**
+     * @brief add or remove a node as subscriber of a universe
+     *
+     * @param portAddress Port-Address of the universe
+     * @param ip ip of the node
+     * @param subscribe true -> add, false -> remove
+     */
+    void updateSubscriber(uint16_t portAddress, const uint8_t *ip, bool subscribe);
+
+    /**
+     * @brief read the subscribers of a universe without locking
+     *
+     * @param universe universe to read the subscribers of
+     * @param ips buffer for maxSubscribers ips
+     * @return number of subscribers
+     */
+    uint8_t readSubscribers(const txUniverse &universe, uint32_t *ips) const;
+
+    bool (*callback_broadcast)(uint8_t *packet, uint16_t packetLen, uint16_t port) = nullptr;
+
+    /**
+     * @brief rebuild the refresh limit of a universe from the nodes subscribed to it
+     *
+     * @param universeIdx index of the universe
+     */
+    void updateRefreshLimit(uint16_t universeIdx);
+
+    /**
+     * @brief function to handle artTodData packets, every block is merged into the table of devices
+     * right away, once all blocks of a full table arrived the responders missing in it are removed
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psInvalidContent -> uid count does not fit the packet
+     */
+    packetStatus handleArtTodData(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief function to handle artRdm packets, responses complete the matching request in flight
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     */
+    packetStatus handleArtRdm(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief build the key of the table of devices
+     *
+     * @param portAddress 15 bit Port-Address
+     * @param uid UID as transmitted, 6 bytes with the manufacturer id first
+     */
+    static uint64_t todKey(uint16_t portAddress, const uint8_t *uid);
+
+    /**
+     * @brief find the first entry of the table of devices with a key not less than key
+     */
+    uint16_t lowerBoundTod(uint64_t key) const;
+
+    /**
+     * @brief get the table of devices entry of the responder which is currently assembled
+     *
+     * @param ip ip of the node
+     * @param portAddress Port-Address of the table
+     * @param bindIndex bind index of the node
+     * @param start true -> take a slot for a new full table
+     * @return the assembly, nullptr if not started
+     */
+    todAssembly *findTodAssembly(const uint8_t *ip, uint16_t portAddress, uint8_t bindIndex, bool start);
+
+    /**
+     * @brief add a responder or refresh its entry
+     *
+     * @retval true -> responder is new
+     */
+    bool updateTodEntry(uint64_t key, const uint8_t *ip, uint8_t bindIndex, uint8_t generation);
+
+    /**
+     * @brief remove the responders of a node which were not reported in its last full table
+     *
+     * @retval true -> at least one responder removed
+     */
+    bool removeStaleTodEntries(uint16_t portAddress, const uint8_t *ip, uint8_t bindIndex, uint8_t generation);
+
+    /**
+     * @brief count the RDM requests in flight to a node
+     */
+    uint8_t countRdmInFlight(const uint8_t *ip) const;
+
+    /**
+     * @brief send queued RDM requests in order while the window of their node has room
+     *
+     * @param ip only send requests to this node, nullptr -> all nodes
+     * @param now current time in microseconds
+     */
+    void pumpRdm(const uint8_t *ip, uint64_t now);
+
+    /**
+     * @brief (re)transmit a request and start its timeout
+     */
+    void sendRdmRequest(rdmRequest &request, uint64_t now);
 
 public:
-    ArtNetController();
-    ArtNetController(ArtNetController &other) = default;
-    ArtNetController(ArtNetController &&other) = default;
+    /**
+     * @brief create a controller with the universes, discovery table and transmit batch of a statically sized storage
+     *
+     * @param storage storage of the controller, has to outlive the controller
+     */
+    template <uint16_t universeCount, uint16_t nodeSlots, uint16_t batchLen>
+    ArtNetController(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, controllerStorage<universeCount, nodeSlots, batchLen> &storage)
+        : ArtNetController(oemCode, MAC, MACLen, storage.universes, universeCount, storage.universeMap, universeMapSize(universeCount),
+            storage.nodes, nodeSlots, storage.batch, storage.batchIps, batchLen, nullptr, 0, nullptr, 0) {
+    }
+
+    /**
+     * @brief create a controller with RDM support
+     *
+     * @param storage storage of the controller, has to outlive the controller
+     * @param rdm storage of the table of devices and the RDM requests, has to outlive the controller
+     */
+    template <uint16_t universeCount, uint16_t nodeSlots, uint16_t batchLen, uint16_t uidCount, uint16_t requestSlots>
+    ArtNetController(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, controllerStorage<universeCount, nodeSlots, batchLen> &storage,
+        rdmStorage<uidCount, requestSlots> &rdm)
+        : ArtNetController(oemCode, MAC, MACLen, storage.universes, universeCount, storage.universeMap, universeMapSize(universeCount),
+            storage.nodes, nodeSlots, storage.batch, storage.batchIps, batchLen, rdm.tod, uidCount, rdm.requests, requestSlots) {
+    }
+
+    ArtNetController(ArtNetController &other) = delete;
+    ArtNetController(ArtNetController &&other) = delete;
     ~ArtNetController();
+
+    /**
+     * @brief add a universe to the universe table and prebuild its ArtDmx header, nodes already
+     * discovered outputting the Port-Address become its subscribers
+     *
+     * @param portAddress 15 bit Port-Address of the universe
+     * @param targetIp ip to send the universe to
+     * @param targetIpLen number of bytes in the target ip
+     * @param universeIdx index of the new universe in the table
+     * @retval true -> universe added
+     * @retval false -> table is full or invalid parameters
+     */
+    bool addUniverse(uint16_t portAddress, uint8_t *targetIp, uint8_t targetIpLen, uint16_t &universeIdx);
+
+    /**
+     * @brief update the dmx data of a universe, the data goes out with the next refresh
+     *
+     * @param universeIdx index of the universe in the table
+     * @param dmxData new dmx data
+     * @param dmxDataSize number of channels, valid range 1:512
+     * @retval true -> data updated
+     * @retval false -> invalid universe or size
+     */
+    bool setUniverseData(uint16_t universeIdx, const uint8_t *dmxData, uint16_t dmxDataSize);
+
+    /**
+     * @brief transmit all universes of the table, has to be called once per refresh tick
+     *
+     * @return number of transmitted packets
+     */
+    uint16_t transmitDmx();
+
+    /**
+     * @brief only transmit universes whose data changed since they were last sent, unchanged
+     * universes are repeated once per keep-alive interval, requires the time callback
+     *
+     * @param enable true -> delta mode, false -> every universe is sent on every tick
+     */
+    void enableDeltaMode(bool enable);
+
+    /**
+     * @brief set the function used to broadcast packets
+     *
+     * @param callback function to broadcast a packet, returns true on success
+     */
+    void setBroadcastCallback(bool (*callback)(uint8_t *packet, uint16_t packetLen, uint16_t port));
+
+    /**
+     * @brief broadcast an ArtPoll to discover all nodes, has to be called every artPollTimeOut seconds
+     *
+     * @retval true -> poll transmitted
+     * @retval false -> no broadcast callback or transmission failed
+     */
+    bool sendArtPoll();
+
+    /**
+     * @brief remove all nodes which did not reply to the last two polls, may run on another thread than
+     * handlePacket()
+     *
+     * @return number of removed nodes
+     */
+    uint16_t expireNodes();
+
+    /**
+     * @brief unicast every universe to the nodes subscribed to it instead of its target ip,
+     * universes without or with too many subscribers still go to their target ip
+     *
+     * @param enable true -> unicast to subscribers
+     */
+    void enableUnicastMode(bool enable);
+
+    /**
+     * @brief find a node in the discovery table
+     *
+     * @param ip ip of the node
+     * @param bindIndex bind index of the node
+     * @return the node, nullptr if unknown
+     */
+    const discoveredNode *findNode(const uint8_t *ip, uint8_t bindIndex);
+
+    /**
+     * @brief get the number of nodes in the discovery table
+     */
+    uint16_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    /**
+     * @brief get the counters of the dmx transmission
+     */
+    const txCounters &getTxCounters() const {
+        return transmitCounters;
+    }
+
+    /**
+     * @brief broadcast an ArtTodRequest, the nodes answer with the full table of devices of the Port-Address
+     *
+     * @param portAddress 15 bit Port-Address
+     * @retval true -> request transmitted
+     * @retval false -> no broadcast callback or transmission failed
+     */
+    bool sendTodRequest(uint16_t portAddress);
+
+    /**
+     * @brief broadcast an ArtTodControl, e.g. tcFlush to start a full discovery
+     *
+     * @param portAddress 15 bit Port-Address
+     * @param command command of the packet
+     * @retval true -> command transmitted
+     * @retval false -> no broadcast callback or transmission failed
+     */
+    bool sendTodControl(uint16_t portAddress, todControlCommands command);
+
+    /**
+     * @brief set the function called after the table of devices of a Port-Address changed
+     */
+    void setTodCallback(void (*callback)(uint16_t portAddress));
+
+    /**
+     * @brief copy the UIDs of a Port-Address, sorted ascending
+     *
+     * @param portAddress 15 bit Port-Address
+     * @param uids buffer for the UIDs, manufacturer id in bits 47:32
+     * @param maxUids size of the buffer
+     * @return number of responders on the Port-Address, may exceed maxUids
+     */
+    uint16_t getTod(uint16_t portAddress, uint64_t *uids, uint16_t maxUids) const;
+
+    /**
+     * @brief get the number of responders over all Port-Addresses
+     */
+    uint16_t getTodSize() const {
+        return todCount;
+    }
+
+    /**
+     * @brief set the function called once a queued RDM request completed
+     *
+     * @param callback function called with the index of the request, the result and the response
+     * (without start code, nullptr on timeout), the response is only valid during the call
+     */
+    void setRdmCallback(void (*callback)(uint16_t requestIdx, rdmResults result, const uint8_t *rdmPacket, uint16_t rdmPacketLen));
+
+    /**
+     * @brief configure the pipelining of RDM requests, requires the time callback and periodic calls of service()
+     *
+     * @param window number of requests in flight per node, valid range 1:255
+     * @param timeOut time to wait for a response in milliseconds
+     * @param retries number of retransmissions before the request times out
+     */
+    void setRdmPipeline(uint8_t window, uint16_t timeOut, uint8_t retries);
+
+    /**
+     * @brief queue an RDM request to a responder of the table of devices, it is sent once the window
+     * of its node has room, the transaction number is assigned by the controller
+     *
+     * @param portAddress Port-Address the responder is connected to
+     * @param rdmPacket RDM message without start code, including the checksum
+     * @param rdmPacketLen number of bytes in rdmPacket
+     * @param requestIdx index of the request, passed to the rdm callback
+     * @retval true -> request queued
+     * @retval false -> invalid message, unknown responder (broadcasts have no route) or all slots in use
+     */
+    bool queueRdm(uint16_t portAddress, const uint8_t *rdmPacket, uint16_t rdmPacketLen, uint16_t &requestIdx);
+
+    /**
+     * @brief get the number of RDM requests queued or in flight
+     */
+    uint16_t getRdmPending() const;
+
+    /**
+     * @brief start broadcasting ArtTimeCode at the frame rate of the type, requires the time callback
+     *
+     * @param start first timecode, the type selects the frame rate
+     */
+    void startTimeCode(const timeCode &start);
+
+    /**
+     * @brief stop the timecode generator
+     */
+    void stopTimeCode();
+
+    /**
+     * @brief send the frame of the timecode generator that is due, also called by service(). for the
+     * lowest jitter call it again at the returned time, frames more than one period late are skipped
+     *
+     * @return time the next frame is due in microseconds, 0 -> generator stopped
+     */
+    uint64_t serviceTimeCode();
+
+    /**
+     * @brief get the counters of the timecode generator
+     */
+    const timeCodeGeneratorStats &getTimeCodeGeneratorStats() const {
+        return timeCodeOut.stats;
+    }
+
+    /**
+     * @brief handle all time based tasks including RDM timeouts and retries and the timecode generator
+     */
+    void service() override;
 };
@@ -0,0 +1,83 @@
+/**
+ * @file ArtNetFakeTransport.hpp
+ * @author your name (you@domain.com)
+ * @brief in memory transport implementing the transmit callbacks of ArtNet, used by the benchmarks
+ * so the results do not depend on the network
+ * @version 0.1
+ * @date 2026-01-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <stdint.h>
+
+
+class ArtNetFakeTransport {
+public:
+    static constexpr uint16_t maxPacketLen = 1536;
+    static constexpr uint8_t ipAddressLen = 4;
+
+    /**
+     * @brief counters of the transmitted packets
+     */
+    struct txCounters {
+        uint64_t packets;
+        uint64_t bytes;
+        uint64_t batches;
+        uint32_t checksum;      //sum over the last byte of every packet, keeps the copies observable
+    };
+
+private:
+    static uint8_t lastPacket[maxPacketLen];
+    static uint16_t lastPacketLen;
+    static uint8_t lastTargetIp[ipAddressLen];
+    static txCounters counters;
+
+    /**
+     * @brief keep a copy of the packet, like a socket copying it into the kernel
+     */
+    static void store(const uint8_t *packet, uint16_t packetLen, const uint8_t *targetIp, uint8_t targetIpLen);
+
+public:
+    /**
+     * @brief clear the counters and the stored packet
+     */
+    static void reset();
+
+    /**
+     * @brief store a single packet, usable as unicast callback
+     */
+    static bool sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort);
+
+    /**
+     * @brief store a batch of packets, usable as batch callback
+     *
+     * @return number of packets stored, always packetCount
+     */
+    static uint16_t sendBatch(const ArtNet::txPacket *packets, uint16_t packetCount);
+
+    /**
+     * @brief store a single packet, usable as broadcast callback
+     */
+    static bool sendBroadcast(uint8_t *packet, uint16_t packetLen, uint16_t targetPort);
+
+    /**
+     * @brief get the last stored packet
+     *
+     * @param packetLen length of the packet, 0 if nothing was sent
+     */
+    static const uint8_t *getLastPacket(uint16_t &packetLen);
+
+    /**
+     * @brief get the target ip of the last stored packet
+     */
+    static const uint8_t *getLastTargetIp();
+
+    /**
+     * @brief get the counters of the transport
+     */
+    static const txCounters &getCounters();
+};
@@ -0,0 +1,48 @@
+/**
+ * @file ArtNetLinuxFarm.hpp
+ * @author your name (you@domain.com)
+ * @brief optional Linux receive path of an ArtNetNodeFarm, shares the socket of ArtNetLinuxUdp and passes
+ * the destination ip of every packet so the farm can tell its virtual nodes apart
+ * @version 0.1
+ * @date 2026-01-22
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNetNodeFarm.hpp>
+#include <stdint.h>
+
+
+class ArtNetLinuxFarm {
+private:
+    static constexpr uint16_t maxBatchLen = 64;
+    static constexpr uint16_t maxPacketLen = 1536;
+
+public:
+    /**
+     * @brief open the socket of ArtNetLinuxUdp and enable the destination ip of received packets.
+     * the ips of the virtual nodes have to be routed to this host, e.g. 127.1.0.0/16 on loopback
+     *
+     * @param port local port to bind to
+     * @retval true -> socket opened
+     * @retval false -> socket could not be opened, bound or configured
+     */
+    static bool open(uint16_t port);
+
+    /**
+     * @brief close the socket
+     */
+    static void close();
+
+    /**
+     * @brief pass the packets waiting on the socket to the farm with recvmmsg, never blocks.
+     * replies are sent through the callbacks of the farm, e.g. ArtNetLinuxUdp::sendBatch
+     *
+     * @param farm farm handling the packets
+     * @param maxPackets maximum number of packets to handle
+     * @return number of packets handled
+     */
+    static uint16_t receive(ArtNetNodeFarm &farm, uint16_t maxPackets);
+};
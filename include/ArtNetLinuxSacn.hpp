@@ -0,0 +1,66 @@
+/**
+ * @file ArtNetLinuxSacn.hpp
+ * @author your name (you@domain.com)
+ * @brief optional Linux UDP socket on the sACN port feeding an ArtNetSacnGateway and implementing its sACN callback
+ * @version 0.1
+ * @date 2026-01-21
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNetSacn.hpp>
+#include <stdint.h>
+
+
+class ArtNetLinuxSacn {
+private:
+    static constexpr uint16_t maxBatchLen = 64;
+    static constexpr uint16_t maxPacketLen = 1144;     //largest E1.31 packet (universe discovery)
+
+    static int socketFd;
+
+public:
+    /**
+     * @brief open the socket, binds to the sACN port of all interfaces with SO_REUSEPORT
+     *
+     * @param loopback true -> multicast sent by this host is received as well, e.g. to test over loopback
+     * @retval true -> socket opened
+     * @retval false -> socket could not be opened or bound
+     */
+    static bool open(bool loopback);
+
+    /**
+     * @brief close the socket
+     */
+    static void close();
+
+    /**
+     * @brief get the file descriptor of the socket, -1 if not open
+     */
+    static int getSocket();
+
+    /**
+     * @brief join the multicast group of a sACN universe, required for every gdSacnToArtNet mapping
+     *
+     * @param universe sACN universe, valid range 1:63999
+     * @param interfaceIp ip of the interface to join on, nullptr -> chosen by the kernel
+     * @retval false -> socket not open or group could not be joined
+     */
+    static bool joinUniverse(uint16_t universe, const uint8_t *interfaceIp = nullptr);
+
+    /**
+     * @brief transmit a single packet, usable as sACN callback
+     */
+    static bool sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort);
+
+    /**
+     * @brief pass the packets waiting on the socket to the gateway with recvmmsg, never blocks
+     *
+     * @param gateway gateway handling the packets
+     * @param maxPackets maximum number of packets to handle
+     * @return number of packets handled
+     */
+    static uint16_t receive(ArtNetSacnGateway &gateway, uint16_t maxPackets);
+};
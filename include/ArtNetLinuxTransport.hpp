@@ -0,0 +1,160 @@
+/**
+ * @file ArtNetLinuxTransport.hpp
+ * @author your name (you@domain.com)
+ * @brief optional Linux receive path, drains the socket with recvmmsg and handles the packets on worker threads
+ * @version 0.1
+ * @date 2026-01-12
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <ArtNetLinuxUdp.hpp>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+class ArtNetLinuxTransport {
+public:
+    static constexpr uint8_t maxWorkers = 16;
+    static constexpr uint16_t maxRingSize = 4096;
+    static constexpr uint16_t slotDataLen = 1536;
+
+    /**
+     * @brief one received packet, the receive thread writes it and the workers handle it in place
+     */
+    struct alignas(64) rxSlot {
+        uint8_t data[slotDataLen];
+        uint16_t length;
+        uint8_t senderIp[4];
+        uint64_t receivedAt;            //taken right after recvmmsg for scopeTime packets, 0 otherwise
+        bool barrier;                   //acts on the whole device, handled while all workers wait
+        bool task;                      //no packet, runs serviceReceive() of the device
+        std::atomic<uint8_t> pending;   //number of workers which still have to handle the slot
+    };
+
+    /**
+     * @brief counters of the receive path
+     */
+    struct rxCounters {
+        std::atomic<uint64_t> received;
+        std::atomic<uint32_t> batches;
+        std::atomic<uint32_t> ringFull;
+        std::atomic<uint32_t> barriers;
+        std::atomic<uint64_t> handled[maxWorkers];
+    };
+
+private:
+    static constexpr uint8_t rxBatchLen = 64;
+    static constexpr uint16_t idleSpins = 64;
+    static constexpr int rxTimeOut = 10000;     //microseconds, how fast stop() is noticed
+    static constexpr uint32_t serviceInterval = 10000;  //microseconds between two calls of serviceReceive()
+    static constexpr int rxBufferSize = 4 * 1024 * 1024;
+
+    /**
+     * @brief single producer single consumer queue of slot indices feeding one worker
+     */
+    struct alignas(64) worker {
+        std::atomic<uint32_t> head{0};  //written by the worker
+        alignas(64) std::atomic<uint32_t> tail{0};  //written by the receive thread
+        std::atomic<bool> sleeping{false};
+        uint16_t entries[maxRingSize];
+        std::mutex wakeLock;
+        std::condition_variable wake;
+        std::thread thread;
+    };
+
+    ArtNet &device;
+    rxSlot *ring;
+    uint16_t ringMask;
+    uint32_t ringHead = 0;
+    uint8_t workerCount;
+    uint16_t port = 0;
+    uint64_t nextService = 0;   //microseconds, owned by the receive thread
+
+    worker workers[maxWorkers];
+    std::thread rxThread;
+    std::atomic<bool> running{false};           //receive thread
+    std::atomic<bool> workersRunning{false};    //cleared once the receive thread stopped queueing
+
+    //packets acting on the whole device are handled by the last worker reaching them
+    std::atomic<uint8_t> barrierArrived{0};
+    std::atomic<uint32_t> barrierGeneration{0};
+
+    rxCounters counters = {};
+
+    /**
+     * @brief receive thread, fills free ring slots with recvmmsg and hands them to the workers
+     */
+    void receiveLoop();
+
+    /**
+     * @brief worker thread, handles the slots of its queue in order
+     *
+     * @param workerIdx index of the worker
+     */
+    void workerLoop(uint8_t workerIdx);
+
+    /**
+     * @brief hand a filled slot to the workers which have to handle it
+     *
+     * @param slotIdx index of the slot in the ring
+     * @param notify bit mask of workers to wake up, updated
+     */
+    void dispatchSlot(uint16_t slotIdx, uint32_t &notify);
+
+    /**
+     * @brief handle a packet acting on the whole device once all workers reached it
+     *
+     * @param slot slot of the packet
+     */
+    void handleBarrier(rxSlot &slot);
+
+    /**
+     * @brief queue serviceReceive() of the device as a barrier task into the next ring slot if it is due
+     * and the slot is free, so it never runs next to the handling of a packet
+     */
+    void queueServiceTask();
+
+public:
+    /**
+     * @brief create the transport, the ring is owned by the caller and has to outlive the transport
+     *
+     * @param target device handling the received packets
+     * @param ringStorage slots used to receive packets
+     * @param ringSize number of slots, has to be a power of two in the range 64:maxRingSize
+     * @param workerThreads number of threads calling handlePacket, valid range 1:maxWorkers
+     */
+    ArtNetLinuxTransport(ArtNet &target, rxSlot *ringStorage, uint16_t ringSize, uint8_t workerThreads);
+    ArtNetLinuxTransport(ArtNetLinuxTransport &other) = delete;
+    ArtNetLinuxTransport(ArtNetLinuxTransport &&other) = delete;
+    ~ArtNetLinuxTransport();
+
+    /**
+     * @brief open the socket of ArtNetLinuxUdp, install its transmit callbacks on the device and
+     * start the receive and worker threads, only one transport can run per process. while running,
+     * the transport calls serviceReceive() of the device, service() still has to be called by the application
+     *
+     * @param localPort port to receive on, 0x1936 for ArtNet
+     * @retval true -> transport running
+     * @retval false -> invalid configuration or the socket could not be opened
+     */
+    bool start(uint16_t localPort);
+
+    /**
+     * @brief stop all threads after the queued packets were handled and close the socket
+     */
+    void stop();
+
+    /**
+     * @brief get the counters of the receive path
+     */
+    const rxCounters &getRxCounters() const {
+        return counters;
+    }
+};
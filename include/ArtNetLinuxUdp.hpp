@@ -0,0 +1,56 @@
+/**
+ * @file ArtNetLinuxUdp.hpp
+ * @author your name (you@domain.com)
+ * @brief optional Linux UDP socket implementing the transmit callbacks of ArtNet
+ * @version 0.1
+ * @date 2026-01-10
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <stdint.h>
+
+
+class ArtNetLinuxUdp {
+private:
+    static constexpr uint16_t maxBatchLen = 256;
+
+    static int socketFd;
+
+public:
+    /**
+     * @brief open the socket used by the callbacks, binds to all interfaces with SO_REUSEPORT
+     * 
+     * @param port local port to bind to, 0 -> any port
+     * @retval true -> socket opened
+     * @retval false -> socket could not be opened or bound
+     */
+    static bool open(uint16_t port);
+
+    /**
+     * @brief close the socket
+     */
+    static void close();
+
+    /**
+     * @brief get the file descriptor of the socket, -1 if not open
+     */
+    static int getSocket();
+
+    /**
+     * @brief transmit a single packet, usable as unicast callback
+     */
+    static bool sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort);
+
+    /**
+     * @brief transmit a batch of packets with sendmmsg, usable as batch callback
+     * 
+     * @param packets packets to transmit
+     * @param packetCount number of packets
+     * @return number of packets handed to the kernel
+     */
+    static uint16_t sendBatch(const ArtNet::txPacket *packets, uint16_t packetCount);
+};
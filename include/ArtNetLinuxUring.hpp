@@ -0,0 +1,222 @@
+/**
+ * @file ArtNetLinuxUring.hpp
+ * @author your name (you@domain.com)
+ * @brief optional Linux io_uring backend, receives into a provided buffer ring and sends from registered buffers
+ * @version 0.1
+ * @date 2026-01-13
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <sys/socket.h>
+
+
+class ArtNetLinuxUring {
+public:
+    static constexpr uint16_t rxBufferLen = 2048;
+    static constexpr uint16_t maxRxBuffers = 4096;
+    static constexpr uint16_t txSlotLen = 1536;
+    static constexpr uint16_t txSlotCount = 1024;
+
+    /**
+     * @brief counters of the backend
+     */
+    struct uringCounters {
+        uint64_t received;
+        uint64_t truncated;
+        uint32_t waits;             //io_uring_enter calls that waited for completions
+        uint32_t receiveRearmed;    //multishot receive restarted after running out of buffers
+        uint64_t sent;
+        uint32_t sendFailed;
+        uint32_t sendCopied;        //zero copy was not possible and the kernel copied the data
+        uint32_t txFull;
+    };
+
+private:
+    static constexpr uint16_t sqEntries = 256;
+    static constexpr uint16_t rxBufferGroup = 0;
+    static constexpr uint64_t tagReceive = 1ULL << 63;
+    static constexpr uint16_t noTxSlot = 0xffff;
+
+    /**
+     * @brief registered transmit buffer, reused once the kernel released it
+     */
+    struct txSlot {
+        uint8_t data[txSlotLen];
+        sockaddr_in target;
+        uint16_t nextFree;
+    };
+
+    /**
+     * @brief receive completion handled after the send path waited for a free transmit slot
+     */
+    struct deferredReceive {
+        int32_t result;
+        uint32_t flags;
+    };
+
+    static ArtNetLinuxUring *instance;
+
+    ArtNet &device;
+    int ringFd = -1;
+    int socketFd = -1;
+    uint16_t port = 0;
+    bool inEvents = false;
+
+    //rings shared with the kernel
+    void *sqRing = nullptr;
+    void *cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+    uint32_t *sqHead = nullptr;
+    uint32_t *sqTail = nullptr;
+    uint32_t *sqArray = nullptr;
+    uint32_t sqMask = 0;
+    uint32_t sqLocalTail = 0;
+    uint32_t *cqHead = nullptr;
+    uint32_t *cqTail = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    uint32_t cqMask = 0;
+
+    //receive buffers handed to the kernel through the provided buffer ring
+    io_uring_buf_ring *bufferRing = nullptr;
+    size_t bufferRingSize = 0;
+    uint8_t *rxBuffers = nullptr;
+    uint16_t rxBufferCount = 0;
+    uint16_t bufferRingTail = 0;
+    msghdr receiveHeader = {};
+    bool receiveArmed = false;
+
+    //transmit buffers registered with the kernel
+    txSlot *txSlots = nullptr;
+    uint16_t txFreeHead = noTxSlot;
+
+    deferredReceive *deferred = nullptr;
+    uint32_t deferredCount = 0;
+    uint32_t deferredSize = 0;
+
+    uringCounters counters = {};
+
+    /**
+     * @brief get the next free submission entry, submits the queued entries if the queue is full
+     * @return entry cleared to zero, nullptr if the kernel did not take any entries
+     */
+    io_uring_sqe *getSqe();
+
+    /**
+     * @brief hand all queued submission entries to the kernel
+     *
+     * @param waitFor number of completions to wait for
+     * @param timeOut maximum wait in microseconds, only used if waitFor > 0
+     * @retval true -> entries submitted
+     * @retval false -> io_uring_enter failed
+     */
+    bool submit(uint32_t waitFor, uint32_t timeOut);
+
+    /**
+     * @brief queue the multishot receive, has to be repeated once the kernel stopped it
+     */
+    bool armReceive();
+
+    /**
+     * @brief give a receive buffer back to the kernel, published with the next commitBuffers()
+     */
+    void recycleBuffer(uint16_t bufferId);
+
+    /**
+     * @brief publish the recycled receive buffers to the kernel
+     */
+    void commitBuffers();
+
+    /**
+     * @brief handle all available completions
+     *
+     * @param deferReceive true -> only store receive completions, used while sending
+     * @return number of handled packets
+     */
+    uint32_t reapCompletions(bool deferReceive);
+
+    /**
+     * @brief parse a received packet in place and hand it to the device
+     *
+     * @param result result of the completion
+     * @param flags flags of the completion
+     * @return 1 if a packet was handled, else 0
+     */
+    uint32_t handleReceive(int32_t result, uint32_t flags);
+
+    /**
+     * @brief queue a single packet for transmission, copied into a registered buffer
+     */
+    bool queueSend(const uint8_t *packet, uint16_t packetLen, const uint8_t *targetIp, uint16_t targetPort);
+
+    /**
+     * @brief release all kernel objects and mappings
+     */
+    void release();
+
+public:
+    /**
+     * @brief create the backend, nothing is opened before start()
+     *
+     * @param target device handling the received packets
+     */
+    explicit ArtNetLinuxUring(ArtNet &target);
+    ArtNetLinuxUring(ArtNetLinuxUring &other) = delete;
+    ArtNetLinuxUring(ArtNetLinuxUring &&other) = delete;
+    ~ArtNetLinuxUring();
+
+    /**
+     * @brief open the socket of ArtNetLinuxUdp, set up the ring and install the transmit callbacks
+     * on the device, only one backend can run per process. start(), processEvents() and all transmissions
+     * of the device have to happen on the same thread
+     *
+     * @param localPort port to receive on, 0x1936 for ArtNet
+     * @param bufferCount number of receive buffers, has to be a power of two in the range 16:maxRxBuffers
+     * @retval true -> backend running
+     * @retval false -> invalid parameters, io_uring not available or the socket could not be opened
+     */
+    bool start(uint16_t localPort, uint16_t bufferCount);
+
+    /**
+     * @brief stop receiving and release the ring and the socket
+     */
+    void stop();
+
+    /**
+     * @brief submit the queued transmissions, wait for packets and hand every received packet to the device
+     *
+     * @param timeOut maximum wait in microseconds, 0 -> do not wait
+     * @return number of handled packets
+     */
+    uint32_t processEvents(uint32_t timeOut);
+
+    /**
+     * @brief transmit a single packet, usable as unicast callback
+     */
+    static bool sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort);
+
+    /**
+     * @brief transmit a batch of packets with a single io_uring_enter, usable as batch callback
+     *
+     * @param packets packets to transmit
+     * @param packetCount number of packets
+     * @return number of packets queued to the kernel
+     */
+    static uint16_t sendBatch(const ArtNet::txPacket *packets, uint16_t packetCount);
+
+    /**
+     * @brief get the counters of the backend
+     */
+    const uringCounters &getCounters() const {
+        return counters;
+    }
+};
@@ -8,27 +8,650 @@
  * @copyright Copyright (c) 2026
  * 
  */
+#pragma once
 
  #include <ArtNet.hpp>
  #include <stdint.h>
+ #include <atomic>
 
 
 class ArtNetNode : public ArtNet{
+public:
+    static constexpr uint8_t jitterBuckets = 8;
+    static constexpr uint16_t defaultFailSafeTimeOut = 3000;   //milliseconds
+
+    /**
+     * @brief copy of the receive metrics of one port
+     *
+     * jitter counts the change of the inter-arrival time between two frames, bucket 0 holds changes
+     * below 128 us, every further bucket doubles the limit, the last one holds everything above 8 ms
+     */
+    struct portMetricsSnapshot {
+        uint32_t packets;
+        uint32_t bytes;
+        uint32_t sequenceGaps;      //frames missing according to the ArtDmx sequence
+        uint32_t outOfOrder;        //frames older than the last frame of their source, dropped if stale frames are rejected
+        uint32_t held;              //frames held back in the reorder window
+        uint32_t jitter[jitterBuckets];
+        uint32_t nzsFrames;         //ArtNzs and VLC frames queued for output
+        uint32_t nzsDropped;        //ArtNzs and VLC frames dropped because the queue was full
+    };
+
+    /**
+     * @brief VLC frame as passed to the output, the payload points into the queued frame
+     */
+    struct vlcFrame {
+        const uint8_t *payload;
+        uint16_t payloadLen;
+        uint16_t transaction;
+        uint16_t slotAddress;
+        uint16_t frequency;
+        uint16_t modulation;
+        uint16_t payloadLanguage;
+        uint16_t beaconRepeat;
+        uint8_t depth;
+        bool ieee;              //payload is an IEEE VLC packet
+        bool reply;             //reply to a previous transaction
+        bool beacon;            //repeat the payload every beaconRepeat frames
+    };
+
 private:
+    static constexpr uint8_t cacheLineLen = 64;
+    static constexpr uint16_t noPort = 0xffff;
+
+    /**
+     * @brief one frame of dmx data, aligned to a cache line
+     */
+    struct alignas(cacheLineLen) dmxFrame {
+        uint8_t slots[maxDmxSlots];
+        uint16_t length;
+    };
+
+    /**
+     * @brief triple-buffered frame store of a single port
+     *
+     * The receive context writes into the back frame, the output context reads the front frame.
+     * Finished frames are handed over through a third frame that is swapped atomically, so
+     * neither side ever waits for the other and a frame is never modified while it is output.
+     */
+    struct portFrameStore {
+        dmxFrame frames[3];
+        uint8_t back = 0;                       //owned by the receive context
+        uint8_t front = 1;                      //owned by the output context
+        std::atomic<uint8_t> handoff{2};        //index of the handoff frame, newFrameFlag if not yet output
+    };
+
+    static constexpr uint8_t newFrameFlag = 0x80;
+    static constexpr uint8_t frameIdxMask = 0x03;
+
+    static constexpr uint8_t maxMergeSources = 2;
+
+    /**
+     * @brief last frame received from one source of a port
+     */
+    struct mergeSource {
+        dmxFrame frame;
+        uint8_t ip[ipAddressLen];
+        uint64_t lastReceived;
+        uint8_t lastSequence;       //0 -> source does not use sequence numbers
+        bool active;
+    };
+
+    /**
+     * @brief merge state of a single port
+     */
+    struct portMergeState {
+        mergeSource sources[maxMergeSources];
+        bool ltpMode;
+        bool cancelPending;
+    };
+
+    /**
+     * @brief receive metrics of a single port, written only by the receive context of the port
+     * (ArtDmx of one Port-Address is never handled in parallel) so the counters are updated without
+     * read-modify-write, readers take snapshots at any time
+     */
+    struct portMetrics {
+        std::atomic<uint32_t> packets{0};
+        std::atomic<uint32_t> bytes{0};
+        std::atomic<uint32_t> sequenceGaps{0};
+        std::atomic<uint32_t> outOfOrder{0};
+        std::atomic<uint32_t> held{0};
+        std::atomic<uint32_t> jitter[jitterBuckets] = {};
+        std::atomic<uint32_t> nzsFrames{0};
+        std::atomic<uint32_t> nzsDropped{0};
+        uint64_t lastArrival = 0;
+        uint64_t lastInterval = 0;
+        uint32_t reportedPackets = 0;           //owned by service()
+    };
+
+    //backwards jumps of the sequence beyond this distance are taken as a restart of the source
+    static constexpr int16_t maxReorderDistance = 32;
+
+    /**
+     * @brief frame held back after a sequence gap until the missing frame arrived or the reorder window expired
+     */
+    struct reorderHold {
+        dmxFrame frame;
+        uint64_t until;
+        uint8_t sequence;
+        uint8_t source;         //index of the merge source
+        bool active;
+    };
+
+    /**
+     * @brief frame with a non-zero start code, queued apart from the dmx frames so it never replaces
+     * or delays them
+     */
+    struct alignas(cacheLineLen) nzsFrame {
+        uint8_t slots[maxDmxSlots];
+        uint16_t length;
+        uint8_t startCode;
+        bool isVlc;
+    };
+
+    /**
+     * @brief fail-safe state of a single port, the arrival time is written by the receive context, the
+     * timer by service() and the scene by the output context
+     */
+    struct failSafePort {
+        dmxFrame scene = {};                        //recorded by acFailRecord, played by fssPlayScene
+        std::atomic<uint64_t> lastReceived{0};      //microseconds, 0 -> no frame received yet
+        std::atomic<bool> pending{false};           //port timed out, fail-safe output due
+        std::atomic<bool> record{false};            //take the next output as scene
+        uint64_t timerDue = 0;                      //wheel tick
+        uint64_t handled = 0;                       //lastReceived the last fail-safe output was due for
+        uint16_t nextTimer = noPort;                //next timer of the same wheel slot
+    };
+
+    /**
+     * @brief complete receive state of a single port
+     */
+    struct nodePort {
+        portFrameStore frames;
+        portMergeState merge = {};
+        reorderHold hold = {};
+        portMetrics metrics;
+        failSafePort failSafe;
+        uint16_t nextSameAddress = noPort;      //next port with the same Port-Address
+        bool staged = false;                    //back frame waits for ArtSync
+
+        //single producer / single consumer queue of nzsFrames, free running counters
+        std::atomic<uint8_t> nzsHead{0};        //written by the receive context
+        std::atomic<uint8_t> nzsTail{0};        //written by the output context
+    };
+
+    /**
+     * @brief slot of the Port-Address lookup table
+     */
+    struct portMapEntry {
+        uint16_t portAddress;
+        uint16_t portIdx;
+    };
+
+    /**
+     * @brief size of the Port-Address lookup table, a power of two with at most 50% load
+     */
+    static constexpr uint16_t portMapSize(uint16_t portCount) {
+        uint16_t _size = 8;
+        while (_size < 2 * portCount) {
+            _size *= 2;
+        }
+        return _size;
+    }
+
+public:
+    /**
+     * @brief statically sized storage of all ports of a node, 4 ports form one page that is
+     * reported in its own poll reply
+     *
+     * @tparam portCount number of ports, valid range 1:1020
+     * @tparam nzsQueueLen number of ArtNzs / VLC frames queued per port, 0 -> ArtNzs is ignored
+     */
+    template <uint16_t portCount, uint8_t nzsQueueLen = 2>
+    struct portStorage {
+        static_assert(portCount > 0 && portCount <= 1020, "a node supports up to 255 pages of 4 ports");
+        static_assert(nzsQueueLen <= 128, "the ArtNzs queue holds up to 128 frames per port");
+
+        portConfig configs[portCount];
+        nodePort ports[portCount];
+        ArtPollReplyPacket replies[(portCount + 3) / 4];
+        portMapEntry portMap[portMapSize(portCount)];
+        nzsFrame nzsFrames[nzsQueueLen > 0 ? portCount * nzsQueueLen : 1];
+    };
+
+private:
+    nodePort *nodePorts;
+    portMapEntry *portMap;
+    uint16_t portMapMask;
+    nzsFrame *nzsFrames;
+    uint8_t nzsQueueLen;
+
+    /**
+     * @brief state of the synchronous output, frames are staged in the back frame until ArtSync arrives,
+     * read by every receive thread while ArtDmx of different ports is handled in parallel
+     */
+    struct syncState {
+        std::atomic<bool> enabled{true};
+        std::atomic<bool> active{false};
+        std::atomic<uint64_t> lastSyncReceived{0};
+    };
+
+    syncState sync;
+
+    static constexpr uint16_t failSafeTick = 1000;     //microseconds
+    static constexpr uint8_t wheelBits = 8;
+    static constexpr uint16_t wheelSlots = 1 << wheelBits;
+    static constexpr uint16_t wheelMask = wheelSlots - 1;
+
+    /**
+     * @brief hierarchical timer wheel of the fail-safe, every output port holds one timer. frames only
+     * store their arrival time, an expired timer is rescheduled from the last arrival unless the port
+     * really timed out, so the cost per tick does not grow with the number of ports. level 0 holds the
+     * timers due within wheelSlots ticks, level 1 the later ones in slots of wheelSlots ticks which
+     * cascade into level 0. owned by service()
+     */
+    struct failSafeWheel {
+        uint16_t level0[wheelSlots];
+        uint16_t level1[wheelSlots];
+        uint64_t tick = 0;                                  //last tick handled
+        uint32_t timeOut = defaultFailSafeTimeOut * 1000u / failSafeTick;   //ticks
+        std::atomic<uint8_t> mode{fssLastState};
+        std::atomic<bool> reset{true};                      //ports, mode or time out changed
+    };
+
+    failSafeWheel failSafe;
+
+    //odd while the receive context publishes a batch of frames
+    std::atomic<uint32_t> publishSequence{0};
+
+    /**
+     * @brief periodic summary of the metrics in the node report and as ArtDiagData
+     */
+    struct metricsReport {
+        uint64_t interval;                      //microseconds, 0 -> disabled
+        uint64_t lastReport;
+        uint16_t reportCount;
+        uint32_t reportedFailures[reportCodeCount];
+        bool toNodeReport;
+        bool toDiagData;
+    };
+
+    metricsReport report = {};
+
+    /**
+     * @brief handling of the ArtDmx sequence numbers, shared by all ports
+     */
+    struct sequenceConfig {
+        bool dropStale;
+        uint16_t reorderWindow;                 //microseconds, 0 -> frames are never held
+    };
+
+    sequenceConfig sequenceCheck = {true, 0};
+
+    /**
+     * @brief distance between two sequence numbers, wraps from 255 to 1
+     *
+     * @param from reference sequence
+     * @param to compared sequence
+     * @return number of frames from -> to, negative if to is older, range -127:127
+     */
+    static int16_t sequenceDistance(uint8_t from, uint8_t to) {
+        int16_t _distance = static_cast<int16_t>(to - from);
+        if (_distance < 0) {
+            _distance += 255;
+        }
+        return _distance > 127 ? _distance - 255 : _distance;
+    }
 
     /**
      * @brief function pointer to output dmx data to the corresponding port
      * @param dmxData dmx data to output
      * @param dmxDataSize number of channels of dmx data
-     * @param portIdx port to output data on, valid range 0:3
+     * @param portIdx port to output data on
      * @retval true -> succeeded to output data
      * @retval false -> failed to output data
      */
-    bool (*callback_outputDmx)(uint8_t *dmxData, uint16_t dmxDataSize, uint8_t portIdx);
+    bool (*callback_outputDmx)(uint8_t *dmxData, uint16_t dmxDataSize, uint16_t portIdx) = nullptr;
+
+    bool (*callback_outputNzs)(uint8_t startCode, uint8_t *data, uint16_t dataSize, uint16_t portIdx) = nullptr;
+    bool (*callback_outputVlc)(const vlcFrame &frame, uint16_t portIdx) = nullptr;
+
+    ArtNetNode(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, portConfig *configs, nodePort *portStates,
+        ArtPollReplyPacket *replies, portMapEntry *portMapStorage, uint16_t portCount, uint16_t mapSize,
+        nzsFrame *nzsStorage, uint8_t nzsLen);
+
+    /**
+     * @brief rebuild the Port-Address lookup table after the configuration of a port changed
+     */
+    void rebuildPortMap();
+
+    /**
+     * @brief find the first output port with a Port-Address
+     *
+     * @param portAddress 15 bit Port-Address
+     * @return index of the port, noPort if no port matches
+     */
+    uint16_t findPort(uint16_t portAddress) const;
+
+    /**
+     * @brief hand the back frame of a port over to the output context
+     *
+     * @param portIdx port to publish the frame of
+     */
+    void publishFrame(uint16_t portIdx);
+
+    /**
+     * @brief store the data of an incoming frame for its source and build the output frame of a port,
+     * merges HTP or LTP if more than one source is active
+     *
+     * @param portIdx port the frame was received for
+     * @param slots dmx data of the frame
+     * @param length number of slots in the frame
+     * @param sequence sequence number of the frame, 0 -> not used by the source
+     * @param senderIp ip of the source of the frame
+     * @param now time of reception in microseconds
+     * @retval true -> back frame of the port holds a new frame
+     * @retval false -> frame was dropped (too many sources or stale) or is held in the reorder window
+     */
+    bool mergeFrame(uint16_t portIdx, const uint8_t *slots, uint16_t length, uint8_t sequence, const uint8_t *senderIp, uint64_t now);
+
+    /**
+     * @brief count a received frame in the metrics of a port
+     *
+     * @param metrics metrics of the port
+     * @param length number of slots in the frame
+     * @param now time of reception in microseconds
+     */
+    static void countArrival(portMetrics &metrics, uint16_t length, uint64_t now);
+
+    /**
+     * @brief take a frame as the newest frame of a source and build the output frame of the port
+     *
+     * @param portIdx port the frame was received for
+     * @param source source of the frame
+     * @param slots dmx data of the frame
+     * @param length number of slots in the frame
+     */
+    void applyFrame(uint16_t portIdx, mergeSource &source, const uint8_t *slots, uint16_t length);
+
+    /**
+     * @brief apply the held frame of a port
+     *
+     * @retval true -> back frame of the port holds the released frame
+     */
+    bool releaseHold(uint16_t portIdx);
+
+    /**
+     * @brief put the timer of a port into the wheel
+     *
+     * @param due tick the timer expires at, not before the current tick
+     */
+    void scheduleFailSafe(uint16_t portIdx, uint64_t due);
+
+    /**
+     * @brief empty the wheel and add one timer per output port, timers are only used while the
+     * fail-safe mode is not fssLastState
+     */
+    void resetFailSafe(uint64_t tick);
+
+    /**
+     * @brief advance the wheel to the current time and handle the expired timers
+     */
+    void serviceFailSafe(uint64_t now);
+
+    /**
+     * @brief check an expired timer, flag the fail-safe output if no frame arrived within the time out
+     * and reschedule the timer
+     */
+    void expireFailSafe(uint16_t portIdx, uint64_t now);
+
+    /**
+     * @brief pass the fail-safe state of a port to the output callback, has to be called from the
+     * output context
+     *
+     * @retval true -> frame was output
+     */
+    bool outputFailSafe(uint16_t portIdx);
+
+    /**
+     * @brief write the summary of the metrics to the node report and/or send it as ArtDiagData
+     *
+     * @param elapsed time since the last summary in microseconds
+     */
+    void publishMetrics(uint64_t elapsed);
+
+    /**
+     * @brief count the sources of a port which did not time out
+     *
+     * @param portIdx port to count the sources of
+     * @param now current time in microseconds
+     */
+    uint8_t countActiveSources(uint16_t portIdx, uint64_t now);
+
+    /**
+     * @brief apply the merge, direction and fail-safe commands of ArtAddress, the node only has outputs
+     * so acDirectionRx is ignored
+     */
+    void applyAddressCommand(uint8_t command, uint16_t page) override;
+
+    /**
+     * @brief rebuild the Port-Address lookup table after ArtAddress
+     */
+    void portsChanged() override;
+
+    /**
+     * @brief report the merge state of the ports of a page in the poll reply
+     */
+    void updatePortStatus(ArtPollReplyPacket &reply, uint16_t page) override;
+
+    /**
+     * @brief function to handle artDmx packets, the dmx data is copied from the receive buffer
+     * straight into the back frame of every output port with a matching Port-Address
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psInvalidContent -> length field does not fit the packet
+     */
+    packetStatus handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief function to handle artSync packets, publishes the staged frames of all ports at once,
+     * ignored while any port is merging
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     */
+    packetStatus handleArtSync(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief publish the staged frames of all ports as one batch
+     */
+    void publishStagedFrames();
+
+    /**
+     * @brief function to handle artNzs packets, frames with the VLC magic are checked and routed as VLC,
+     * all others by their start code, both end up in the nzs queue of every matching output port
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet in bytes
+     *
+     * @retval psInvalidContent -> start code 0, length field does not fit the packet or invalid VLC data
+     */
+    packetStatus handleArtNzs(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief check the VLC header and the checksum of the payload
+     *
+     * @param data data of the ArtNzs packet
+     * @param length number of bytes in data
+     */
+    static bool isValidVlc(const uint8_t *data, uint16_t length);
+
+    /**
+     * @brief copy a frame into the nzs queue of a port
+     *
+     * @retval true -> frame queued
+     * @retval false -> queue full, frame dropped
+     */
+    bool queueNzsFrame(uint16_t portIdx, uint8_t startCode, bool isVlc, const uint8_t *data, uint16_t length);
+
+    /**
+     * @brief pass a queued frame to the VLC or the nzs output
+     *
+     * @retval true -> frame was output
+     */
+    bool outputNzsFrame(nzsFrame &frame, uint16_t portIdx);
+
 public:
-    ArtNetNode();
+    /**
+     * @brief create a node with the ports of a statically sized storage
+     *
+     * @param storage storage of all ports, has to outlive the node
+     */
+    template <uint16_t portCount, uint8_t queueLen>
+    ArtNetNode(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, portStorage<portCount, queueLen> &storage)
+        : ArtNetNode(oemCode, MAC, MACLen, storage.configs, storage.ports, storage.replies, storage.portMap, portCount, portMapSize(portCount),
+            storage.nzsFrames, queueLen) {
+    }
+
     ArtNetNode(ArtNetNode &other) = delete;
     ArtNetNode(ArtNetNode &&other) = delete;
     ~ArtNetNode();
+
+    /**
+     * @brief set the function used to output dmx data
+     *
+     * @param callback function to call with every new frame, the frame stays valid until the
+     * next call for the same port
+     */
+    void setOutputDmxCallback(bool (*callback)(uint8_t *dmxData, uint16_t dmxDataSize, uint16_t portIdx));
+
+    /**
+     * @brief set the function used to output ArtNzs frames, also receives VLC frames if no VLC callback is set
+     *
+     * @param callback function to call with every queued frame and its start code, the data stays valid
+     * until the callback returns
+     */
+    void setOutputNzsCallback(bool (*callback)(uint8_t startCode, uint8_t *data, uint16_t dataSize, uint16_t portIdx));
+
+    /**
+     * @brief set the function used to output VLC frames, VLC is only output while no controller disabled it
+     *
+     * @param callback function to call with every queued VLC frame, the payload stays valid until the
+     * callback returns
+     */
+    void setOutputVlcCallback(bool (*callback)(const vlcFrame &frame, uint16_t portIdx));
+
+    /**
+     * @brief configure a port as dmx output, all ports of a page (4 ports) have to share net and sub-net
+     *
+     * @param portIdx port to configure
+     * @param portAddress 15 bit Port-Address of the port
+     * @retval true -> port configured
+     * @retval false -> invalid port index or net/sub-net differs from the other ports of the page
+     */
+    bool configureOutputPort(uint16_t portIdx, uint16_t portAddress);
+
+    /**
+     * @brief function to set the net and sub-net part of the Port-Address of all ports
+     */
+    void setNetSubSwitch(uint8_t netSwitch, uint8_t subSwitch) override;
+
+    /**
+     * @brief output all frames received since the last call, has to be called from the dmx
+     * output context
+     *
+     * @return number of frames passed to the output callback
+     */
+    uint16_t processOutputs();
+
+    /**
+     * @brief output all ArtNzs and VLC frames queued since the last call in order of arrival, kept apart
+     * from processOutputs so the dmx output never waits for them
+     *
+     * @return number of frames passed to the output callbacks
+     */
+    uint16_t processNzsOutputs();
+
+    /**
+     * @brief select the merge mode of a port
+     *
+     * @param portIdx port to configure
+     * @param ltp true -> latest takes precedence, false -> highest takes precedence
+     * @retval true -> merge mode set
+     * @retval false -> invalid port index
+     */
+    bool setMergeMode(uint16_t portIdx, bool ltp);
+
+    /**
+     * @brief cancel merging, all ports only keep the source of their next frame
+     */
+    void cancelMerge();
+
+    /**
+     * @brief allow or prevent synchronous output, sync mode is entered when the first ArtSync
+     * arrives and left by serviceReceive() if no ArtSync was received for 4 seconds
+     *
+     * @param enable true -> follow ArtSync, false -> always output immediately
+     */
+    void enableSync(bool enable);
+
+    /**
+     * @brief configure the handling of the ArtDmx sequence numbers, frames with sequence 0 are never checked
+     *
+     * @param dropStale true -> frames older than the last frame of their source are dropped
+     * @param reorderWindow after a sequence gap the frame is held for up to this time in microseconds,
+     * missing frames arriving meanwhile are applied first, an expired hold goes out with the next frame or
+     * from serviceReceive(), 0 -> never hold frames
+     */
+    void setSequenceCheck(bool dropStale, uint16_t reorderWindow);
+
+    /**
+     * @brief configure what the outputs do after their ArtDmx stopped, requires the time callback and
+     * periodic calls of service() (at least every few milliseconds), has to be called from the context
+     * calling service(). the fail-safe state is output by processOutputs() until the next frame arrives
+     *
+     * @param mode fssLastState (keep the output), fssOutputZero, fssOutputFull or fssPlayScene
+     * @param timeOut time without ArtDmx before a port fails in milliseconds
+     * @retval true -> fail-safe configured
+     * @retval false -> invalid mode or time out of 0
+     */
+    bool setFailSafe(uint8_t mode, uint16_t timeOut = defaultFailSafeTimeOut);
+
+    /**
+     * @brief take the current output of every port as its fail-safe scene, copied by the next call of
+     * processOutputs()
+     */
+    void recordFailSafeScene();
+
+    /**
+     * @brief copy the receive metrics of a port, safe to call while packets are handled
+     *
+     * @param portIdx port to read
+     * @param snapshot destination of the metrics
+     * @retval true -> metrics copied
+     * @retval false -> invalid port index
+     */
+    bool getPortMetrics(uint16_t portIdx, portMetricsSnapshot &snapshot) const;
+
+    /**
+     * @brief periodically summarise the metrics, requires the time callback and periodic calls of service()
+     *
+     * @param interval seconds between two summaries, 0 -> disabled
+     * @param toNodeReport true -> write the summary to the node report of the poll reply
+     * @param toDiagData true -> send the summary of every port as ArtDiagData if a controller asked for it
+     */
+    void setMetricsReport(uint16_t interval, bool toNodeReport, bool toDiagData);
+
+    /**
+     * @brief leave sync mode once ArtSync stopped or sync was disabled, publishes the frames staged on all ports
+     */
+    void serviceReceive() override;
+
+    /**
+     * @brief handle all time based tasks including the metrics summary and the fail-safe timers
+     */
+    void service() override;
 };
- 
\ No newline at end of file
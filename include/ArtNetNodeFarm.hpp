@@ -0,0 +1,198 @@
+/**
+ * @file ArtNetNodeFarm.hpp
+ * @author your name (you@domain.com)
+ * @brief thousands of virtual nodes in one device for load tests of controllers, the nodes share one
+ * socket and are told apart by the ip a packet was sent to, their state is kept as structure of arrays
+ * @version 0.1
+ * @date 2026-01-22
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <stdint.h>
+
+
+/**
+ * @brief every virtual node has one page of 4 ports and answers ArtPoll and consumes ArtDmx like an
+ * ArtNetNode. names, OEM code, style and the other fields of the configuration are shared, node n uses
+ * the first ip + n and the MAC + n. packets have to be handled by a single thread
+ */
+class ArtNetNodeFarm : public ArtNet {
+public:
+    static constexpr uint8_t portsPerNode = 4;
+    static constexpr uint8_t replyBatchLen = 64;
+
+    /**
+     * @brief copy of the receive metrics of one virtual port
+     */
+    struct virtualPortMetrics {
+        uint32_t packets;
+        uint32_t sequenceGaps;      //frames missing according to the ArtDmx sequence
+        uint32_t outOfOrder;        //frames older than the last frame, dropped
+        uint16_t lastLength;
+    };
+
+private:
+    static constexpr uint16_t noPort = 0xffff;
+    static constexpr uint16_t allNodes = 0xffff;
+
+public:
+    /**
+     * @brief statically sized storage of all virtual nodes, one array per field indexed by
+     * node * portsPerNode + port so a scan over one field touches only that field
+     *
+     * @tparam nodeCount number of virtual nodes, valid range 1:65534
+     */
+    template <uint16_t nodeCount>
+    struct farmStorage {
+        static_assert(nodeCount > 0 && nodeCount < allNodes, "a farm holds up to 65534 nodes");
+
+        uint16_t portAddresses[nodeCount * portsPerNode];      //noPort -> port not configured
+        uint8_t lastSequences[nodeCount * portsPerNode];
+        uint16_t lastLengths[nodeCount * portsPerNode];
+        uint32_t packets[nodeCount * portsPerNode];
+        uint32_t sequenceGaps[nodeCount * portsPerNode];
+        uint32_t outOfOrder[nodeCount * portsPerNode];
+    };
+
+private:
+    uint16_t nodeCount;
+    uint16_t *portAddresses;
+    uint8_t *lastSequences;
+    uint16_t *lastLengths;
+    uint32_t *packets;
+    uint32_t *sequenceGaps;
+    uint32_t *outOfOrder;
+
+    uint32_t firstIp;               //ip of node 0, host order
+    uint16_t targetNode = allNodes; //node the packet in progress was sent to
+
+    //replies in flight to the batch callback
+    ArtPollReplyPacket replyBatch[replyBatchLen];
+    txPacket replyTx[replyBatchLen];
+    uint8_t replyTargetIp[ipAddressLen];
+
+    bool (*callback_outputDmx)(const uint8_t *dmxData, uint16_t dmxDataSize, uint16_t nodeIdx, uint8_t portIdx) = nullptr;
+
+    ArtNetNodeFarm(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, uint16_t count, uint16_t *portAddressStorage,
+        uint8_t *sequenceStorage, uint16_t *lengthStorage, uint32_t *packetStorage, uint32_t *gapStorage, uint32_t *outOfOrderStorage);
+
+    /**
+     * @brief write the fields of a node into a copy of the shared poll reply
+     */
+    void patchPollReply(ArtPollReplyPacket &reply, uint16_t nodeIdx) const;
+
+    /**
+     * @brief check if a node has a port inside the range of a targeted ArtPoll
+     */
+    bool isTargeted(uint16_t nodeIdx, uint16_t bottom, uint16_t top) const;
+
+    /**
+     * @brief hand the collected replies to the batch callback or the unicast callback
+     *
+     * @return number of replies transmitted
+     */
+    uint16_t flushReplies(uint16_t replyCount);
+
+    /**
+     * @brief consume the ArtDmx of one virtual port
+     */
+    void consumeDmx(uint32_t portIdx, const uint8_t *slots, uint16_t length, uint8_t sequence);
+
+    /**
+     * @brief function to handle artPoll packets, every addressed node replies with its own poll reply
+     *
+     * @retval psTransmitFailed -> at least one reply could not be transmitted
+     */
+    packetStatus handleArtPoll(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief function to handle artDmx packets, unicast ArtDmx is consumed by the ports of its node,
+     * broadcast ArtDmx by every port with a matching Port-Address
+     *
+     * @retval psInvalidContent -> length field does not fit the packet
+     */
+    packetStatus handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+public:
+    /**
+     * @brief create a farm with the nodes of a statically sized storage
+     *
+     * @param MAC MAC of node 0, the other nodes count up in the last two bytes
+     * @param storage storage of all nodes, has to outlive the farm
+     */
+    template <uint16_t count>
+    ArtNetNodeFarm(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, farmStorage<count> &storage)
+        : ArtNetNodeFarm(oemCode, MAC, MACLen, count, storage.portAddresses, storage.lastSequences, storage.lastLengths,
+            storage.packets, storage.sequenceGaps, storage.outOfOrder) {
+    }
+
+    ArtNetNodeFarm(ArtNetNodeFarm &other) = delete;
+    ArtNetNodeFarm(ArtNetNodeFarm &&other) = delete;
+    ~ArtNetNodeFarm();
+
+    /**
+     * @brief set the function used to output the dmx data of the virtual ports
+     *
+     * @param callback function to call with every consumed frame, the data points into the received packet
+     */
+    void setOutputDmxCallback(bool (*callback)(const uint8_t *dmxData, uint16_t dmxDataSize, uint16_t nodeIdx, uint8_t portIdx));
+
+    /**
+     * @brief set the ip of node 0, node n uses this ip + n
+     *
+     * @param ip ip of node 0
+     * @param ipLen number of bytes in ip
+     * @retval false -> ip too short or the range of the nodes wraps
+     */
+    bool setFirstIp(const uint8_t *ip, uint8_t ipLen);
+
+    /**
+     * @brief get the ip of a node
+     */
+    void getNodeIp(uint16_t nodeIdx, uint8_t *ip) const;
+
+    /**
+     * @brief find the node of an ip
+     *
+     * @return index of the node, -1 if the ip is not inside the range of the farm
+     */
+    int32_t findNode(const uint8_t *ip, uint8_t ipLen) const;
+
+    /**
+     * @brief get the number of virtual nodes
+     */
+    uint16_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    /**
+     * @brief configure a port of a node as dmx output, all ports of a node share net and sub-net
+     *
+     * @param nodeIdx node to configure
+     * @param portIdx port of the node, valid range 0:3
+     * @param portAddress 15 bit Port-Address of the port
+     * @retval true -> port configured
+     * @retval false -> invalid index or net/sub-net differs from the other ports of the node
+     */
+    bool configureNodePort(uint16_t nodeIdx, uint8_t portIdx, uint16_t portAddress);
+
+    /**
+     * @brief copy the receive metrics of a virtual port, has to be called from the thread handling the packets
+     *
+     * @retval false -> invalid index
+     */
+    bool getPortMetrics(uint16_t nodeIdx, uint8_t portIdx, virtualPortMetrics &snapshot) const;
+
+    /**
+     * @brief handle a packet sent to one of the nodes or to all of them
+     *
+     * @param targetIp destination ip of the packet, a broadcast or unknown ip addresses all nodes
+     * @param targetIpLen number of bytes in targetIp
+     */
+    packetStatus handleFarmPacket(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen,
+        const uint8_t *targetIp, uint8_t targetIpLen);
+};
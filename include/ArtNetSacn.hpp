@@ -0,0 +1,289 @@
+/**
+ * @file ArtNetSacn.hpp
+ * @author your name (you@domain.com)
+ * @brief gateway between ArtDmx and sACN (E1.31) data packets, every mapping holds its prebuilt output
+ * packet so the slots are copied once from the receive buffer and sent within the same call
+ * @version 0.1
+ * @date 2026-01-21
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNet.hpp>
+#include <stdint.h>
+#include <atomic>
+
+
+class ArtNetSacnGateway : public ArtNet {
+public:
+    static constexpr uint8_t cacheLineLen = 64;
+    static constexpr uint16_t sacnPort = 5568;
+    static constexpr uint8_t sacnHeaderLen = 126;
+    static constexpr uint16_t sacnPacketLen = sacnHeaderLen + maxDmxSlots;
+    static constexpr uint8_t sacnCidLen = 16;
+    static constexpr uint16_t minSacnUniverse = 1;
+    static constexpr uint16_t maxSacnUniverse = 63999;
+    static constexpr uint8_t defaultSacnPriority = 100;
+    static constexpr uint8_t maxSacnPriority = 200;
+
+    /**
+     * @brief direction of a mapping
+     */
+    enum gatewayDirections {
+        gdArtNetToSacn  = 0,    //ArtDmx of the Port-Address is sent as sACN, reported as output with the sACN bit of GoodOutputA
+        gdSacnToArtNet  = 1,    //sACN of the universe is sent as ArtDmx, reported as input with the sACN bit of GoodInput
+    };
+
+    /**
+     * @brief counters of the gateway, updated with relaxed atomics
+     */
+    struct gatewayCounters {
+        std::atomic<uint32_t> toSacn;
+        std::atomic<uint32_t> toArtNet;
+        std::atomic<uint32_t> sacnInvalid;          //not an E1.31 data packet
+        std::atomic<uint32_t> sacnIgnored;          //unmapped universe, preview data or alternate start code
+        std::atomic<uint32_t> sacnOutOfOrder;       //sequence number behind the last packet of the source
+        std::atomic<uint32_t> sacnLowerPriority;    //other sources while a source of higher or equal priority is active
+        std::atomic<uint32_t> sendFailed;
+    };
+
+private:
+    static constexpr uint16_t noMapping = 0xffff;
+    static constexpr uint16_t sacnSourceTimeOut = 2500;     //milliseconds, E1.31 network data loss
+    static constexpr uint8_t acnPidLen = 12;
+    static constexpr uint8_t acnPid[acnPidLen] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00};
+    static constexpr uint32_t vectorRootData = 0x00000004;
+    static constexpr uint32_t vectorFramingData = 0x00000002;
+    static constexpr uint8_t vectorDmpSetProperty = 0x02;
+    static constexpr uint8_t dmpAddressType = 0xa1;
+    static constexpr uint16_t pduFlags = 0x7000;
+
+    /**
+     * @brief wire layout of an E1.31 data packet
+     */
+    struct sacnDataLayout {
+        static constexpr uint16_t length = sacnPacketLen;
+        typedef wireField<0, 2, woBigEndian> preambleSize;
+        typedef wireField<2, 2, woBigEndian> postambleSize;
+        typedef wireBytes<4, acnPidLen> acnPid;
+        typedef wireField<16, 2, woBigEndian> rootFlagsLength;
+        typedef wireField<18, 4, woBigEndian> rootVector;
+        typedef wireBytes<22, sacnCidLen> cid;
+        typedef wireField<38, 2, woBigEndian> framingFlagsLength;
+        typedef wireField<40, 4, woBigEndian> framingVector;
+        typedef wireBytes<44, 64> sourceName;
+        typedef wireField<108, 1> priority;
+        typedef wireField<109, 2, woBigEndian> syncAddress;
+        typedef wireField<111, 1> sequence;
+        typedef wireBits<112, 7> previewData;
+        typedef wireBits<112, 6> streamTerminated;
+        typedef wireBits<112, 5> forceSync;
+        typedef wireField<113, 2, woBigEndian> universe;
+        typedef wireField<115, 2, woBigEndian> dmpFlagsLength;
+        typedef wireField<117, 1> dmpVector;
+        typedef wireField<118, 1> addressType;
+        typedef wireField<119, 2, woBigEndian> firstAddress;
+        typedef wireField<121, 2, woBigEndian> addressIncrement;
+        typedef wireField<123, 2, woBigEndian> propertyCount;   //slots + start code
+        typedef wireField<125, 1> startCode;
+        typedef wireBytes<sacnHeaderLen, maxDmxSlots> data;
+    };
+    static_assert(sacnDataLayout::startCode::end == sacnHeaderLen, "sacnDataLayout does not match sacnHeaderLen");
+
+public:
+    /**
+     * @brief state of one mapping, the output packet is complete except for the slots, their count and
+     * the sequence number. touched by one receive thread at a time (packets of a universe stay in order)
+     */
+    struct alignas(cacheLineLen) gatewayPort {
+        uint8_t packet[sacnPacketLen];          //E1.31 for gdArtNetToSacn, ArtDmx for gdSacnToArtNet
+        uint8_t targetIp[ipAddressLen];         //multicast group or ArtDmx target
+        uint16_t universe;
+        uint8_t direction;
+        uint8_t sequence;
+
+        //sACN source forwarded by a gdSacnToArtNet mapping
+        uint8_t sourceCid[sacnCidLen];
+        uint8_t sourcePriority;
+        uint8_t sourceSequence;
+        bool sourceActive;
+        uint64_t sourceLastSeen;                //microseconds
+    };
+
+    /**
+     * @brief statically sized storage of the gateway, has to outlive the gateway
+     *
+     * @tparam portCount number of mappings
+     */
+    template <uint16_t portCount>
+    struct gatewayStorage {
+        static_assert(portCount > 0, "a gateway needs at least one mapping");
+
+        portConfig configs[portCount];
+        gatewayPort ports[portCount];
+        std::atomic<uint16_t> artNetKeys[portCount];
+        std::atomic<uint16_t> sacnKeys[portCount];
+        ArtPollReplyPacket replies[(portCount + 3) / 4];
+    };
+
+private:
+    gatewayPort *gatewayPorts;
+
+    //dense keys scanned per packet, noMapping -> port not mapped in this direction. a key is stored with
+    //release once the packet of its port is built, receive threads load it with acquire
+    std::atomic<uint16_t> *artNetKeys;
+    std::atomic<uint16_t> *sacnKeys;
+
+    uint8_t cid[sacnCidLen];
+    gatewayCounters counters = {};
+
+    bool (*callback_sacn)(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort) = nullptr;
+
+    ArtNetSacnGateway(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, portConfig *configs, gatewayPort *portStates,
+        std::atomic<uint16_t> *artNetKeyStorage, std::atomic<uint16_t> *sacnKeyStorage, ArtPollReplyPacket *replies, uint16_t portCount);
+
+    /**
+     * @brief find the next mapping of a key, several ports may share a key
+     *
+     * @param keys artNetKeys or sacnKeys
+     * @param key Port-Address or universe
+     * @param from first port to check
+     * @return index of the port, noMapping if no further port is mapped
+     */
+    uint16_t findMapping(const std::atomic<uint16_t> *keys, uint16_t key, uint16_t from) const;
+
+    /**
+     * @brief check that a port can be mapped to a Port-Address, all ports of a page share net and sub-net
+     */
+    bool canMap(uint16_t portIdx, uint16_t portAddress) const;
+
+    /**
+     * @brief write the parts of the E1.31 output packet that never change
+     */
+    void buildSacnHeader(gatewayPort &port, uint8_t priority);
+
+    /**
+     * @brief forward an ArtDmx packet to every gdArtNetToSacn mapping of its Port-Address, ArtDmx sent
+     * by the gateway itself is ignored
+     *
+     * @retval psTransmitFailed -> sACN callback missing or failed
+     */
+    packetStatus handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) override;
+
+    /**
+     * @brief follow Port-Addresses changed by ArtAddress with the keys and the prebuilt ArtDmx packets
+     */
+    void portsChanged() override;
+
+    /**
+     * @brief set the sACN priority of the Art-Net -> sACN mappings of the page
+     */
+    void applyAcnPriority(uint8_t priority, uint16_t page) override;
+
+    /**
+     * @brief report the direction and the sACN priority of the ports
+     */
+    void updatePortStatus(ArtPollReplyPacket &reply, uint16_t page) override;
+
+public:
+    /**
+     * @brief create a gateway with the mappings of a statically sized storage
+     *
+     * @param storage storage of all mappings, has to outlive the gateway
+     */
+    template <uint16_t portCount>
+    ArtNetSacnGateway(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, gatewayStorage<portCount> &storage)
+        : ArtNetSacnGateway(oemCode, MAC, MACLen, storage.configs, storage.ports, storage.artNetKeys, storage.sacnKeys,
+            storage.replies, portCount) {
+    }
+
+    ArtNetSacnGateway(ArtNetSacnGateway &other) = delete;
+    ArtNetSacnGateway(ArtNetSacnGateway &&other) = delete;
+    ~ArtNetSacnGateway();
+
+    /**
+     * @brief set the function used to transmit sACN, e.g. ArtNetLinuxSacn::sendUnicast
+     *
+     * @param callback function to transmit a packet to the multicast group of its universe, returns true on success
+     */
+    void setSacnCallback(bool (*callback)(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort));
+
+    /**
+     * @brief send the ArtDmx of a Port-Address as sACN to the multicast group of a universe
+     *
+     * @param portIdx port of the mapping
+     * @param portAddress 15 bit Port-Address
+     * @param universe sACN universe, valid range 1:63999
+     * @param priority sACN priority, valid range 0:200, reported as acnPriority
+     * @retval true -> mapping configured
+     * @retval false -> invalid argument or net/sub-net differs from the other ports of the page
+     */
+    bool mapArtNetToSacn(uint16_t portIdx, uint16_t portAddress, uint16_t universe, uint8_t priority = defaultSacnPriority);
+
+    /**
+     * @brief send the sACN of a universe as ArtDmx, of several sources the one with the highest priority
+     * is forwarded until it terminates or times out
+     *
+     * @param portIdx port of the mapping
+     * @param universe sACN universe, valid range 1:63999
+     * @param portAddress 15 bit Port-Address
+     * @param targetIp receiver of the ArtDmx, nullptr -> broadcast
+     * @param targetIpLen number of bytes in targetIp
+     * @retval true -> mapping configured
+     * @retval false -> invalid argument or net/sub-net differs from the other ports of the page
+     */
+    bool mapSacnToArtNet(uint16_t portIdx, uint16_t universe, uint16_t portAddress, uint8_t *targetIp = nullptr, uint8_t targetIpLen = 0);
+
+    /**
+     * @brief remove the mapping of a port
+     *
+     * @retval false -> invalid port index
+     */
+    bool unmap(uint16_t portIdx);
+
+    /**
+     * @brief set the sACN priority of a gdArtNetToSacn mapping, reported as acnPriority
+     *
+     * @param priority valid range 0:200
+     * @retval false -> invalid port index, priority or direction
+     */
+    bool setAcnPriority(uint16_t portIdx, uint8_t priority);
+
+    /**
+     * @brief replace the component identifier derived from the MAC
+     */
+    void setCid(const uint8_t *newCid);
+
+    /**
+     * @brief handle a packet received on the sACN port, has to be called from a single thread.
+     * packets of the gateway itself (same CID) are ignored
+     *
+     * @param packet pointer to the incoming packet
+     * @param packetLen length of the incoming packet
+     * @param senderIp pointer to the ip of the sender
+     * @param senderIpLen number of bytes in the ip of the sender
+     * @retval psOk -> forwarded, ignored or dropped by the source arbitration (see the counters)
+     * @retval psTooShort / psInvalidContent -> not an E1.31 data packet
+     * @retval psTransmitFailed -> unicast callback missing or failed
+     */
+    packetStatus handleSacnPacket(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen);
+
+    /**
+     * @brief get the counters of the gateway
+     */
+    const gatewayCounters &getGatewayCounters() const {
+        return counters;
+    }
+
+    /**
+     * @brief multicast group of a sACN universe, 239.255.<universe high>.<universe low>
+     */
+    static void sacnMulticastIp(uint16_t universe, uint8_t *ip) {
+        ip[0] = 239;
+        ip[1] = 255;
+        ip[2] = static_cast<uint8_t>(universe >> 8);
+        ip[3] = static_cast<uint8_t>(universe);
+    }
+};
@@ -0,0 +1,126 @@
+/**
+ * @file ArtNetSimd.hpp
+ * @author your name (you@domain.com)
+ * @brief vectorised helpers to process dmx frames, falls back to plain loops without SIMD support
+ * @version 0.1
+ * @date 2026-01-06
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+/**
+ * @brief per slot maximum of two frames (HTP merge)
+ *
+ * @param dst frame to write the result to
+ * @param a first source frame
+ * @param b second source frame
+ * @param len number of slots, has to be a multiple of 16
+ */
+inline void dmxMergeHtp(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint16_t len) {
+
+#if defined(__SSE2__)
+    for (uint16_t i = 0; i < len; i += 16) {
+        __m128i _a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i _b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(_a, _b));
+    }
+#elif defined(__ARM_NEON)
+    for (uint16_t i = 0; i < len; i += 16) {
+        vst1q_u8(dst + i, vmaxq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+#else
+    for (uint16_t i = 0; i < len; i++) {
+        dst[i] = a[i] > b[i] ? a[i] : b[i];
+    }
+#endif
+}
+
+/**
+ * @brief compare two frames
+ *
+ * @param a first frame
+ * @param b second frame
+ * @param len number of slots
+ * @retval true -> all slots are equal
+ * @retval false -> at least one slot differs
+ */
+inline bool dmxFramesEqual(const uint8_t *a, const uint8_t *b, uint16_t len) {
+
+    uint16_t i = 0;
+
+#if defined(__SSE2__)
+    __m128i _diff = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        __m128i _a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i _b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _diff = _mm_or_si128(_diff, _mm_xor_si128(_a, _b));
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_diff, _mm_setzero_si128())) != 0xffff) {
+        return false;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t _diff = vdupq_n_u8(0);
+    for (; i + 16 <= len; i += 16) {
+        _diff = vorrq_u8(_diff, veorq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+    if (vmaxvq_u8(_diff) != 0) {
+        return false;
+    }
+#endif
+
+    uint8_t _tail = 0;
+    for (; i < len; i++) {
+        _tail |= a[i] ^ b[i];
+    }
+    return _tail == 0;
+}
+
+/**
+ * @brief find the next occurrence of a 16 bit value, e.g. a Port-Address in a table of ports
+ *
+ * @param values array to search
+ * @param count number of values in the array
+ * @param value value to find
+ * @param from first index to check
+ * @return index of the next match, count if there is none
+ */
+inline uint32_t findValue16(const uint16_t *values, uint32_t count, uint16_t value, uint32_t from) {
+
+    uint32_t i = from;
+
+#if defined(__SSE2__)
+    __m128i _value = _mm_set1_epi16(static_cast<short>(value));
+    for (; i + 8 <= count; i += 8) {
+        __m128i _block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        int _mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_block, _value));
+        if (_mask != 0) {
+            return i + static_cast<uint32_t>(__builtin_ctz(static_cast<unsigned>(_mask))) / 2;
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint16x8_t _value = vdupq_n_u16(value);
+    for (; i + 8 <= count; i += 8) {
+        if (vmaxvq_u16(vceqq_u16(vld1q_u16(values + i), _value)) != 0) {
+            break;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (values[i] == value) {
+            return i;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file ArtNetWire.hpp
+ * @author your name (you@domain.com)
+ * @brief compile time field descriptors to read and write packets in place with the byte order and bit layout of the wire
+ * @version 0.1
+ * @date 2026-01-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+
+/**
+ * @brief byte order of a multi byte field on the wire
+ */
+enum wireOrder {
+    woLittleEndian  = 0,    //low byte first, e.g. opCode and port
+    woBigEndian     = 1,    //high byte first, e.g. protVer and length
+};
+
+/**
+ * @brief unsigned integer field of a packet
+ *
+ * @tparam fieldOffset offset of the first byte in the packet
+ * @tparam fieldSize number of bytes, 1, 2 or 4
+ * @tparam fieldOrder byte order on the wire
+ */
+template<uint16_t fieldOffset, uint8_t fieldSize, wireOrder fieldOrder = woBigEndian>
+struct wireField {
+    static_assert(fieldSize == 1 || fieldSize == 2 || fieldSize == 4, "wireField supports 1, 2 and 4 byte fields");
+
+    static constexpr uint16_t offset = fieldOffset;
+    static constexpr uint16_t size = fieldSize;
+    static constexpr uint16_t end = fieldOffset + fieldSize;
+
+    typedef typename std::conditional<fieldSize == 1, uint8_t,
+        typename std::conditional<fieldSize == 2, uint16_t, uint32_t>::type>::type valueType;
+
+    /**
+     * @brief read the field, the shifts compile to a single load (plus a byte swap for the foreign order)
+     */
+    static valueType read(const uint8_t *packet) {
+        const uint8_t *_field = packet + fieldOffset;
+        uint32_t _value = 0;
+        for (uint8_t i = 0; i < fieldSize; i++) {
+            uint8_t _shift = fieldOrder == woLittleEndian ? i * 8 : (fieldSize - 1 - i) * 8;
+            _value |= static_cast<uint32_t>(_field[i]) << _shift;
+        }
+        return static_cast<valueType>(_value);
+    }
+
+    /**
+     * @brief write the field in place
+     */
+    static void write(uint8_t *packet, valueType value) {
+        uint8_t *_field = packet + fieldOffset;
+        for (uint8_t i = 0; i < fieldSize; i++) {
+            uint8_t _shift = fieldOrder == woLittleEndian ? i * 8 : (fieldSize - 1 - i) * 8;
+            _field[i] = static_cast<uint8_t>(static_cast<uint32_t>(value) >> _shift);
+        }
+    }
+};
+
+/**
+ * @brief group of bits inside one byte, bits are numbered as in the Art-Net spec (bit 0 = least significant),
+ * independent of the bitfield order of the compiler
+ *
+ * @tparam fieldOffset offset of the (first) byte in the packet
+ * @tparam firstBit lowest bit of the group
+ * @tparam bitCount number of bits
+ * @tparam fieldCount number of consecutive bytes with the same layout, e.g. one per port
+ */
+template<uint16_t fieldOffset, uint8_t firstBit, uint8_t bitCount = 1, uint8_t fieldCount = 1>
+struct wireBits {
+    static_assert(firstBit + bitCount <= 8, "wireBits has to fit into one byte");
+
+    static constexpr uint16_t offset = fieldOffset;
+    static constexpr uint16_t end = fieldOffset + fieldCount;
+    static constexpr uint8_t mask = static_cast<uint8_t>(((1u << bitCount) - 1) << firstBit);
+
+    typedef uint8_t valueType;
+
+    static valueType read(const uint8_t *packet, uint8_t index = 0) {
+        return static_cast<uint8_t>((packet[fieldOffset + index] & mask) >> firstBit);
+    }
+
+    static void write(uint8_t *packet, valueType value, uint8_t index = 0) {
+        uint8_t &_byte = packet[fieldOffset + index];
+        _byte = static_cast<uint8_t>((_byte & ~mask) | ((value << firstBit) & mask));
+    }
+};
+
+/**
+ * @brief byte array of a packet (names, addresses), accessed without copying
+ */
+template<uint16_t fieldOffset, uint16_t fieldLen>
+struct wireBytes {
+    static constexpr uint16_t offset = fieldOffset;
+    static constexpr uint16_t size = fieldLen;
+    static constexpr uint16_t end = fieldOffset + fieldLen;
+
+    static const uint8_t *read(const uint8_t *packet) {
+        return packet + fieldOffset;
+    }
+
+    static uint8_t *write(uint8_t *packet) {
+        return packet + fieldOffset;
+    }
+};
+
+/**
+ * @brief read view of a received packet, every access is checked at compile time against the length of the layout
+ *
+ * @tparam layout wire layout of the packet, has to provide length
+ */
+template<typename layout>
+class wireReader {
+private:
+    const uint8_t *packet;
+
+public:
+    explicit wireReader(const uint8_t *data) : packet(data) {}
+
+    template<typename field>
+    typename field::valueType get() const {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        return field::read(packet);
+    }
+
+    template<typename field>
+    typename field::valueType get(uint8_t index) const {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        return field::read(packet, index);
+    }
+
+    template<typename field>
+    const uint8_t *bytes() const {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        return field::read(packet);
+    }
+
+    const uint8_t *data() const {
+        return packet;
+    }
+};
+
+/**
+ * @brief in place writer of a packet, every access is checked at compile time against the length of the layout
+ *
+ * @tparam layout wire layout of the packet, has to provide length
+ */
+template<typename layout>
+class wireWriter {
+private:
+    uint8_t *packet;
+
+public:
+    explicit wireWriter(uint8_t *data) : packet(data) {}
+
+    template<typename field>
+    void set(typename field::valueType value) {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        field::write(packet, value);
+    }
+
+    template<typename field>
+    void set(uint8_t index, typename field::valueType value) {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        field::write(packet, value, index);
+    }
+
+    template<typename field>
+    uint8_t *bytes() {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        return field::write(packet);
+    }
+
+    /**
+     * @brief copy a string into a fixed size field, always null terminated
+     */
+    template<typename field>
+    void setString(const char *text) {
+        static_assert(field::end <= layout::length, "field is outside of the packet");
+        uint8_t *_field = field::write(packet);
+        size_t _len = strnlen(text, field::size - 1);
+        memcpy(_field, text, _len);
+        memset(_field + _len, 0, field::size - _len);
+    }
+
+    uint8_t *data() {
+        return packet;
+    }
+};
@@ -1,33 +1,90 @@
 #include <ArtNet.hpp>
+#ifndef ARTNET_NO_EXCEPTIONS
 #include <stdexcept>
+#endif
+#include <stddef.h>
+#include <string.h>
 
 ArtNet::ArtNet(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen):oemCode(oemCode){
 
     if (MACLen < macAddressLen){
+#ifdef ARTNET_NO_EXCEPTIONS
+        reportFailure(rcConfigErr);
+#else
         throw std::runtime_error("invalid MAC");
+#endif
     }
 
     for (uint8_t i = 0; i < macAddressLen; i++) {
-        sysConf.macAddress[i] = MAC[i];
+        sysConf.macAddress[i] = i < MACLen ? MAC[i] : 0;
+        replyRandom = replyRandom * 31 + sysConf.macAddress[i];
     }
 
     setDefaultIp();
+
+    for (uint16_t _request = drPoll; _request < cachedDataReplyCount; _request++) {
+        buildDataReply(_request);
+    }
+
+    wireWriter<artDataReplyLayout> _manSpec(manSpecReply);
+    memcpy(_manSpec.bytes<artDataReplyLayout::ident>(), artNetIdent, artNetIdentLen);
+    _manSpec.set<artDataReplyLayout::opCode>(opDataReply);
+    _manSpec.set<artDataReplyLayout::protVer>(protVersion);
+    _manSpec.set<artDataReplyLayout::oemCode>(oemCode);
 };
 
+ArtNet::~ArtNet() {
+}
+
 void ArtNet::updateIp(uint8_t *newAddress, uint8_t newAddressLen){
     
     if (newAddressLen < ipAddressLen) {
+#ifdef ARTNET_NO_EXCEPTIONS
+        reportFailure(rcConfigErr);
+        return;
+#else
         throw std::runtime_error("new address too short");
+#endif
     }
 
     for (uint8_t i = 0; i < ipAddressLen; i++) {
         sysConf.ipAddress[i] = newAddress[i];
     }
+
+    markPollReplyDirty();
+}
+
+void ArtNet::setNetSubSwitch(uint8_t netSwitch, uint8_t subSwitch) {
+    sysConf.netSwitch = netSwitch & 0x7f;
+    sysConf.subSwitch = subSwitch & 0x0f;
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        ports[i].portAddress = static_cast<uint16_t>((sysConf.netSwitch << 8) | (sysConf.subSwitch << 4) | (ports[i].portAddress & 0x0f));
+    }
+
+    markPollReplyDirty();
+}
+
+void ArtNet::setTimeCallback(uint64_t (*callback)(void)) {
+    callback_getMicros = callback;
+}
+
+void ArtNet::setUnicastCallback(bool (*callback)(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort)) {
+    callback_unicast = callback;
+}
+
+void ArtNet::setBatchCallback(uint16_t (*callback)(const txPacket *packets, uint16_t packetCount)) {
+    callback_sendBatch = callback;
+}
+
+void ArtNet::setCaptureCallback(void (*callback)(const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen,
+    uint16_t port)) {
+    callback_capture = callback;
 }
 
 void ArtNet::setDefaultIp() {
 
-    if(callback_readNetSwitch()){
+    if(callback_readNetSwitch != nullptr && callback_readNetSwitch()){
         sysConf.ipAddress[0] = 10;
     }
     else {
@@ -39,112 +96,1007 @@ void ArtNet::setDefaultIp() {
     sysConf.ipAddress[2] = sysConf.macAddress[4];
     sysConf.ipAddress[3] = sysConf.macAddress[5];
 
+    markPollReplyDirty();
+
     /**
      * @TODO: add function to update network stack + subnet mask
      */
 };
 
 
-void ArtNet::handleArtPoll(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) {
+constexpr std::array<ArtNet::dispatchEntry, 256> ArtNet::buildDispatchTable() {
 
-    if(packetLen < minArtPollLen){
-        throw std::runtime_error("packet is too small");
+    constexpr dispatchEntry routes[] = {
+        {opPoll,        minArtPollLen,      true,   &ArtNet::handleArtPoll},
+        {opPollReply,   minArtPollReplyLen, false,  &ArtNet::handleArtPollReply},
+        {opIpProg,      artIpProgPacketLen, true,   &ArtNet::handleArtProg},
+        {opDmx,         minArtDmxLen,       true,   &ArtNet::handleArtDmx},
+        {opSync,        artSyncPacketLen,   true,   &ArtNet::handleArtSync},
+        {opNzs,         minArtNzsLen,       true,   &ArtNet::handleArtNzs},
+        {opTodData,     minArtTodDataLen,   true,   &ArtNet::handleArtTodData},
+        {opRdm,         minArtRdmLen,       true,   &ArtNet::handleArtRdm},
+        {opTimeCode,    artTimeCodePacketLen, true, &ArtNet::handleArtTimeCode},
+        {opTimeSync,    artTimeSyncPacketLen, true, &ArtNet::handleArtTimeSync},
+        {opDataRequest, minArtDataRequestLen, true, &ArtNet::handleArtDataRequest},
+        {opAddress,     artAddressPacketLen, true, &ArtNet::handleArtAddress},
+    };
+
+    std::array<dispatchEntry, 256> table = {};
+
+    for (const dispatchEntry &route : routes) {
+        table[route.opCode >> 8] = route;
     }
 
-    artPollPacket *_packet_ptr = reinterpret_cast <artPollPacket*> (packet);
+    return table;
+}
 
-    if(_packet_ptr->protVer < minProtVersion || _packet_ptr->protVer > protVersion){
-        throw std::runtime_error("protocol version is not supported");
+constexpr std::array<ArtNet::dispatchEntry, 256> ArtNet::dispatchTable = ArtNet::buildDispatchTable();
+
+ArtNet::packetStatus ArtNet::handlePacket(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen, uint16_t port,
+    uint64_t receivedAt) {
+
+    const uint8_t *_data = static_cast<const uint8_t*>(packet);
+
+    if (callback_capture != nullptr) {
+        callback_capture(_data, packetLen, senderIp, senderIpLen, port);
+    }
+
+    counters.received.fetch_add(1, std::memory_order_relaxed);
+
+    if (packetLen < artHeaderLayout::length) {
+        return countStatus(psTooShort);
+    }
+
+    if (memcmp(_data, artNetIdent, artNetIdentLen) != 0) {
+        return countStatus(psInvalidIdent);
+    }
+
+    wireReader<artProtVerLayout> _header(_data);
+    uint16_t _opCode = _header.get<artHeaderLayout::opCode>();
+    const dispatchEntry &_entry = dispatchTable[_opCode >> 8];
+
+    opCodeCounters &_opCounters = counters.byOpCode[_opCode >> 8];
+    _opCounters.packets.fetch_add(1, std::memory_order_relaxed);
+    _opCounters.bytes.fetch_add(packetLen, std::memory_order_relaxed);
+
+    if (_entry.handler == nullptr || _entry.opCode != _opCode) {
+        return countStatus(psUnsupportedOpCode);
     }
 
-    sendArtPollReply(senderIp, senderIpLen);
+    if (packetLen < _entry.minLen) {
+        return countStatus(psTooShort);
+    }
+
+    if (_entry.hasProtVer) {
+        uint16_t _protVer = _header.get<artProtVerLayout::protVer>();
+
+        if (_protVer < minProtVersion) {
+            return countStatus(psUnsupportedVersion);
+        }
+    }
+
+    //timecode keeps the time the transport received it, the handler takes its own otherwise
+    if (receivedAt != 0 && _opCode == opTimeCode) {
+        return countStatus(receiveTimeCode(_data, receivedAt));
+    }
+
+    return countStatus((this->*_entry.handler)(_data, packetLen, senderIp, senderIpLen));
 }
 
+ArtNet::packetScope ArtNet::classifyPacket(const uint8_t *packet, uint16_t packetLen, uint16_t &portAddress) {
 
-void ArtNet::sendArtPollReply(uint8_t *targetIp, uint8_t targetIpLen) {
+    if (packetLen < artHeaderLayout::length || memcmp(packet, artNetIdent, artNetIdentLen) != 0) {
+        return scopeInvalid;
+    }
 
-    ArtPollReplyPacket _packet;
+    wireReader<artDmxLayout> _packet(packet);
+    uint16_t _opCode = _packet.get<artDmxLayout::opCode>();
 
-    for (uint8_t i = 0; i < artNetIdentLen; i++) {
-        _packet.artHeader.ident[i] = artNetIdent[i];
+    if (_opCode == opDmx && packetLen >= minArtDmxLen) {
+        portAddress = _packet.get<artDmxLayout::portAddress>() & 0x7fff;
+        return scopeUniverse;
     }
-    _packet.artHeader.opCode = opPollReply;
-    
-    for (uint8_t i = 0; i < ipAddressLen; i++) {
-         _packet.ipAddress[i] = sysConf.ipAddress[i];
+
+    //timecode only touches the timecode clock, waiting for all receive threads would add latency
+    if (_opCode == opTimeCode) {
+        return scopeTime;
     }
-    _packet.port = artNetPort;
 
-    _packet.versionInfo = libraryVersion;
-    
-   _packet.subSwitch = sysConf.subSwitch;
-   _packet.netSwitch = sysConf.netSwitch;
+    return scopeDevice;
+}
 
-   _packet.oemCode = oemCode;
-    
-   /**
-    * @TODO: finish packing of data -> need to implement other logic first
-    */
+ArtNet::packetStatus ArtNet::handleArtPoll(const uint8_t *packet, uint16_t, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artPollLayout> _poll(packet);
+
+    //diagnostics follow the request of the last controller that polled
+    sysConf.sendDiagostic = _poll.get<artPollLayout::sendDiagMsg>();
+    sysConf.sendDiagAsUnicast = _poll.get<artPollLayout::diagMsgIsUnicast>();
+    sysConf.sendReplyOnChange = _poll.get<artPollLayout::sendReplyOnChange>();
+    sysConf.diagnosticPriority = _poll.get<artPollLayout::diagPriority>();
+
+    //VLC stays enabled unless the polling controller disables it
+    sysConf.VLCActive = !_poll.get<artPollLayout::VLCDisable>();
+
+    if (senderIpLen >= ipAddressLen) {
+        memcpy(diagTargetIp, senderIp, ipAddressLen);
+    }
+
+    if (replyJitterMax == 0 || senderIpLen < ipAddressLen) {
+        return sendArtPollReply(senderIp, senderIpLen) ? psOk : psTransmitFailed;
+    }
+
+    uint64_t _now = getMicros();
+    pendingReply *_free = nullptr;
+
+    for (pendingReply &_pending : pendingReplies) {
 
-    if(!callback_unicast(reinterpret_cast<uint8_t*>(&_packet), sizeof(_packet), targetIp, targetIpLen, artNetPort)){
-        throw std::runtime_error("failed to transmit packet");
+        if (!_pending.used) {
+            _free = _free == nullptr ? &_pending : _free;
+        }
+        else if (memcmp(_pending.targetIp, senderIp, ipAddressLen) == 0) {
+            //a reply to this controller is already scheduled and will carry the latest state
+            return psOk;
+        }
     }
+
+    if (_free == nullptr) {
+        return sendArtPollReply(senderIp, senderIpLen) ? psOk : psTransmitFailed;
+    }
+
+    //xorshift, seeded from the MAC so nodes of the same rig spread differently
+    replyRandom ^= replyRandom << 13;
+    replyRandom ^= replyRandom >> 17;
+    replyRandom ^= replyRandom << 5;
+
+    memcpy(_free->targetIp, senderIp, ipAddressLen);
+    _free->due = _now + (replyRandom % (replyJitterMax * 1000ULL + 1));
+    _free->used = true;
+
+    return psOk;
 }
 
-void ArtNet::handleArtProg(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) {
-    
-    if (packetLen < artIpProgPacketLen) {
-        throw std::runtime_error("packet is too small");
+ArtNet::packetStatus ArtNet::handleArtPollReply(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+    return psUnsupportedOpCode;
+}
+
+ArtNet::packetStatus ArtNet::handleArtDmx(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+    return psUnsupportedOpCode;
+}
+
+ArtNet::packetStatus ArtNet::handleArtSync(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+    return psUnsupportedOpCode;
+}
+
+ArtNet::packetStatus ArtNet::handleArtNzs(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+    return psUnsupportedOpCode;
+}
+
+ArtNet::packetStatus ArtNet::handleArtTodData(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+    return psUnsupportedOpCode;
+}
+
+ArtNet::packetStatus ArtNet::handleArtRdm(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+    return psUnsupportedOpCode;
+}
+
+bool ArtNet::sendArtPollReply(uint8_t *targetIp, uint8_t targetIpLen) {
+
+    //a device without transmit callback reports the failure instead of crashing
+    if (callback_unicast == nullptr) {
+        return false;
+    }
+
+    if (pollReplyDirty.exchange(false, std::memory_order_acq_rel)) {
+        for (uint16_t _page = 0; _page < numPollPages; _page++) {
+            buildPollReply(_page);
+        }
     }
 
-    ArtIpProgPacket *_packet_ptr = reinterpret_cast<ArtIpProgPacket*>(packet);
+    bool _success = true;
+
+    //one reply per page, pages without any configured port are skipped
+    for (uint16_t _page = 0; _page < numPollPages; _page++) {
+
+        bool _used = _page == 0;
+        for (uint16_t i = _page * 4; i < numPorts && i < _page * 4 + 4; i++) {
+            _used |= ports[i].isInput || ports[i].isOutput;
+        }
 
-    if (_packet_ptr->protVersion < minProtVersion || _packet_ptr->protVersion > protVersion) {
-        throw std::runtime_error("protocol version not supported");
+        if (_used) {
+            _success &= callback_unicast(pollReplies[_page].data, sizeof(ArtPollReplyPacket), targetIp, targetIpLen, artNetPort);
+        }
     }
 
-    if (!_packet_ptr->command.programmingEnable){
-        //do I need to reply if no programming is enabled?
+    return _success;
+}
+
+void ArtNet::buildPollReply(uint16_t page) {
+
+    ArtPollReplyPacket &_packet = pollReplies[page];
+    wireWriter<artPollReplyLayout> _reply(_packet.data);
+
+    memset(&_packet, 0, sizeof(_packet));
+
+    memcpy(_reply.bytes<artPollReplyLayout::ident>(), artNetIdent, artNetIdentLen);
+    _reply.set<artPollReplyLayout::opCode>(opPollReply);
+    memcpy(_reply.bytes<artPollReplyLayout::ipAddress>(), sysConf.ipAddress, ipAddressLen);
+    _reply.set<artPollReplyLayout::port>(artNetPort);
+    _reply.set<artPollReplyLayout::versionInfo>(libraryVersion);
+    _reply.set<artPollReplyLayout::oemCode>(oemCode);
+
+    uint8_t _netSwitch = sysConf.netSwitch;
+    uint8_t _subSwitch = sysConf.subSwitch;
+
+    //all ports of a page share net and sub-net, taken from the first configured port
+    for (uint16_t i = page * 4; i < numPorts && i < page * 4 + 4; i++) {
+        if (ports[i].isInput || ports[i].isOutput) {
+            _netSwitch = ports[i].portAddress >> 8;
+            _subSwitch = (ports[i].portAddress >> 4) & 0x0f;
+            break;
+        }
+    }
+
+    _reply.set<artPollReplyLayout::netSwitch>(_netSwitch);
+    _reply.set<artPollReplyLayout::subSwitch>(_subSwitch);
+
+    _reply.set<artPollReplyLayout::indicatorState>(indicator);
+    _reply.set<artPollReplyLayout::portProgAuthority>(ppacNetwork);
+
+    memcpy(_reply.bytes<artPollReplyLayout::portName>(), sysConf.shortName, artPollReplyLayout::portName::size - 1);
+    memcpy(_reply.bytes<artPollReplyLayout::longName>(), sysConf.longName, artPollReplyLayout::longName::size - 1);
+    memcpy(_reply.bytes<artPollReplyLayout::nodeReport>(), sysConf.nodeReport, artPollReplyLayout::nodeReport::size - 1);
+
+    uint8_t _numPorts = 0;
+
+    for (uint8_t i = 0; i < 4 && page * 4 + i < numPorts; i++) {
+
+        const portConfig &_port = ports[page * 4 + i];
+
+        if (_port.isInput || _port.isOutput) {
+            _numPorts = i + 1;
+        }
+
+        _reply.set<artPollReplyLayout::isInput>(i, _port.isInput);
+        _reply.set<artPollReplyLayout::isOutput>(i, _port.isOutput);
+        _reply.set<artPollReplyLayout::portType>(i, ptcDMX512);
+        _reply.bytes<artPollReplyLayout::swIn>()[i] = _port.portAddress & 0x0f;
+        _reply.bytes<artPollReplyLayout::swOut>()[i] = _port.portAddress & 0x0f;
+    }
+
+    _reply.set<artPollReplyLayout::numPorts>(_numPorts);
+
+    _reply.set<artPollReplyLayout::style>(sysConf.deviceStyle);
+    memcpy(_reply.bytes<artPollReplyLayout::MAC>(), sysConf.macAddress, macAddressLen);
+    memcpy(_reply.bytes<artPollReplyLayout::bindIp>(), sysConf.ipAddress, ipAddressLen);
+    _reply.set<artPollReplyLayout::bindIndex>(static_cast<uint8_t>(page + 1));
+
+    _reply.set<artPollReplyLayout::longAddressSupport>(true);
+    _reply.set<artPollReplyLayout::capableOfDHCP>(true);
+    _reply.set<artPollReplyLayout::isDHCPConfigured>(sysConf.dhcpEnabled);
+
+    _reply.set<artPollReplyLayout::refreshRate>(defaultRefreshRate);
+
+    updatePortStatus(_packet, page);
+}
+
+void ArtNet::markPollReplyDirty() {
+    pollReplyDirty.store(true, std::memory_order_release);
+
+    //may run on any receive thread, the reply is scheduled by service()
+    if (sysConf.sendReplyOnChange) {
+        const uint8_t _broadcastIp[ipAddressLen] = {255, 255, 255, 255};
+        requestChangeReply(_broadcastIp);
+    }
+}
+
+void ArtNet::setChangeReplyWindow(uint16_t window) {
+    changeReplyWindow = window;
+}
+
+void ArtNet::requestChangeReply(const uint8_t *targetIp) {
+
+    uint32_t _ip;
+    memcpy(&_ip, targetIp, ipAddressLen);
+
+    //a second receiver turns the reply into a broadcast
+    uint32_t _target = changeReplyTarget.load(std::memory_order_relaxed);
+    uint32_t _merged;
+    do {
+        _merged = (_target == 0 || _target == _ip) ? _ip : 0xffffffff;
+    } while (_merged != _target && !changeReplyTarget.compare_exchange_weak(_target, _merged, std::memory_order_relaxed));
+}
+
+bool ArtNet::scheduleChangeReply(uint32_t target) {
+
+    if (!changeReplyScheduled) {
+        changeReplyIp = target;
+        changeReplyDue = getMicros() + changeReplyWindow * 1000ULL;
+        changeReplyScheduled = true;
+    }
+    else if (changeReplyIp != target) {
+        changeReplyIp = 0xffffffff;
+    }
+
+    if (changeReplyWindow > 0) {
+        return true;
+    }
+
+    changeReplyScheduled = false;
+
+    uint8_t _targetIp[ipAddressLen];
+    memcpy(_targetIp, &changeReplyIp, ipAddressLen);
+    return sendArtPollReply(_targetIp, ipAddressLen);
+}
+
+void ArtNet::setReplyJitter(uint16_t maxDelay) {
+    replyJitterMax = maxDelay;
+}
+
+void ArtNet::service() {
+
+    if (!receiveServiceExternal.load(std::memory_order_acquire)) {
+        serviceReceive();
+    }
+
+    uint64_t _now = getMicros();
+    uint32_t _target = changeReplyTarget.exchange(0, std::memory_order_relaxed);
+
+    if (_target != 0 && !scheduleChangeReply(_target)) {
+        countStatus(psTransmitFailed);
+    }
+
+    if (changeReplyScheduled && _now >= changeReplyDue) {
+        changeReplyScheduled = false;
+
+        uint8_t _targetIp[ipAddressLen];
+        memcpy(_targetIp, &changeReplyIp, ipAddressLen);
+        if (!sendArtPollReply(_targetIp, ipAddressLen)) {
+            countStatus(psTransmitFailed);
+        }
+    }
+
+}
+
+void ArtNet::serviceReceive() {
+
+    //the replies are scheduled by handleArtPoll(), draining them here keeps both on the same side of the barrier
+    if (replyJitterMax == 0) {
         return;
     }
 
+    uint64_t _now = getMicros();
+
+    for (pendingReply &_pending : pendingReplies) {
+
+        if (_pending.used && _now >= _pending.due) {
+            _pending.used = false;
+            if (!sendArtPollReply(_pending.targetIp, ipAddressLen)) {
+                countStatus(psTransmitFailed);
+            }
+        }
+    }
+}
+
+void ArtNet::setReceiveServiceExternal(bool external) {
+    receiveServiceExternal.store(external, std::memory_order_release);
+}
+
+void ArtNet::updatePortStatus(ArtPollReplyPacket &, uint16_t) {
+}
+
+ArtNet::packetStatus ArtNet::handleArtAddress(const uint8_t *packet, uint16_t, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artAddressLayout> _packet(packet);
+    uint8_t _bindIndex = _packet.get<artAddressLayout::bindIndex>();
+    uint16_t _page = _bindIndex > 0 ? _bindIndex - 1 : 0;
+
+    if (_page >= numPollPages || senderIpLen < ipAddressLen) {
+        return psInvalidContent;
+    }
+
+    //stage the new net, sub-net and Port-Addresses of the page, nothing is written before the packet is validated
+    uint16_t _first = _page * 4;
+    uint8_t _netSwitch = sysConf.netSwitch;
+    uint8_t _subSwitch = sysConf.subSwitch;
+
+    for (uint16_t i = _first; i < numPorts && i < _first + 4; i++) {
+        if (ports[i].isInput || ports[i].isOutput) {
+            _netSwitch = ports[i].portAddress >> 8;
+            _subSwitch = (ports[i].portAddress >> 4) & 0x0f;
+            break;
+        }
+    }
+
+    //bit 7 programs the value, 0x7f keeps it, 0x00 returns to the physical switches which the library does not have
+    uint8_t _value = _packet.get<artAddressLayout::netSwitch>();
+    if (_value & 0x80) {
+        _netSwitch = _value & 0x7f;
+    }
+
+    _value = _packet.get<artAddressLayout::subSwitch>();
+    if (_value & 0x80) {
+        _subSwitch = _value & 0x0f;
+    }
+
+    uint16_t _portAddresses[4] = {};
+
+    for (uint16_t i = _first; i < numPorts && i < _first + 4; i++) {
+
+        _value = ports[i].isInput ? _packet.bytes<artAddressLayout::swIn>()[i - _first] : _packet.bytes<artAddressLayout::swOut>()[i - _first];
+        uint8_t _universe = (_value & 0x80) ? (_value & 0x0f) : (ports[i].portAddress & 0x0f);
+
+        _portAddresses[i - _first] = static_cast<uint16_t>((_netSwitch << 8) | (_subSwitch << 4) | _universe);
+    }
+
+    //commit, names are only changed if the packet carries one
+    const uint8_t *_portName = _packet.bytes<artAddressLayout::portName>();
+    if (_portName[0] != 0) {
+        memcpy(sysConf.shortName, _portName, sizeof(sysConf.shortName) - 1);
+        sysConf.shortName[sizeof(sysConf.shortName) - 1] = 0;
+    }
+
+    const uint8_t *_longName = _packet.bytes<artAddressLayout::longName>();
+    if (_longName[0] != 0) {
+        memcpy(sysConf.longName, _longName, sizeof(sysConf.longName) - 1);
+        sysConf.longName[sizeof(sysConf.longName) - 1] = 0;
+    }
+
+    //the root page also holds the net and sub-net of the device
+    if (_page == 0) {
+        sysConf.netSwitch = _netSwitch;
+        sysConf.subSwitch = _subSwitch;
+    }
+
+    for (uint16_t i = _first; i < numPorts && i < _first + 4; i++) {
+        ports[i].portAddress = _portAddresses[i - _first];
+    }
+
+    //255 keeps the priority, other values above the sACN range are invalid
+    uint8_t _acnPriority = _packet.get<artAddressLayout::acnPriority>();
+    if (_acnPriority <= maxAcnPriority) {
+        applyAcnPriority(_acnPriority, _page);
+    }
+
+    applyAddressCommand(_packet.get<artAddressLayout::command>(), _page);
+    portsChanged();
+
+    //not through markPollReplyDirty(), the reply to the sender already announces the change
+    pollReplyDirty.store(true, std::memory_order_release);
+
+    //ArtAddress is always answered, bursts of a console are merged by the change reply window of service()
+    if (changeReplyWindow > 0) {
+        requestChangeReply(senderIp);
+    }
+    else if (!sendArtPollReply(senderIp, ipAddressLen)) {
+        return psTransmitFailed;
+    }
+
+    return psOk;
+}
+
+void ArtNet::applyAcnPriority(uint8_t, uint16_t) {
+}
+
+void ArtNet::applyAddressCommand(uint8_t command, uint16_t) {
+
+    switch (command) {
+        case acLedNormal:
+            indicator = isNormal;
+            break;
+        case acLedMute:
+            indicator = isMute;
+            break;
+        case acLedLocate:
+            indicator = isLocate;
+            break;
+        default:
+            break;
+    }
+}
+
+void ArtNet::portsChanged() {
+}
+
+void ArtNet::setPortStorage(portConfig *portStorage, uint16_t portCount, ArtPollReplyPacket *replyStorage) {
+
+    ports = portStorage;
+    numPorts = portCount;
+    pollReplies = replyStorage;
+    numPollPages = static_cast<uint16_t>((portCount + 3) / 4);
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        ports[i].portAddress = static_cast<uint16_t>((sysConf.netSwitch << 8) | (sysConf.subSwitch << 4));
+        ports[i].isInput = false;
+        ports[i].isOutput = false;
+    }
+
+    markPollReplyDirty();
+}
+
+ArtNet::packetStatus ArtNet::handleArtProg(const uint8_t *packet, uint16_t, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artIpProgLayout> _packet(packet);
+    uint8_t _address[ipAddressLen];
+
+    if (!_packet.get<artIpProgLayout::programmingEnable>()){
+        //do I need to reply if no programming is enabled?
+        return psOk;
+    }
+
     //actually start programming
-    if (_packet_ptr->command.progDefaultGateWay) {
-        callback_updateGateWay(_packet_ptr->progDg, sizeof(_packet_ptr->progDg));
+    if (_packet.get<artIpProgLayout::progDefaultGateWay>() && callback_updateGateWay != nullptr) {
+        memcpy(_address, _packet.bytes<artIpProgLayout::progDg>(), ipAddressLen);
+        callback_updateGateWay(_address, ipAddressLen);
     }
 
-    if(_packet_ptr->command.programIpAddress) {
-        callback_updateIpAddress(_packet_ptr->progIp, sizeof(_packet_ptr->progIp));
+    if(_packet.get<artIpProgLayout::programIpAddress>() && callback_updateIpAddress != nullptr) {
+        memcpy(_address, _packet.bytes<artIpProgLayout::progIp>(), ipAddressLen);
+        callback_updateIpAddress(_address, ipAddressLen);
     }
 
-    if(_packet_ptr->command.programSubNetMask) {
-        callback_updateSubNetMask(_packet_ptr->progSm, sizeof(_packet_ptr->progSm));
+    if(_packet.get<artIpProgLayout::programSubNetMask>() && callback_updateSubNetMask != nullptr) {
+        memcpy(_address, _packet.bytes<artIpProgLayout::progSm>(), ipAddressLen);
+        callback_updateSubNetMask(_address, ipAddressLen);
     }
     
-    if(_packet_ptr->command.resetToDefault){
+    if(_packet.get<artIpProgLayout::resetToDefault>()){
         setDefaultIp();
     }
 
-    enableDHCP(_packet_ptr->command.dhcpEnable);
+    enableDHCP(_packet.get<artIpProgLayout::dhcpEnable>());
     
     if(!sendArtIpProgReply(senderIp, senderIpLen)){
-        throw std::runtime_error("failed to transmit reply");
+        return psTransmitFailed;
     }
+
+    return psOk;
 }
 
 bool ArtNet::sendArtIpProgReply(uint8_t *targetIp, uint8_t targetIpLen) {
-    ArtIpProgReply _packet;
 
-    for (uint8_t i = 0; i < artNetIdentLen; i++) {
-        _packet.artHeader.ident[i] = artNetIdent[i];
+    if (callback_unicast == nullptr) {
+        return false;
+    }
+
+    uint8_t _data[artIpProgReplyLayout::length] = {};
+    wireWriter<artIpProgReplyLayout> _packet(_data);
+
+    memcpy(_packet.bytes<artIpProgReplyLayout::ident>(), artNetIdent, artNetIdentLen);
+    _packet.set<artIpProgReplyLayout::opCode>(opIpProgReply);
+    _packet.set<artIpProgReplyLayout::protVer>(protVersion);
+    _packet.set<artIpProgReplyLayout::dhcpEnabled>(sysConf.dhcpEnabled);
+
+    if (callback_getNetworkConf != nullptr) {
+        callback_getNetworkConf(_packet.bytes<artIpProgReplyLayout::progIp>(), _packet.bytes<artIpProgReplyLayout::progSm>(),
+            _packet.bytes<artIpProgReplyLayout::progDg>(), ipAddressLen);
+    }
+
+    return callback_unicast(_data, sizeof(_data), targetIp, targetIpLen ,artNetPort);
+}
+
+uint8_t *ArtNet::dataRequestUrl(uint16_t request) {
+    switch (request) {
+        case drUrlProduct:
+            return sysConf.urlProduct;
+        case drUrlUserGuide:
+            return sysConf.urlUserGuide;
+        case drUrlSupport:
+            return sysConf.urlSupport;
+        case drUrlPersUdr:
+            return sysConf.urlPersUdr;
+        case drUrlPersGdtf:
+            return sysConf.urlPersGdtf;
+        default:
+            return nullptr;
+    }
+}
+
+void ArtNet::buildDataReply(uint16_t request) {
+    dataReplyImage &_image = dataReplies[request];
+    wireWriter<artDataReplyLayout> _reply(_image.data);
+    const uint8_t *_url = dataRequestUrl(request);
+    uint16_t _payloadLen = 0;
+
+    memset(_image.data, 0, sizeof(_image.data));
+    memcpy(_reply.bytes<artDataReplyLayout::ident>(), artNetIdent, artNetIdentLen);
+    _reply.set<artDataReplyLayout::opCode>(opDataReply);
+    _reply.set<artDataReplyLayout::protVer>(protVersion);
+    _reply.set<artDataReplyLayout::oemCode>(oemCode);
+    _reply.set<artDataReplyLayout::request>(request);
+
+    //the URL is sent with its null terminator, drPoll has no payload
+    if (_url != nullptr) {
+        _payloadLen = static_cast<uint16_t>(strnlen(reinterpret_cast<const char *>(_url), maxUrlLen - 1) + 1);
+        memcpy(_reply.bytes<artDataReplyLayout::payload>(), _url, _payloadLen - 1);
+    }
+
+    _reply.set<artDataReplyLayout::payloadLen>(_payloadLen);
+    _image.length = static_cast<uint16_t>(artDataReplyPacketLen + _payloadLen);
+}
+
+bool ArtNet::setUrl(uint16_t request, const char *url) {
+    uint8_t *_url = dataRequestUrl(request);
+
+    if (_url == nullptr || url == nullptr) {
+        return false;
+    }
+
+    memset(_url, 0, maxUrlLen);
+    strncpy(reinterpret_cast<char *>(_url), url, maxUrlLen - 1);
+    buildDataReply(request);
+
+    return true;
+}
+
+void ArtNet::setDataRequestCallback(int32_t (*callback)(uint16_t request, uint8_t *payload, uint16_t maxPayloadLen)) {
+    callback_dataRequest = callback;
+}
+
+ArtNet::packetStatus ArtNet::handleArtDataRequest(const uint8_t *packet, uint16_t, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artDataRequestLayout> _packet(packet);
+    uint16_t _oemCode = _packet.get<artDataRequestLayout::oemCode>();
+    uint16_t _request = _packet.get<artDataRequestLayout::request>();
+
+    if (_oemCode != oemCode && _oemCode != 0xffff) {
+        return psOk;
+    }
+
+    if (callback_unicast == nullptr) {
+        return psTransmitFailed;
     }
-    _packet.artHeader.opCode = opIpProgReply;
-    _packet.protVersion = protVersion;
-    _packet.status.dhcpEnabled = sysConf.dhcpEnabled;
 
-    callback_getNetworkConf(_packet.progIp, _packet.progSm, _packet.progDg, ipAddressLen);
+    if (_request < cachedDataReplyCount) {
+        if (!callback_unicast(dataReplies[_request].data, dataReplies[_request].length, senderIp, senderIpLen, artNetPort)) {
+            return psTransmitFailed;
+        }
+        return psOk;
+    }
+
+    if (_request < drStartManSpec || callback_dataRequest == nullptr) {
+        return psOk;
+    }
+
+    wireWriter<artDataReplyLayout> _reply(manSpecReply);
+    int32_t _payloadLen = callback_dataRequest(_request, _reply.bytes<artDataReplyLayout::payload>(), maxArtDataReplyPayloadLen);
+
+    if (_payloadLen < 0) {
+        return psOk;
+    }
+    if (_payloadLen > maxArtDataReplyPayloadLen) {
+        _payloadLen = maxArtDataReplyPayloadLen;
+    }
+
+    _reply.set<artDataReplyLayout::request>(_request);
+    _reply.set<artDataReplyLayout::payloadLen>(static_cast<uint16_t>(_payloadLen));
+
+    if (!callback_unicast(manSpecReply, static_cast<uint16_t>(artDataReplyPacketLen + _payloadLen), senderIp, senderIpLen, artNetPort)) {
+        return psTransmitFailed;
+    }
+
+    return psOk;
+}
 
-    return callback_unicast(reinterpret_cast<uint8_t*>(&_packet), sizeof(_packet), targetIp, targetIpLen ,artNetPort);
+void ArtNet::getMetrics(metricsSnapshot &snapshot) const {
+
+    snapshot.received = counters.received.load(std::memory_order_relaxed);
+
+    for (uint8_t i = 0; i < psCount; i++) {
+        snapshot.byStatus[i] = counters.byStatus[i].load(std::memory_order_relaxed);
+    }
+
+    for (uint8_t i = 0; i < reportCodeCount; i++) {
+        snapshot.byReportCode[i] = counters.byReportCode[i].load(std::memory_order_relaxed);
+    }
+
+    for (uint16_t i = 0; i < 256; i++) {
+        snapshot.opCodePackets[i] = counters.byOpCode[i].packets.load(std::memory_order_relaxed);
+        snapshot.opCodeBytes[i] = counters.byOpCode[i].bytes.load(std::memory_order_relaxed);
+    }
+}
+
+void ArtNet::reportFailure(nodeReportCodes code) {
+
+    if (code < reportCodeCount) {
+        counters.byReportCode[code].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool ArtNet::sendDiagData(uint8_t priority, uint8_t logicalPort, const char *text) {
+
+    if (!sysConf.sendDiagostic || priority < sysConf.diagnosticPriority || callback_unicast == nullptr) {
+        return false;
+    }
+
+    uint8_t _data[artDiagDataLayout::length] = {};
+    wireWriter<artDiagDataLayout> _packet(_data);
+
+    memcpy(_packet.bytes<artDiagDataLayout::ident>(), artNetIdent, artNetIdentLen);
+    _packet.set<artDiagDataLayout::opCode>(opDiagData);
+    _packet.set<artDiagDataLayout::protVer>(protVersion);
+    _packet.set<artDiagDataLayout::diagPriority>(priority);
+    _packet.set<artDiagDataLayout::logicalPort>(logicalPort);
+
+    //the length includes the terminating null
+    uint16_t _textLen = static_cast<uint16_t>(strnlen(text, maxDiagDataLen - 1));
+    memcpy(_packet.bytes<artDiagDataLayout::data>(), text, _textLen);
+    _packet.set<artDiagDataLayout::dataLength>(_textLen + 1);
+
+    uint8_t _broadcastIp[ipAddressLen] = {255, 255, 255, 255};
+    uint8_t *_targetIp = sysConf.sendDiagAsUnicast ? diagTargetIp : _broadcastIp;
+
+    return callback_unicast(_data, artDiagDataHeaderLen + _textLen + 1, _targetIp, ipAddressLen, artNetPort);
+}
+
+bool ArtNet::sendTimeCode(const timeCode &tc, uint8_t *targetIp, uint8_t targetIpLen) {
+
+    if (callback_unicast == nullptr) {
+        return false;
+    }
+
+    uint8_t _data[artTimeCodeLayout::length] = {};
+    wireWriter<artTimeCodeLayout> _packet(_data);
+
+    memcpy(_packet.bytes<artTimeCodeLayout::ident>(), artNetIdent, artNetIdentLen);
+    _packet.set<artTimeCodeLayout::opCode>(opTimeCode);
+    _packet.set<artTimeCodeLayout::protVer>(protVersion);
+    _packet.set<artTimeCodeLayout::streamId>(tc.streamId);
+    _packet.set<artTimeCodeLayout::frames>(tc.frames);
+    _packet.set<artTimeCodeLayout::seconds>(tc.seconds);
+    _packet.set<artTimeCodeLayout::minutes>(tc.minutes);
+    _packet.set<artTimeCodeLayout::hours>(tc.hours);
+    _packet.set<artTimeCodeLayout::type>(tc.type);
+
+    uint8_t _broadcastIp[ipAddressLen] = {255, 255, 255, 255};
+
+    if (targetIp == nullptr || targetIpLen < ipAddressLen) {
+        return callback_unicast(_data, sizeof(_data), _broadcastIp, ipAddressLen, artNetPort);
+    }
+
+    return callback_unicast(_data, sizeof(_data), targetIp, targetIpLen, artNetPort);
+}
+
+void ArtNet::setTimeCodeCallback(void (*callback)(const timeCode &tc, uint64_t receivedAt)) {
+    callback_timeCode = callback;
+}
+
+void ArtNet::setTimeSyncCallback(void (*callback)(const wallClock &clock, uint64_t receivedAt)) {
+    callback_timeSync = callback;
+}
+
+void ArtNet::setTimeCodeSource(uint8_t streamId, uint16_t holdTime) {
+    timeCodeStream = streamId;
+    timeCodeHoldTime = holdTime * 1000ULL;
+}
+
+ArtNet::packetStatus ArtNet::handleArtTimeCode(const uint8_t *packet, uint16_t, uint8_t *, uint8_t) {
+    return receiveTimeCode(packet, getMicros());
+}
+
+ArtNet::packetStatus ArtNet::receiveTimeCode(const uint8_t *packet, uint64_t receivedAt) {
+
+    wireReader<artTimeCodeLayout> _packet(packet);
+
+    timeCode _tc;
+    _tc.hours = _packet.get<artTimeCodeLayout::hours>();
+    _tc.minutes = _packet.get<artTimeCodeLayout::minutes>();
+    _tc.seconds = _packet.get<artTimeCodeLayout::seconds>();
+    _tc.frames = _packet.get<artTimeCodeLayout::frames>();
+    _tc.type = _packet.get<artTimeCodeLayout::type>();
+    _tc.streamId = _packet.get<artTimeCodeLayout::streamId>();
+
+    if (_tc.type >= timeCodeTypeCount || _tc.hours > 23 || _tc.minutes > 59 || _tc.seconds > 59 ||
+        _tc.frames >= timeCodeRates[_tc.type]) {
+        return psInvalidContent;
+    }
+
+    if (_tc.streamId == timeCodeStream) {
+        disciplineClock(_tc, receivedAt);
+    }
+
+    if (callback_timeCode != nullptr) {
+        callback_timeCode(_tc, receivedAt);
+    }
+
+    return psOk;
+}
+
+ArtNet::packetStatus ArtNet::handleArtTimeSync(const uint8_t *packet, uint16_t, uint8_t *, uint8_t) {
+
+    if (callback_timeSync == nullptr) {
+        return psUnsupportedOpCode;
+    }
+
+    uint64_t _receivedAt = getMicros();
+    wireReader<artTimeSyncLayout> _packet(packet);
+
+    wallClock _clock;
+    _clock.year = static_cast<uint16_t>(_packet.get<artTimeSyncLayout::year>() + 1900);
+    _clock.month = static_cast<uint8_t>(_packet.get<artTimeSyncLayout::month>() + 1);
+    _clock.day = _packet.get<artTimeSyncLayout::day>();
+    _clock.weekDay = _packet.get<artTimeSyncLayout::weekDay>();
+    _clock.hours = _packet.get<artTimeSyncLayout::hours>();
+    _clock.minutes = _packet.get<artTimeSyncLayout::minutes>();
+    _clock.seconds = _packet.get<artTimeSyncLayout::seconds>();
+    _clock.daylightSaving = _packet.get<artTimeSyncLayout::daylightSaving>() != 0;
+    _clock.program = _packet.get<artTimeSyncLayout::prog>() == timeSyncProgram;
+
+    if (_clock.month > 12 || _clock.day > 31 || _clock.hours > 23 || _clock.minutes > 59 || _clock.seconds > 60) {
+        return psInvalidContent;
+    }
+
+    callback_timeSync(_clock, _receivedAt);
+
+    return psOk;
+}
+
+void ArtNet::disciplineClock(const timeCode &tc, uint64_t receivedAt) {
+
+    timeCodeClock &_clock = timeClock;
+    int64_t _value = timeCodeFramesToMicros(timeCodeToFrames(tc), tc.type);
+    int64_t _relockError = timeCodeFramesToMicros(timeCodeRelockFrames, tc.type);
+
+    timeClockSequence.fetch_add(1, std::memory_order_acq_rel);
+
+    uint64_t _gap = receivedAt - _clock.lastReceived;
+    bool _relock = !_clock.stats.locked || tc.type != _clock.type || _gap > timeCodeHoldTime;
+
+    if (!_relock) {
+
+        int64_t _predicted = predictClock(_clock, receivedAt);
+        int64_t _error = wrapTimeCodeDiff(_value - _predicted, tc.type);
+
+        if (_error > _relockError || _error < -_relockError) {
+            _relock = true;
+        }
+        else {
+            int64_t _elapsed = static_cast<int64_t>(receivedAt - _clock.baseTime);
+
+            _clock.baseValue = _predicted + _error / timeCodePhaseGain;
+            _clock.baseTime = receivedAt;
+
+            if (_elapsed > 0) {
+                int64_t _skew = _clock.skew + _error * 1000000000 / _elapsed / timeCodeRateGain;
+                _skew = _skew > maxTimeCodeSkew ? maxTimeCodeSkew : _skew;
+                _clock.skew = _skew < -maxTimeCodeSkew ? -maxTimeCodeSkew : _skew;
+                _clock.stats.skew = static_cast<int32_t>(_clock.skew / 1000);
+            }
+
+            //deviation of the packet spacing from the spacing of the timecode, smoothed as in RFC 3550
+            int64_t _deviation = static_cast<int64_t>(_gap) - wrapTimeCodeDiff(_value - _clock.lastValue, tc.type);
+            uint32_t _absDeviation = static_cast<uint32_t>(_deviation < 0 ? -_deviation : _deviation);
+
+            _clock.jitterScaled += _absDeviation - (_clock.jitterScaled + 8) / 16;
+            _clock.stats.maxJitter = _absDeviation > _clock.stats.maxJitter ? _absDeviation : _clock.stats.maxJitter;
+            _clock.stats.phaseError = static_cast<int32_t>(_error);
+
+            if (_gap > static_cast<uint64_t>(timeCodeFramesToMicros(timeCodeDropOutFrames, tc.type))) {
+                _clock.stats.dropOuts++;
+            }
+        }
+    }
+
+    if (_relock) {
+        _clock.baseTime = receivedAt;
+        _clock.baseValue = _value;
+        _clock.type = tc.type;
+        _clock.skew = 0;
+        _clock.stats.skew = 0;
+        _clock.stats.phaseError = 0;
+        _clock.stats.locked = true;
+        _clock.stats.relocks++;
+    }
+
+    _clock.streamId = tc.streamId;
+    _clock.lastReceived = receivedAt;
+    _clock.lastValue = _value;
+    _clock.stats.received++;
+
+    timeClockSequence.fetch_add(1, std::memory_order_release);
+}
+
+void ArtNet::readClock(timeCodeClock &clock) const {
+
+    uint32_t _sequence;
+
+    do {
+        _sequence = timeClockSequence.load(std::memory_order_acquire);
+        clock = timeClock;
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((_sequence & 1) || _sequence != timeClockSequence.load(std::memory_order_relaxed));
+}
+
+int64_t ArtNet::predictClock(const timeCodeClock &clock, uint64_t now) {
+
+    int64_t _elapsed = static_cast<int64_t>(now - clock.baseTime);
+    int64_t _value = clock.baseValue + _elapsed + _elapsed * clock.skew / 1000000000;
+    int64_t _day = timeCodeFramesToMicros(timeCodeFramesPerDay(clock.type), clock.type);
+
+    _value %= _day;
+    return _value < 0 ? _value + _day : _value;
+}
+
+int64_t ArtNet::wrapTimeCodeDiff(int64_t difference, uint8_t type) {
+
+    int64_t _day = timeCodeFramesToMicros(timeCodeFramesPerDay(type), type);
+
+    if (difference > _day / 2) {
+        return difference - _day;
+    }
+    if (difference < -_day / 2) {
+        return difference + _day;
+    }
+    return difference;
+}
+
+bool ArtNet::getTimeCode(timeCode &tc, uint32_t &frameOffset) const {
+
+    timeCodeClock _clock;
+    readClock(_clock);
+
+    uint64_t _now = getMicros();
+
+    if (!_clock.stats.locked || _now - _clock.lastReceived > timeCodeHoldTime) {
+        return false;
+    }
+
+    int64_t _value = predictClock(_clock, _now);
+    uint32_t _frames = static_cast<uint32_t>(static_cast<uint64_t>(_value) * timeCodePeriodFrames[_clock.type] /
+        timeCodePeriodMicros[_clock.type]);
+
+    framesToTimeCode(_frames, _clock.type, tc);
+    tc.streamId = _clock.streamId;
+    frameOffset = static_cast<uint32_t>(_value - timeCodeFramesToMicros(_frames, _clock.type));
+
+    return true;
+}
+
+void ArtNet::getTimeCodeStats(timeCodeStats &stats) const {
+
+    timeCodeClock _clock;
+    readClock(_clock);
+
+    stats = _clock.stats;
+    stats.jitter = _clock.jitterScaled / 16;
+}
+
+uint32_t ArtNet::timeCodeToFrames(const timeCode &tc) {
+
+    uint32_t _minutes = tc.hours * 60u + tc.minutes;
+    uint32_t _frames = (_minutes * 60u + tc.seconds) * timeCodeRates[tc.type] + tc.frames;
+
+    if (tc.type == ttDropFrame) {
+        _frames -= 2 * (_minutes - _minutes / 10);
+    }
+
+    return _frames;
+}
+
+void ArtNet::framesToTimeCode(uint32_t frames, uint8_t type, timeCode &tc) {
+
+    frames %= timeCodeFramesPerDay(type);
+
+    if (type == ttDropFrame) {
+        //17982 frames per ten minutes, 1798 per minute without label 0 and 1
+        uint32_t _tens = frames / 17982;
+        uint32_t _rest = frames % 17982;
+        frames += 18 * _tens + (_rest >= 2 ? 2 * ((_rest - 2) / 1798) : 0);
+    }
+
+    uint8_t _rate = timeCodeRates[type];
+
+    tc.frames = static_cast<uint8_t>(frames % _rate);
+    tc.seconds = static_cast<uint8_t>(frames / _rate % 60);
+    tc.minutes = static_cast<uint8_t>(frames / _rate / 60 % 60);
+    tc.hours = static_cast<uint8_t>(frames / _rate / 3600);
+    tc.type = type;
+}
+
+uint32_t ArtNet::timeCodeFramesPerDay(uint8_t type) {
+
+    uint32_t _frames = 24u * 3600u * timeCodeRates[type];
+    return type == ttDropFrame ? _frames - 2 * (24u * 60u - 24u * 6u) : _frames;
 }
 
 bool ArtNet::isConfigured() {
@@ -158,4 +1110,12 @@ bool ArtNet::isConfigured() {
     }
 
     return true;
+}
+
+void ArtNet::enableDHCP(bool enable) {
+
+    if (sysConf.dhcpEnabled != enable) {
+        sysConf.dhcpEnabled = enable;
+        markPollReplyDirty();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include <ArtNetCapture.hpp>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+uint64_t monotonicNanos() {
+    timespec _now;
+    clock_gettime(CLOCK_MONOTONIC, &_now);
+    return static_cast<uint64_t>(_now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(_now.tv_nsec);
+}
+
+}
+
+constexpr uint8_t ArtNetCapture::magic[magicLen];
+
+std::atomic<uint8_t*> ArtNetCapture::file{nullptr};
+uint64_t ArtNetCapture::capacity = 0;
+uint64_t ArtNetCapture::startTime = 0;
+int ArtNetCapture::fileFd = -1;
+std::atomic<uint64_t> ArtNetCapture::writeOffset{0};
+std::atomic<uint32_t> ArtNetCapture::recorded{0};
+std::atomic<uint32_t> ArtNetCapture::dropped{0};
+
+bool ArtNetCapture::open(const char *path, uint64_t maxSize) {
+
+    close();
+
+    if (maxSize < fileHeaderLen) {
+        return false;
+    }
+
+    int _fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (_fd < 0) {
+        return false;
+    }
+
+    if (ftruncate(_fd, static_cast<off_t>(maxSize)) != 0) {
+        ::close(_fd);
+        return false;
+    }
+
+    void *_mapping = mmap(nullptr, maxSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (_mapping == MAP_FAILED) {
+        ::close(_fd);
+        return false;
+    }
+
+    //written once up front so recording never takes a page fault on the receive path
+    memset(_mapping, 0, maxSize);
+
+    uint8_t *_file = static_cast<uint8_t*>(_mapping);
+    capacity = maxSize;
+    fileFd = _fd;
+    writeOffset.store(fileHeaderLen, std::memory_order_relaxed);
+    recorded.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+
+    timespec _realTime;
+    clock_gettime(CLOCK_REALTIME, &_realTime);
+    uint64_t _start = static_cast<uint64_t>(_realTime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(_realTime.tv_nsec);
+
+    wireWriter<fileHeaderLayout> _header(_file);
+    memcpy(_header.bytes<fileHeaderLayout::magic>(), magic, magicLen);
+    _header.set<fileHeaderLayout::version>(fileVersion);
+    _header.set<fileHeaderLayout::startTimeLow>(static_cast<uint32_t>(_start));
+    _header.set<fileHeaderLayout::startTimeHigh>(static_cast<uint32_t>(_start >> 32));
+
+    startTime = monotonicNanos();
+
+    //published last, a receive thread which sees the file also sees the header and the start time
+    file.store(_file, std::memory_order_release);
+
+    return true;
+}
+
+void ArtNetCapture::close() {
+
+    uint8_t *_file = file.load(std::memory_order_acquire);
+
+    if (_file == nullptr) {
+        return;
+    }
+
+    uint64_t _used = writeOffset.load(std::memory_order_acquire);
+    uint64_t _recordBytes = _used - fileHeaderLen;
+
+    wireWriter<fileHeaderLayout> _header(_file);
+    _header.set<fileHeaderLayout::recordBytesLow>(static_cast<uint32_t>(_recordBytes));
+    _header.set<fileHeaderLayout::recordBytesHigh>(static_cast<uint32_t>(_recordBytes >> 32));
+    _header.set<fileHeaderLayout::recordCount>(recorded.load(std::memory_order_relaxed));
+
+    file.store(nullptr, std::memory_order_release);
+    munmap(_file, capacity);
+
+    if (ftruncate(fileFd, static_cast<off_t>(_used)) != 0) {
+        //the file keeps its full size, the header still limits the records
+    }
+
+    ::close(fileFd);
+    fileFd = -1;
+}
+
+void ArtNetCapture::record(const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen, uint16_t port) {
+
+    if (file.load(std::memory_order_acquire) != nullptr) {
+        append(monotonicNanos() - startTime, packet, packetLen, senderIp, senderIpLen, port);
+    }
+}
+
+bool ArtNetCapture::append(uint64_t timestamp, const uint8_t *packet, uint16_t packetLen, const uint8_t *senderIp, uint8_t senderIpLen,
+    uint16_t port) {
+
+    uint8_t *_file = file.load(std::memory_order_acquire);
+
+    if (_file == nullptr) {
+        return false;
+    }
+
+    uint32_t _size = recordSize(packetLen);
+    uint64_t _offset = writeOffset.load(std::memory_order_relaxed);
+
+    //several receive threads reserve their records without a lock
+    do {
+        if (_offset + _size > capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!writeOffset.compare_exchange_weak(_offset, _offset + _size, std::memory_order_relaxed));
+
+    uint8_t *_record = _file + _offset;
+    wireWriter<recordLayout> _header(_record);
+
+    _header.set<recordLayout::timestampLow>(static_cast<uint32_t>(timestamp));
+    _header.set<recordLayout::timestampHigh>(static_cast<uint32_t>(timestamp >> 32));
+    _header.set<recordLayout::packetLen>(packetLen);
+    _header.set<recordLayout::port>(port);
+
+    uint8_t *_ip = _header.bytes<recordLayout::senderIp>();
+    for (uint8_t i = 0; i < 4; i++) {
+        _ip[i] = senderIp != nullptr && i < senderIpLen ? senderIp[i] : 0;
+    }
+
+    memcpy(_record + recordHeaderLen, packet, packetLen);
+    memset(_record + recordHeaderLen + packetLen, 0, _size - recordHeaderLen - packetLen);
+
+    recorded.fetch_add(1, std::memory_order_release);
+
+    return true;
+}
+
+ArtNetCapture::captureCounters ArtNetCapture::getCounters() {
+
+    captureCounters _counters;
+    _counters.recorded = recorded.load(std::memory_order_relaxed);
+    _counters.dropped = dropped.load(std::memory_order_relaxed);
+    _counters.bytes = writeOffset.load(std::memory_order_relaxed) - fileHeaderLen;
+
+    return _counters;
+}
+
+ArtNetReplay::~ArtNetReplay() {
+    close();
+}
+
+bool ArtNetReplay::open(const char *path) {
+
+    close();
+
+    int _fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) {
+        return false;
+    }
+
+    struct stat _info;
+    if (fstat(_fd, &_info) != 0 || static_cast<uint64_t>(_info.st_size) < ArtNetCapture::fileHeaderLen) {
+        ::close(_fd);
+        return false;
+    }
+
+    void *_mapping = mmap(nullptr, static_cast<size_t>(_info.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, _fd, 0);
+    ::close(_fd);
+
+    if (_mapping == MAP_FAILED) {
+        return false;
+    }
+
+    file = static_cast<uint8_t*>(_mapping);
+    fileSize = static_cast<uint64_t>(_info.st_size);
+
+    wireReader<ArtNetCapture::fileHeaderLayout> _header(file);
+    recordBytes = _header.get<ArtNetCapture::fileHeaderLayout::recordBytesLow>() |
+        static_cast<uint64_t>(_header.get<ArtNetCapture::fileHeaderLayout::recordBytesHigh>()) << 32;
+    recordCount = _header.get<ArtNetCapture::fileHeaderLayout::recordCount>();
+
+    if (memcmp(_header.bytes<ArtNetCapture::fileHeaderLayout::magic>(), ArtNetCapture::magic, ArtNetCapture::magicLen) != 0 ||
+        _header.get<ArtNetCapture::fileHeaderLayout::version>() != ArtNetCapture::fileVersion ||
+        recordBytes > fileSize - ArtNetCapture::fileHeaderLen) {
+        close();
+        return false;
+    }
+
+    //replay reads the file once from front to back
+    madvise(file, fileSize, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+void ArtNetReplay::close() {
+
+    if (file != nullptr) {
+        munmap(file, fileSize);
+    }
+
+    file = nullptr;
+    fileSize = 0;
+    recordBytes = 0;
+    recordCount = 0;
+}
+
+uint64_t ArtNetReplay::getDuration() const {
+
+    uint64_t _first = 0;
+    uint64_t _last = 0;
+    uint64_t _offset = 0;
+
+    while (_offset + ArtNetCapture::recordHeaderLen <= recordBytes) {
+
+        wireReader<ArtNetCapture::recordLayout> _record(file + ArtNetCapture::fileHeaderLen + _offset);
+        uint64_t _timestamp = _record.get<ArtNetCapture::recordLayout::timestampLow>() |
+            static_cast<uint64_t>(_record.get<ArtNetCapture::recordLayout::timestampHigh>()) << 32;
+
+        _first = _offset == 0 ? _timestamp : _first;
+        _last = _timestamp > _last ? _timestamp : _last;
+        _offset += ArtNetCapture::recordSize(_record.get<ArtNetCapture::recordLayout::packetLen>());
+    }
+
+    return _last - _first;
+}
+
+bool ArtNetReplay::run(ArtNet &device, uint32_t speed, replayStats &stats) {
+
+    stats = {};
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    uint64_t _start = monotonicNanos();
+    uint64_t _first = 0;
+    uint64_t _offset = 0;
+
+    while (_offset < recordBytes) {
+
+        if (_offset + ArtNetCapture::recordHeaderLen > recordBytes) {
+            return false;
+        }
+
+        uint8_t *_data = file + ArtNetCapture::fileHeaderLen + _offset;
+        wireReader<ArtNetCapture::recordLayout> _record(_data);
+
+        uint16_t _packetLen = _record.get<ArtNetCapture::recordLayout::packetLen>();
+        uint64_t _timestamp = _record.get<ArtNetCapture::recordLayout::timestampLow>() |
+            static_cast<uint64_t>(_record.get<ArtNetCapture::recordLayout::timestampHigh>()) << 32;
+
+        if (_offset + ArtNetCapture::recordHeaderLen + _packetLen > recordBytes) {
+            return false;
+        }
+
+        _first = stats.packets == 0 ? _timestamp : _first;
+
+        if (speed != 0) {
+            //packets of several receive threads may be slightly out of order, they are due right away
+            uint64_t _due = _start + (_timestamp > _first ? (_timestamp - _first) * 100 / speed : 0);
+            uint64_t _now = monotonicNanos();
+
+            //sleep until shortly before the due time, the wake up latency of the scheduler is spun away
+            if (_now + spinTime < _due) {
+                uint64_t _wakeAt = _due - spinTime;
+                timespec _wake = {static_cast<time_t>(_wakeAt / 1000000000ULL), static_cast<long>(_wakeAt % 1000000000ULL)};
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &_wake, nullptr);
+            }
+
+            while (_now < _due) {
+                _now = monotonicNanos();
+            }
+
+            uint64_t _lateness = _now > _due ? _now - _due : 0;
+            stats.maxLateness = _lateness > stats.maxLateness ? _lateness : stats.maxLateness;
+            stats.totalLateness += _lateness;
+        }
+
+        uint8_t _senderIp[4];
+        memcpy(_senderIp, _record.bytes<ArtNetCapture::recordLayout::senderIp>(), sizeof(_senderIp));
+
+        //handed over in place, the private mapping keeps writes of a handler out of the file
+        ArtNet::packetStatus _status = device.handlePacket(_data + ArtNetCapture::recordHeaderLen, _packetLen, _senderIp, sizeof(_senderIp),
+            _record.get<ArtNetCapture::recordLayout::port>());
+
+        stats.byStatus[_status]++;
+        stats.packets++;
+        stats.bytes += _packetLen;
+
+        _offset += ArtNetCapture::recordSize(_packetLen);
+    }
+
+    stats.elapsed = monotonicNanos() - _start;
+
+    return true;
+}
@@ -1,6 +1,1063 @@
 #include <ArtNetController.hpp>
+#include <ArtNetSimd.hpp>
+#include <stddef.h>
+#include <string.h>
 
-void ArtNetController::handleArtPollReply(void *packet, uint16_t packetLen) {
+ArtNetController::ArtNetController(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, txUniverse *universeTable, uint16_t universeTableLen,
+    universeMapEntry *universeMapStorage, uint16_t mapSize, discoveredNode *nodeTable, uint16_t nodeTableLen,
+    txPacket *batch, uint8_t (*batchIps)[ipAddressLen], uint16_t batchLen,
+    todEntry *todStorage, uint16_t todLen, rdmRequest *requestStorage, uint16_t requestLen)
+    :ArtNet(oemCode, MAC, MACLen), universes(universeTable), universeTableSize(universeTableLen), universeMap(universeMapStorage),
+    universeMapMask(mapSize - 1), nodes(nodeTable), nodeTableSize(nodeTableLen), txBatch(batch), txBatchIps(batchIps), maxBatchLen(batchLen),
+    tod(todStorage), todCapacity(todLen), rdmRequests(requestStorage), rdmRequestSlots(requestLen){
 
-    ArtPollReplyPacket *_packet_ptr = reinterpret_cast<ArtPollReplyPacket*> (packet);
-}
\ No newline at end of file
+    sysConf.deviceStyle = StController;
+
+    for (uint16_t i = 0; i <= universeMapMask; i++) {
+        universeMap[i].portAddress = noUniverse;
+    }
+
+    for (uint16_t i = 0; i < nodeTableSize; i++) {
+        nodes[i].state = nsEmpty;
+    }
+
+    for (uint16_t i = 0; i < rdmRequestSlots; i++) {
+        rdmRequests[i].state = rsFree;
+    }
+}
+
+ArtNetController::~ArtNetController() {
+}
+
+ArtNet::packetStatus ArtNetController::handleArtPollReply(const uint8_t *packet, uint16_t packetLen, uint8_t *, uint8_t) {
+
+    wireReader<artPollReplyLayout> _reply(packet);
+
+    //0 or missing means the DMX512 maximum
+    uint16_t _refreshRate = defaultRefreshRate;
+    if (packetLen >= artPollReplyLayout::refreshRate::end) {
+        uint16_t _advertised = _reply.get<artPollReplyLayout::refreshRate>();
+        if (_advertised != 0) {
+            _refreshRate = _advertised;
+        }
+    }
+
+    //bind index 0 is sent by nodes without bind support and means the root device
+    uint8_t _bindIndex = 1;
+    if (packetLen >= artPollReplyLayout::bindIndex::end && _reply.get<artPollReplyLayout::bindIndex>() != 0) {
+        _bindIndex = _reply.get<artPollReplyLayout::bindIndex>();
+    }
+
+    //only the low byte of the number of ports is used
+    uint8_t _numPorts = static_cast<uint8_t>(_reply.get<artPollReplyLayout::numPorts>());
+    uint8_t _netSwitch = _reply.get<artPollReplyLayout::netSwitch>();
+    uint8_t _subSwitch = _reply.get<artPollReplyLayout::subSwitch>();
+    const uint8_t *_swOut = _reply.bytes<artPollReplyLayout::swOut>();
+    uint16_t _outputs[4];
+    uint8_t _outputCount = 0;
+
+    for (uint8_t i = 0; i < 4 && i < _numPorts; i++) {
+
+        if (!_reply.get<artPollReplyLayout::isOutput>(i)) {
+            continue;
+        }
+
+        uint16_t _output = static_cast<uint16_t>(((_netSwitch & 0x7f) << 8) | ((_subSwitch & 0x0f) << 4) | (_swOut[i] & 0x0f));
+
+        //ports of a page outputting the same universe subscribe once
+        bool _listed = false;
+        for (uint8_t k = 0; k < _outputCount; k++) {
+            _listed |= _outputs[k] == _output;
+        }
+
+        if (!_listed) {
+            _outputs[_outputCount++] = _output;
+        }
+    }
+
+    //the ip in the reply identifies the node, the sender may be a router
+    const uint8_t *_ipAddress = _reply.bytes<artPollReplyLayout::ipAddress>();
+    discoveryGuard _guard(discoveryLock);
+    discoveredNode *_node = findNodeSlot(_ipAddress, _bindIndex, true);
+
+    if (_node == nullptr) {
+        return psOk;
+    }
+
+    if (_node->state != nsUsed) {
+        memcpy(_node->ip, _ipAddress, ipAddressLen);
+        _node->bindIndex = _bindIndex;
+        _node->outputCount = 0;
+        _node->state = nsUsed;
+        nodeCount++;
+    }
+
+    //only subscriptions which changed since the last reply are touched
+    for (uint8_t i = 0; i < _node->outputCount; i++) {
+
+        bool _kept = false;
+        for (uint8_t k = 0; k < _outputCount; k++) {
+            _kept |= _outputs[k] == _node->outputAddresses[i];
+        }
+
+        if (!_kept) {
+            updateSubscriber(_node->outputAddresses[i], _node->ip, false);
+        }
+    }
+
+    for (uint8_t k = 0; k < _outputCount; k++) {
+
+        bool _known = false;
+        for (uint8_t i = 0; i < _node->outputCount; i++) {
+            _known |= _outputs[k] == _node->outputAddresses[i];
+        }
+
+        if (!_known) {
+            updateSubscriber(_outputs[k], _node->ip, true);
+        }
+    }
+
+    uint8_t _oldCount = _node->outputCount;
+    uint16_t _oldOutputs[4];
+    memcpy(_oldOutputs, _node->outputAddresses, sizeof(_oldOutputs));
+
+    memcpy(_node->outputAddresses, _outputs, sizeof(_outputs));
+    _node->outputCount = _outputCount;
+    _node->refreshRate = _refreshRate;
+    _node->lastSeen = getMicros();
+
+    for (uint8_t i = 0; i < _oldCount; i++) {
+        uint16_t _universeIdx = findUniverse(_oldOutputs[i]);
+        if (_universeIdx != noUniverse) {
+            updateRefreshLimit(_universeIdx);
+        }
+    }
+
+    for (uint8_t k = 0; k < _outputCount; k++) {
+        uint16_t _universeIdx = findUniverse(_outputs[k]);
+        if (_universeIdx != noUniverse) {
+            updateRefreshLimit(_universeIdx);
+        }
+    }
+
+    return psOk;
+}
+
+ArtNetController::discoveredNode *ArtNetController::findNodeSlot(const uint8_t *ip, uint8_t bindIndex, bool insert) {
+
+    uint32_t _key;
+    memcpy(&_key, ip, ipAddressLen);
+    uint32_t _slot = ((_key ^ (bindIndex * 0x9e3779b9u)) * 2654435761u) % nodeTableSize;
+
+    discoveredNode *_free = nullptr;
+
+    for (uint16_t i = 0; i < nodeTableSize; i++) {
+
+        discoveredNode &_node = nodes[_slot];
+
+        if (_node.state == nsEmpty) {
+            return insert ? (_free != nullptr ? _free : &_node) : nullptr;
+        }
+
+        if (_node.state == nsDeleted) {
+            if (_free == nullptr) {
+                _free = &_node;
+            }
+        }
+        else if (_node.bindIndex == bindIndex && memcmp(_node.ip, ip, ipAddressLen) == 0) {
+            return &_node;
+        }
+
+        _slot = _slot + 1 == nodeTableSize ? 0 : _slot + 1;
+    }
+
+    return insert ? _free : nullptr;
+}
+
+void ArtNetController::updateSubscriber(uint16_t portAddress, const uint8_t *ip, bool subscribe) {
+
+    uint16_t _universeIdx = findUniverse(portAddress & 0x7fff);
+
+    if (_universeIdx == noUniverse) {
+        return;
+    }
+
+    txUniverse &_universe = universes[_universeIdx];
+    uint32_t _ip;
+    memcpy(&_ip, ip, ipAddressLen);
+
+    //the subscriber list is a seqlock, readers retry while the sequence is odd or changed
+    uint32_t _sequence = _universe.subscriberSequence.load(std::memory_order_relaxed);
+    _universe.subscriberSequence.store(_sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint8_t _count = _universe.subscriberCount.load(std::memory_order_relaxed);
+    uint8_t i = 0;
+
+    //a node outputting the universe on several pages or ports is listed once and counted per output
+    while (i < _count && _universe.subscriberIps[i].load(std::memory_order_relaxed) != _ip) {
+        i++;
+    }
+
+    if (subscribe) {
+        if (i < _count) {
+            _universe.subscriberRefs[i]++;
+        }
+        else if (_count < maxSubscribers) {
+            _universe.subscriberIps[_count].store(_ip, std::memory_order_relaxed);
+            _universe.subscriberRefs[_count] = 1;
+            _universe.subscriberCount.store(_count + 1, std::memory_order_relaxed);
+        }
+        else {
+            //the universe is broadcast while not all subscribers are known
+            _universe.subscriberOverflow++;
+        }
+    }
+    else {
+        if (i < _count) {
+            if (--_universe.subscriberRefs[i] == 0) {
+                _universe.subscriberIps[i].store(_universe.subscriberIps[_count - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                _universe.subscriberRefs[i] = _universe.subscriberRefs[_count - 1];
+                _universe.subscriberCount.store(_count - 1, std::memory_order_relaxed);
+            }
+        }
+        else if (_universe.subscriberOverflow > 0) {
+            _universe.subscriberOverflow--;
+        }
+    }
+
+    _universe.subscriberSequence.store(_sequence + 2, std::memory_order_release);
+}
+
+uint8_t ArtNetController::readSubscribers(const txUniverse &universe, uint32_t *ips) const {
+
+    uint32_t _before;
+    uint32_t _after;
+    uint8_t _count;
+
+    do {
+        _before = universe.subscriberSequence.load(std::memory_order_acquire);
+
+        _count = universe.subscriberOverflow.load(std::memory_order_relaxed) > 0 ? 0 : universe.subscriberCount.load(std::memory_order_relaxed);
+        for (uint8_t i = 0; i < _count; i++) {
+            ips[i] = universe.subscriberIps[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        _after = universe.subscriberSequence.load(std::memory_order_relaxed);
+    } while ((_before & 1) || _before != _after);
+
+    return _count;
+}
+
+void ArtNetController::updateRefreshLimit(uint16_t universeIdx) {
+
+    txUniverse &_universe = universes[universeIdx];
+    uint32_t _minInterval = 0;
+
+    //the slowest node receiving a universe limits its rate
+    for (uint16_t n = 0; n < nodeTableSize; n++) {
+
+        const discoveredNode &_node = nodes[n];
+
+        if (_node.state != nsUsed) {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < _node.outputCount; i++) {
+            if (_node.outputAddresses[i] == _universe.portAddress && 1000000u / _node.refreshRate > _minInterval) {
+                _minInterval = 1000000u / _node.refreshRate;
+            }
+        }
+    }
+
+    _universe.minInterval.store(_minInterval, std::memory_order_relaxed);
+}
+
+void ArtNetController::setBroadcastCallback(bool (*callback)(uint8_t *packet, uint16_t packetLen, uint16_t port)) {
+    callback_broadcast = callback;
+}
+
+bool ArtNetController::sendArtPoll() {
+
+    if (callback_broadcast == nullptr) {
+        return false;
+    }
+
+    uint8_t _packet[artPollPacketLen] = {};
+    wireWriter<artPollLayout> _poll(_packet);
+
+    memcpy(_poll.bytes<artPollLayout::ident>(), artNetIdent, artNetIdentLen);
+    _poll.set<artPollLayout::opCode>(opPoll);
+    _poll.set<artPollLayout::protVer>(protVersion);
+
+    //ask the nodes to reply whenever their configuration changes
+    _poll.set<artPollLayout::sendReplyOnChange>(true);
+
+    return callback_broadcast(_packet, sizeof(_packet), artNetPort);
+}
+
+uint16_t ArtNetController::expireNodes() {
+
+    uint64_t _now = getMicros();
+    uint16_t _expired = 0;
+    discoveryGuard _guard(discoveryLock);
+
+    for (uint16_t n = 0; n < nodeTableSize; n++) {
+
+        discoveredNode &_node = nodes[n];
+
+        if (_node.state != nsUsed || _now - _node.lastSeen <= nodeTimeOut * 1000000ULL) {
+            continue;
+        }
+
+        _node.state = nsDeleted;
+        nodeCount--;
+        _expired++;
+
+        for (uint8_t i = 0; i < _node.outputCount; i++) {
+
+            updateSubscriber(_node.outputAddresses[i], _node.ip, false);
+
+            uint16_t _universeIdx = findUniverse(_node.outputAddresses[i]);
+            if (_universeIdx != noUniverse) {
+                updateRefreshLimit(_universeIdx);
+            }
+        }
+    }
+
+    //without any node left all tombstones can be dropped
+    if (nodeCount == 0) {
+        for (uint16_t n = 0; n < nodeTableSize; n++) {
+            nodes[n].state = nsEmpty;
+        }
+    }
+
+    return _expired;
+}
+
+void ArtNetController::enableUnicastMode(bool enable) {
+    unicastMode = enable;
+}
+
+const ArtNetController::discoveredNode *ArtNetController::findNode(const uint8_t *ip, uint8_t bindIndex) {
+    return findNodeSlot(ip, bindIndex, false);
+}
+
+uint16_t ArtNetController::findUniverse(uint16_t portAddress) const {
+
+    uint16_t _slot = (portAddress * 40503u) & universeMapMask;
+
+    while (universeMap[_slot].portAddress != noUniverse) {
+
+        if (universeMap[_slot].portAddress == portAddress) {
+            return universeMap[_slot].universeIdx;
+        }
+
+        _slot = (_slot + 1) & universeMapMask;
+    }
+
+    return noUniverse;
+}
+
+bool ArtNetController::addUniverse(uint16_t portAddress, uint8_t *targetIp, uint8_t targetIpLen, uint16_t &universeIdx) {
+
+    discoveryGuard _guard(discoveryLock);
+
+    if (universeCount >= universeTableSize || targetIpLen < ipAddressLen || portAddress > 0x7fff || findUniverse(portAddress) != noUniverse) {
+        return false;
+    }
+
+    txUniverse &_universe = universes[universeCount];
+
+    memset(_universe.packet, 0, sizeof(_universe.packet));
+    wireWriter<artDmxLayout> _header(_universe.packet);
+
+    memcpy(_header.bytes<artDmxLayout::ident>(), artNetIdent, artNetIdentLen);
+    _header.set<artDmxLayout::opCode>(opDmx);
+    _header.set<artDmxLayout::protVer>(protVersion);
+    _header.set<artDmxLayout::portAddress>(portAddress);
+    _header.set<artDmxLayout::dataLength>(maxDmxSlots);
+
+    memcpy(_universe.targetIp, targetIp, ipAddressLen);
+    _universe.portAddress = portAddress;
+    _universe.length = maxDmxSlots;
+    _universe.active = true;
+    _universe.changed = true;
+    _universe.minInterval.store(0, std::memory_order_relaxed);
+    _universe.lastSent = 0;
+    _universe.subscriberCount.store(0, std::memory_order_relaxed);
+    _universe.subscriberOverflow.store(0, std::memory_order_relaxed);
+
+    //the map holds at most half as many universes as slots, so a free slot is always found
+    uint16_t _slot = (portAddress * 40503u) & universeMapMask;
+    while (universeMap[_slot].portAddress != noUniverse) {
+        _slot = (_slot + 1) & universeMapMask;
+    }
+
+    universeMap[_slot].portAddress = portAddress;
+    universeMap[_slot].universeIdx = universeCount;
+    universeIdx = universeCount++;
+
+    //replies only touch subscriptions which changed, nodes discovered before are subscribed here
+    for (uint16_t n = 0; n < nodeTableSize; n++) {
+
+        const discoveredNode &_node = nodes[n];
+
+        if (_node.state != nsUsed) {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < _node.outputCount; i++) {
+            if (_node.outputAddresses[i] == portAddress) {
+                updateSubscriber(portAddress, _node.ip, true);
+            }
+        }
+    }
+
+    updateRefreshLimit(universeIdx);
+
+    return true;
+}
+
+bool ArtNetController::setUniverseData(uint16_t universeIdx, const uint8_t *dmxData, uint16_t dmxDataSize) {
+
+    if (universeIdx >= universeCount || dmxDataSize == 0 || dmxDataSize > maxDmxSlots) {
+        return false;
+    }
+
+    txUniverse &_universe = universes[universeIdx];
+
+    if (!_universe.changed && !dmxFramesEqual(_universe.packet + artDmxHeaderLen, dmxData, dmxDataSize)) {
+        _universe.changed = true;
+    }
+
+    memcpy(_universe.packet + artDmxHeaderLen, dmxData, dmxDataSize);
+
+    //the length of an ArtDmx packet has to be even
+    uint16_t _length = static_cast<uint16_t>((dmxDataSize + 1) & ~1);
+    if (_length != dmxDataSize) {
+        _universe.packet[artDmxHeaderLen + dmxDataSize] = 0;
+    }
+
+    if (_length != _universe.length) {
+        _universe.changed = true;
+        _universe.length = _length;
+        wireWriter<artDmxLayout>(_universe.packet).set<artDmxLayout::dataLength>(_length);
+    }
+
+    return true;
+}
+
+uint16_t ArtNetController::flushBatch(uint16_t packetCount) {
+
+    if (callback_sendBatch != nullptr) {
+        return callback_sendBatch(txBatch, packetCount);
+    }
+
+    if (callback_unicast == nullptr) {
+        return 0;
+    }
+
+    uint16_t _sent = 0;
+
+    for (uint16_t i = 0; i < packetCount; i++) {
+        if (callback_unicast(const_cast<uint8_t*>(txBatch[i].data), txBatch[i].dataLen, const_cast<uint8_t*>(txBatch[i].targetIp), ipAddressLen, txBatch[i].targetPort)) {
+            _sent++;
+        }
+    }
+
+    return _sent;
+}
+
+void ArtNetController::queuePacket(const txUniverse &universe, const uint8_t *targetIp, uint16_t &batchLen, uint16_t &sent) {
+
+    txBatch[batchLen].data = universe.packet;
+    txBatch[batchLen].dataLen = artDmxHeaderLen + universe.length;
+    txBatch[batchLen].targetIp = targetIp;
+    txBatch[batchLen].targetPort = artNetPort;
+
+    if (++batchLen == maxBatchLen) {
+        sent += flushBatch(batchLen);
+        batchLen = 0;
+    }
+}
+
+uint16_t ArtNetController::transmitDmx() {
+
+    uint16_t _sent = 0;
+    uint16_t _batchLen = 0;
+    uint64_t _now = getMicros();
+
+    for (uint16_t i = 0; i < universeCount; i++) {
+
+        txUniverse &_universe = universes[i];
+
+        if (!_universe.active) {
+            continue;
+        }
+
+        if (deltaMode) {
+
+            uint64_t _sinceSent = _now - _universe.lastSent;
+
+            if (!_universe.changed) {
+                if (_sinceSent < dmxKeepAliveTime * 1000ULL) {
+                    transmitCounters.savedUnchanged++;
+                    continue;
+                }
+                transmitCounters.sentKeepAlive++;
+            }
+            else if (_sinceSent < _universe.minInterval.load(std::memory_order_relaxed)) {
+                transmitCounters.savedRateLimit++;
+                continue;
+            }
+            else {
+                transmitCounters.sentChanged++;
+            }
+        }
+
+        //sequence 0 disables reordering on the node, so it wraps from 255 to 1
+        _universe.changed = false;
+        _universe.lastSent = _now;
+        uint8_t _sequence = wireReader<artDmxLayout>(_universe.packet).get<artDmxLayout::sequence>();
+        wireWriter<artDmxLayout>(_universe.packet).set<artDmxLayout::sequence>(_sequence == 0xff ? 1 : _sequence + 1);
+
+        uint32_t _subscribers[maxSubscribers];
+        uint8_t _subscriberCount = unicastMode ? readSubscribers(_universe, _subscribers) : 0;
+
+        if (_subscriberCount == 0) {
+            queuePacket(_universe, _universe.targetIp, _batchLen, _sent);
+        }
+
+        for (uint8_t k = 0; k < _subscriberCount; k++) {
+            memcpy(txBatchIps[_batchLen], &_subscribers[k], ipAddressLen);
+            queuePacket(_universe, txBatchIps[_batchLen], _batchLen, _sent);
+        }
+    }
+
+    if (_batchLen > 0) {
+        _sent += flushBatch(_batchLen);
+    }
+
+    transmitCounters.sent += _sent;
+
+    return _sent;
+}
+
+void ArtNetController::enableDeltaMode(bool enable) {
+    deltaMode = enable;
+}
+
+bool ArtNetController::sendTodRequest(uint16_t portAddress) {
+
+    if (callback_broadcast == nullptr || portAddress > 0x7fff) {
+        return false;
+    }
+
+    uint8_t _packet[artTodRequestPacketLen] = {};
+    wireWriter<artTodRequestLayout> _request(_packet);
+
+    memcpy(_request.bytes<artTodRequestLayout::ident>(), artNetIdent, artNetIdentLen);
+    _request.set<artTodRequestLayout::opCode>(opTodRequest);
+    _request.set<artTodRequestLayout::protVer>(protVersion);
+    _request.set<artTodRequestLayout::net>(portAddress >> 8);
+    _request.set<artTodRequestLayout::addressCount>(1);
+    _request.bytes<artTodRequestLayout::addresses>()[0] = portAddress & 0xff;
+
+    //only the first address is used, the packet ends after it
+    return callback_broadcast(_packet, artTodRequestLayout::addresses::offset + 1, artNetPort);
+}
+
+bool ArtNetController::sendTodControl(uint16_t portAddress, todControlCommands command) {
+
+    if (callback_broadcast == nullptr || portAddress > 0x7fff) {
+        return false;
+    }
+
+    uint8_t _packet[artTodControlPacketLen] = {};
+    wireWriter<artTodControlLayout> _control(_packet);
+
+    memcpy(_control.bytes<artTodControlLayout::ident>(), artNetIdent, artNetIdentLen);
+    _control.set<artTodControlLayout::opCode>(opTodControl);
+    _control.set<artTodControlLayout::protVer>(protVersion);
+    _control.set<artTodControlLayout::net>(portAddress >> 8);
+    _control.set<artTodControlLayout::command>(command);
+    _control.set<artTodControlLayout::address>(portAddress & 0xff);
+
+    return callback_broadcast(_packet, sizeof(_packet), artNetPort);
+}
+
+void ArtNetController::setTodCallback(void (*callback)(uint16_t portAddress)) {
+    callback_todChanged = callback;
+}
+
+uint64_t ArtNetController::todKey(uint16_t portAddress, const uint8_t *uid) {
+
+    uint64_t _key = portAddress & 0x7fff;
+    for (uint8_t i = 0; i < rdmUidLen; i++) {
+        _key = (_key << 8) | uid[i];
+    }
+    return _key;
+}
+
+uint16_t ArtNetController::lowerBoundTod(uint64_t key) const {
+
+    uint16_t _first = 0;
+    uint16_t _count = todCount;
+
+    while (_count > 0) {
+        uint16_t _half = _count / 2;
+        if (tod[_first + _half].key < key) {
+            _first += _half + 1;
+            _count -= _half + 1;
+        }
+        else {
+            _count = _half;
+        }
+    }
+
+    return _first;
+}
+
+uint16_t ArtNetController::getTod(uint16_t portAddress, uint64_t *uids, uint16_t maxUids) const {
+
+    uint64_t _portKey = static_cast<uint64_t>(portAddress & 0x7fff) << 48;
+    uint16_t _first = lowerBoundTod(_portKey);
+    uint16_t _count = 0;
+
+    for (uint16_t i = _first; i < todCount && (tod[i].key >> 48) == (portAddress & 0x7fff); i++, _count++) {
+        if (_count < maxUids) {
+            uids[_count] = tod[i].key & 0xffffffffffffULL;
+        }
+    }
+
+    return _count;
+}
+
+ArtNetController::todAssembly *ArtNetController::findTodAssembly(const uint8_t *ip, uint16_t portAddress, uint8_t bindIndex, bool start) {
+
+    todAssembly *_free = nullptr;
+
+    for (todAssembly &_assembly : todAssemblies) {
+
+        if (_assembly.active && _assembly.portAddress == portAddress && _assembly.bindIndex == bindIndex &&
+            memcmp(_assembly.nodeIp, ip, ipAddressLen) == 0) {
+            return &_assembly;
+        }
+
+        if (!_assembly.active && _free == nullptr) {
+            _free = &_assembly;
+        }
+    }
+
+    if (!start) {
+        return nullptr;
+    }
+
+    //with all slots busy the oldest table loses its cleanup, its blocks are still merged
+    if (_free == nullptr) {
+        _free = &todAssemblies[todGeneration % maxTodAssemblies];
+    }
+
+    memcpy(_free->nodeIp, ip, ipAddressLen);
+    _free->portAddress = portAddress;
+    _free->bindIndex = bindIndex;
+    _free->active = false;
+
+    return _free;
+}
+
+bool ArtNetController::updateTodEntry(uint64_t key, const uint8_t *ip, uint8_t bindIndex, uint8_t generation) {
+
+    uint16_t _idx = lowerBoundTod(key);
+    bool _changed = true;
+
+    if (_idx == todCount || tod[_idx].key != key) {
+
+        if (todCount == todCapacity) {
+            reportFailure(rcConfigErr);
+            return false;
+        }
+
+        memmove(&tod[_idx + 1], &tod[_idx], (todCount - _idx) * sizeof(todEntry));
+        todCount++;
+        tod[_idx].key = key;
+    }
+    else {
+        //a responder moving to another node counts as a change of the table
+        _changed = tod[_idx].bindIndex != bindIndex || memcmp(tod[_idx].nodeIp, ip, ipAddressLen) != 0;
+    }
+
+    memcpy(tod[_idx].nodeIp, ip, ipAddressLen);
+    tod[_idx].bindIndex = bindIndex;
+    tod[_idx].generation = generation;
+
+    return _changed;
+}
+
+bool ArtNetController::removeStaleTodEntries(uint16_t portAddress, const uint8_t *ip, uint8_t bindIndex, uint8_t generation) {
+
+    uint16_t _first = lowerBoundTod(static_cast<uint64_t>(portAddress) << 48);
+    uint16_t _end = lowerBoundTod(static_cast<uint64_t>(portAddress + 1) << 48);
+    uint16_t _kept = _first;
+
+    for (uint16_t i = _first; i < _end; i++) {
+
+        bool _stale = tod[i].generation != generation && tod[i].bindIndex == bindIndex && memcmp(tod[i].nodeIp, ip, ipAddressLen) == 0;
+
+        if (!_stale) {
+            tod[_kept++] = tod[i];
+        }
+    }
+
+    if (_kept == _end) {
+        return false;
+    }
+
+    memmove(&tod[_kept], &tod[_end], (todCount - _end) * sizeof(todEntry));
+    todCount -= _end - _kept;
+
+    return true;
+}
+
+ArtNet::packetStatus ArtNetController::handleArtTodData(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    if (tod == nullptr) {
+        return psOk;
+    }
+
+    wireReader<artTodDataLayout> _data(packet);
+    uint8_t _uidCount = _data.get<artTodDataLayout::uidCount>();
+
+    if (senderIpLen < ipAddressLen || _uidCount > maxTodDataUids || artTodDataHeaderLen + _uidCount * rdmUidLen > packetLen) {
+        return psInvalidContent;
+    }
+
+    //TodNak: the node has no valid table yet
+    if (_data.get<artTodDataLayout::commandResponse>() != 0) {
+        return psOk;
+    }
+
+    uint16_t _portAddress = static_cast<uint16_t>(((_data.get<artTodDataLayout::net>() & 0x7f) << 8) | _data.get<artTodDataLayout::address>());
+    uint8_t _bindIndex = _data.get<artTodDataLayout::bindIndex>() != 0 ? _data.get<artTodDataLayout::bindIndex>() : 1;
+
+    //block 0 starts a full table, the other blocks continue it
+    todAssembly *_assembly = findTodAssembly(senderIp, _portAddress, _bindIndex, _data.get<artTodDataLayout::blockCount>() == 0);
+
+    if (_assembly != nullptr && _data.get<artTodDataLayout::blockCount>() == 0) {
+        _assembly->generation = ++todGeneration;
+        _assembly->received = 0;
+        _assembly->total = _data.get<artTodDataLayout::uidTotal>();
+        _assembly->active = true;
+    }
+
+    uint8_t _generation = _assembly != nullptr ? _assembly->generation : todGeneration;
+    const uint8_t *_uids = _data.bytes<artTodDataLayout::tod>();
+    bool _changed = false;
+
+    for (uint8_t i = 0; i < _uidCount; i++) {
+        _changed |= updateTodEntry(todKey(_portAddress, _uids + i * rdmUidLen), senderIp, _bindIndex, _generation);
+    }
+
+    if (_assembly != nullptr) {
+        _assembly->received += _uidCount;
+
+        if (_assembly->received >= _assembly->total) {
+            _changed |= removeStaleTodEntries(_portAddress, senderIp, _bindIndex, _generation);
+            _assembly->active = false;
+        }
+    }
+
+    if (_changed && callback_todChanged != nullptr) {
+        callback_todChanged(_portAddress);
+    }
+
+    return psOk;
+}
+
+void ArtNetController::setRdmCallback(void (*callback)(uint16_t requestIdx, rdmResults result, const uint8_t *rdmPacket, uint16_t rdmPacketLen)) {
+    callback_rdmResult = callback;
+}
+
+void ArtNetController::setRdmPipeline(uint8_t window, uint16_t timeOut, uint8_t retries) {
+    rdmPipeline.window = window > 0 ? window : 1;
+    rdmPipeline.timeOut = timeOut;
+    rdmPipeline.retries = retries;
+}
+
+bool ArtNetController::queueRdm(uint16_t portAddress, const uint8_t *rdmPacket, uint16_t rdmPacketLen, uint16_t &requestIdx) {
+
+    if (rdmRequests == nullptr || portAddress > 0x7fff || rdmPacketLen < minRdmPacketLen || rdmPacketLen > maxRdmPacketLen) {
+        return false;
+    }
+
+    wireReader<rdmLayout> _message(rdmPacket);
+
+    //the message length counts the start code but not the checksum
+    uint8_t _messageLen = _message.get<rdmLayout::messageLength>();
+    if (_messageLen < minRdmPacketLen - 1 || _messageLen + 1 > rdmPacketLen) {
+        return false;
+    }
+
+    uint64_t _key = todKey(portAddress, _message.bytes<rdmLayout::destinationUid>());
+    uint16_t _todIdx = lowerBoundTod(_key);
+
+    if (_todIdx == todCount || tod[_todIdx].key != _key) {
+        return false;
+    }
+
+    uint16_t _slot = rdmNextSlot;
+    uint16_t i = 0;
+    while (i < rdmRequestSlots && rdmRequests[_slot].state != rsFree) {
+        _slot = _slot + 1 == rdmRequestSlots ? 0 : _slot + 1;
+        i++;
+    }
+
+    if (i == rdmRequestSlots) {
+        return false;
+    }
+
+    rdmRequest &_request = rdmRequests[_slot];
+    memset(_request.packet, 0, artRdmHeaderLen);
+    wireWriter<artRdmLayout> _header(_request.packet);
+
+    memcpy(_header.bytes<artRdmLayout::ident>(), artNetIdent, artNetIdentLen);
+    _header.set<artRdmLayout::opCode>(opRdm);
+    _header.set<artRdmLayout::protVer>(protVersion);
+    _header.set<artRdmLayout::rdmVer>(1);
+    _header.set<artRdmLayout::net>(portAddress >> 8);
+    _header.set<artRdmLayout::address>(portAddress & 0xff);
+
+    uint8_t *_rdm = _header.bytes<artRdmLayout::rdmPacket>();
+    memcpy(_rdm, rdmPacket, _messageLen + 1);
+    wireWriter<rdmLayout>(_rdm).set<rdmLayout::transaction>(rdmTransaction++);
+
+    //the checksum covers the start code 0xcc which is not part of the packet
+    uint16_t _checksum = 0xcc;
+    for (uint16_t k = 0; k + 1 < _messageLen; k++) {
+        _checksum = static_cast<uint16_t>(_checksum + _rdm[k]);
+    }
+    _rdm[_messageLen - 1] = _checksum >> 8;
+    _rdm[_messageLen] = _checksum & 0xff;
+
+    _request.packetLen = artRdmHeaderLen + _messageLen + 1;
+    memcpy(_request.nodeIp, tod[_todIdx].nodeIp, ipAddressLen);
+    _request.retries = 0;
+    _request.state = rsQueued;
+
+    requestIdx = _slot;
+    rdmNextSlot = _slot + 1 == rdmRequestSlots ? 0 : _slot + 1;
+
+    pumpRdm(_request.nodeIp, getMicros());
+
+    return true;
+}
+
+uint16_t ArtNetController::getRdmPending() const {
+
+    uint16_t _pending = 0;
+
+    for (uint16_t i = 0; i < rdmRequestSlots; i++) {
+        _pending += rdmRequests[i].state != rsFree;
+    }
+
+    return _pending;
+}
+
+uint8_t ArtNetController::countRdmInFlight(const uint8_t *ip) const {
+
+    uint8_t _inFlight = 0;
+
+    for (uint16_t i = 0; i < rdmRequestSlots; i++) {
+        if (rdmRequests[i].state == rsInFlight && memcmp(rdmRequests[i].nodeIp, ip, ipAddressLen) == 0) {
+            _inFlight++;
+        }
+    }
+
+    return _inFlight;
+}
+
+void ArtNetController::sendRdmRequest(rdmRequest &request, uint64_t now) {
+
+    //a failed transmission is retried like a lost response
+    if (callback_unicast != nullptr) {
+        callback_unicast(request.packet, request.packetLen, request.nodeIp, ipAddressLen, artNetPort);
+    }
+
+    request.state = rsInFlight;
+    request.sentAt = now;
+}
+
+void ArtNetController::pumpRdm(const uint8_t *ip, uint64_t now) {
+
+    //the slot after the last queued request holds the oldest one
+    uint16_t _slot = rdmNextSlot;
+    uint8_t _inFlight = ip != nullptr ? countRdmInFlight(ip) : 0;
+
+    for (uint16_t i = 0; i < rdmRequestSlots && _inFlight < rdmPipeline.window; i++, _slot = _slot + 1 == rdmRequestSlots ? 0 : _slot + 1) {
+
+        rdmRequest &_request = rdmRequests[_slot];
+
+        if (_request.state != rsQueued || (ip != nullptr && memcmp(_request.nodeIp, ip, ipAddressLen) != 0)) {
+            continue;
+        }
+
+        if (ip == nullptr && countRdmInFlight(_request.nodeIp) >= rdmPipeline.window) {
+            continue;
+        }
+
+        sendRdmRequest(_request, now);
+
+        if (ip != nullptr) {
+            _inFlight++;
+        }
+    }
+}
+
+ArtNet::packetStatus ArtNetController::handleArtRdm(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artRdmLayout> _packet(packet);
+
+    if (rdmRequests == nullptr || senderIpLen < ipAddressLen || _packet.get<artRdmLayout::command>() != 0) {
+        return psOk;
+    }
+
+    const uint8_t *_rdm = _packet.bytes<artRdmLayout::rdmPacket>();
+    uint16_t _rdmLen = packetLen - artRdmHeaderLen < maxRdmPacketLen ? packetLen - artRdmHeaderLen : maxRdmPacketLen;
+    wireReader<rdmLayout> _response(_rdm);
+
+    //requests of other controllers carry even command classes
+    if (!(_response.get<rdmLayout::commandClass>() & 1)) {
+        return psOk;
+    }
+
+    for (uint16_t i = 0; i < rdmRequestSlots; i++) {
+
+        rdmRequest &_request = rdmRequests[i];
+
+        if (_request.state != rsInFlight || memcmp(_request.nodeIp, senderIp, ipAddressLen) != 0) {
+            continue;
+        }
+
+        wireReader<rdmLayout> _sent(_request.packet + artRdmHeaderLen);
+
+        if (_sent.get<rdmLayout::transaction>() != _response.get<rdmLayout::transaction>() ||
+            memcmp(_sent.bytes<rdmLayout::destinationUid>(), _response.bytes<rdmLayout::sourceUid>(), rdmUidLen) != 0) {
+            continue;
+        }
+
+        _request.state = rsFree;
+
+        if (callback_rdmResult != nullptr) {
+            callback_rdmResult(i, rrResponse, _rdm, _rdmLen);
+        }
+
+        pumpRdm(senderIp, getMicros());
+        break;
+    }
+
+    //late responses of requests which already timed out are dropped
+    return psOk;
+}
+
+void ArtNetController::startTimeCode(const timeCode &start) {
+
+    timeCodeOut = {};
+    timeCodeOut.type = start.type < timeCodeTypeCount ? start.type : ttSmpte;
+    timeCodeOut.streamId = start.streamId;
+    timeCodeOut.startFrame = timeCodeToFrames(start);
+    timeCodeOut.startTime = getMicros();
+    timeCodeOut.running = true;
+}
+
+void ArtNetController::stopTimeCode() {
+    timeCodeOut.running = false;
+}
+
+uint64_t ArtNetController::serviceTimeCode() {
+
+    timeCodeGenerator &_generator = timeCodeOut;
+
+    if (!_generator.running) {
+        return 0;
+    }
+
+    uint64_t _now = getMicros();
+    uint64_t _due = _generator.startTime + timeCodeFramesToMicros(_generator.frameIndex, _generator.type);
+
+    if (_now < _due) {
+        return _due;
+    }
+
+    //frame running now, receivers chase the time and not every single frame
+    uint64_t _current = (_now - _generator.startTime) * timeCodePeriodFrames[_generator.type] /
+        timeCodePeriodMicros[_generator.type];
+
+    if (_current > _generator.frameIndex) {
+        _generator.stats.skipped += static_cast<uint32_t>(_current - _generator.frameIndex);
+        _generator.frameIndex = _current;
+        _due = _generator.startTime + timeCodeFramesToMicros(_current, _generator.type);
+    }
+
+    uint32_t _lateness = static_cast<uint32_t>(_now - _due);
+    _generator.latenessScaled += _lateness - (_generator.latenessScaled + 8) / 16;
+    _generator.stats.lateness = _generator.latenessScaled / 16;
+    _generator.stats.maxLateness = _lateness > _generator.stats.maxLateness ? _lateness : _generator.stats.maxLateness;
+
+    timeCode _tc;
+    _tc.streamId = _generator.streamId;
+    framesToTimeCode(static_cast<uint32_t>((_generator.startFrame + _generator.frameIndex) % timeCodeFramesPerDay(_generator.type)),
+        _generator.type, _tc);
+
+    if (sendTimeCode(_tc)) {
+        _generator.stats.sent++;
+    }
+    else {
+        countStatus(psTransmitFailed);
+    }
+
+    _generator.frameIndex++;
+
+    return _generator.startTime + timeCodeFramesToMicros(_generator.frameIndex, _generator.type);
+}
+
+void ArtNetController::service() {
+
+    ArtNet::service();
+    serviceTimeCode();
+
+    if (rdmRequests == nullptr) {
+        return;
+    }
+
+    uint64_t _now = getMicros();
+    bool _freed = false;
+
+    for (uint16_t i = 0; i < rdmRequestSlots; i++) {
+
+        rdmRequest &_request = rdmRequests[i];
+
+        if (_request.state != rsInFlight || _now - _request.sentAt <= rdmPipeline.timeOut * 1000ULL) {
+            continue;
+        }
+
+        if (_request.retries < rdmPipeline.retries) {
+            _request.retries++;
+            sendRdmRequest(_request, _now);
+            continue;
+        }
+
+        _request.state = rsFree;
+        _freed = true;
+
+        if (callback_rdmResult != nullptr) {
+            callback_rdmResult(i, rrTimeout, nullptr, 0);
+        }
+    }
+
+    //responses refill the window of their node right away, only timeouts leave room behind
+    if (_freed) {
+        pumpRdm(nullptr, _now);
+    }
+}
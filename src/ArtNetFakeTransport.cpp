@@ -0,0 +1,69 @@
+#include <ArtNetFakeTransport.hpp>
+#include <string.h>
+
+uint8_t ArtNetFakeTransport::lastPacket[maxPacketLen];
+uint16_t ArtNetFakeTransport::lastPacketLen = 0;
+uint8_t ArtNetFakeTransport::lastTargetIp[ipAddressLen];
+ArtNetFakeTransport::txCounters ArtNetFakeTransport::counters = {};
+
+void ArtNetFakeTransport::store(const uint8_t *packet, uint16_t packetLen, const uint8_t *targetIp, uint8_t targetIpLen) {
+
+    lastPacketLen = packetLen < maxPacketLen ? packetLen : maxPacketLen;
+    memcpy(lastPacket, packet, lastPacketLen);
+
+    if (targetIp != nullptr && targetIpLen >= ipAddressLen) {
+        memcpy(lastTargetIp, targetIp, ipAddressLen);
+    }
+    else {
+        memset(lastTargetIp, 0xff, ipAddressLen);
+    }
+
+    counters.packets++;
+    counters.bytes += packetLen;
+    counters.checksum += lastPacketLen ? lastPacket[lastPacketLen - 1] : 0;
+}
+
+void ArtNetFakeTransport::reset() {
+
+    lastPacketLen = 0;
+    memset(lastTargetIp, 0, sizeof(lastTargetIp));
+    counters = {};
+}
+
+bool ArtNetFakeTransport::sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t) {
+
+    store(packet, packetLen, targetIp, targetIpLen);
+
+    return true;
+}
+
+uint16_t ArtNetFakeTransport::sendBatch(const ArtNet::txPacket *packets, uint16_t packetCount) {
+
+    for (uint16_t i = 0; i < packetCount; i++) {
+        store(packets[i].data, packets[i].dataLen, packets[i].targetIp, ipAddressLen);
+    }
+
+    counters.batches++;
+
+    return packetCount;
+}
+
+bool ArtNetFakeTransport::sendBroadcast(uint8_t *packet, uint16_t packetLen, uint16_t) {
+
+    store(packet, packetLen, nullptr, 0);
+
+    return true;
+}
+
+const uint8_t *ArtNetFakeTransport::getLastPacket(uint16_t &packetLen) {
+    packetLen = lastPacketLen;
+    return lastPacket;
+}
+
+const uint8_t *ArtNetFakeTransport::getLastTargetIp() {
+    return lastTargetIp;
+}
+
+const ArtNetFakeTransport::txCounters &ArtNetFakeTransport::getCounters() {
+    return counters;
+}
@@ -0,0 +1,92 @@
+#include <ArtNetLinuxFarm.hpp>
+#include <ArtNetLinuxUdp.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+bool ArtNetLinuxFarm::open(uint16_t port) {
+
+    if (!ArtNetLinuxUdp::open(port)) {
+        return false;
+    }
+
+    int _enable = 1;
+
+    if (setsockopt(ArtNetLinuxUdp::getSocket(), IPPROTO_IP, IP_PKTINFO, &_enable, sizeof(_enable)) != 0) {
+        ArtNetLinuxUdp::close();
+        return false;
+    }
+
+    return true;
+}
+
+void ArtNetLinuxFarm::close() {
+    ArtNetLinuxUdp::close();
+}
+
+uint16_t ArtNetLinuxFarm::receive(ArtNetNodeFarm &farm, uint16_t maxPackets) {
+
+    int _fd = ArtNetLinuxUdp::getSocket();
+
+    if (_fd < 0) {
+        return 0;
+    }
+
+    static thread_local uint8_t _buffers[maxBatchLen][maxPacketLen];
+    static thread_local uint8_t _controls[maxBatchLen][CMSG_SPACE(sizeof(in_pktinfo))];
+    mmsghdr _messages[maxBatchLen];
+    iovec _vectors[maxBatchLen];
+    sockaddr_in _senders[maxBatchLen];
+
+    uint16_t _handled = 0;
+
+    while (_handled < maxPackets) {
+
+        uint16_t _chunkLen = maxPackets - _handled < maxBatchLen ? maxPackets - _handled : maxBatchLen;
+
+        for (uint16_t i = 0; i < _chunkLen; i++) {
+
+            _vectors[i].iov_base = _buffers[i];
+            _vectors[i].iov_len = maxPacketLen;
+
+            memset(&_messages[i].msg_hdr, 0, sizeof(_messages[i].msg_hdr));
+            _messages[i].msg_hdr.msg_name = &_senders[i];
+            _messages[i].msg_hdr.msg_namelen = sizeof(_senders[i]);
+            _messages[i].msg_hdr.msg_iov = &_vectors[i];
+            _messages[i].msg_hdr.msg_iovlen = 1;
+            _messages[i].msg_hdr.msg_control = _controls[i];
+            _messages[i].msg_hdr.msg_controllen = sizeof(_controls[i]);
+        }
+
+        int _result = recvmmsg(_fd, _messages, _chunkLen, MSG_DONTWAIT, nullptr);
+
+        if (_result <= 0) {
+            break;
+        }
+
+        for (int i = 0; i < _result; i++) {
+
+            //without the destination the packet is taken as broadcast to all nodes
+            const uint8_t *_targetIp = nullptr;
+
+            for (cmsghdr *_control = CMSG_FIRSTHDR(&_messages[i].msg_hdr); _control != nullptr;
+                _control = CMSG_NXTHDR(&_messages[i].msg_hdr, _control)) {
+                if (_control->cmsg_level == IPPROTO_IP && _control->cmsg_type == IP_PKTINFO) {
+                    _targetIp = reinterpret_cast<const uint8_t*>(&reinterpret_cast<in_pktinfo*>(CMSG_DATA(_control))->ipi_addr.s_addr);
+                }
+            }
+
+            farm.handleFarmPacket(_buffers[i], static_cast<uint16_t>(_messages[i].msg_len),
+                reinterpret_cast<uint8_t*>(&_senders[i].sin_addr.s_addr), 4, _targetIp, _targetIp != nullptr ? 4 : 0);
+        }
+
+        _handled += static_cast<uint16_t>(_result);
+
+        if (_result < _chunkLen) {
+            break;
+        }
+    }
+
+    return _handled;
+}
@@ -0,0 +1,135 @@
+#include <ArtNetLinuxSacn.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+int ArtNetLinuxSacn::socketFd = -1;
+
+bool ArtNetLinuxSacn::open(bool loopback) {
+
+    close();
+
+    int _fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (_fd < 0) {
+        return false;
+    }
+
+    int _enable = 1;
+    unsigned char _loop = loopback ? 1 : 0;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &_enable, sizeof(_enable));
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEPORT, &_enable, sizeof(_enable));
+    setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &_loop, sizeof(_loop));
+
+    sockaddr_in _address = {};
+    _address.sin_family = AF_INET;
+    _address.sin_port = htons(ArtNetSacnGateway::sacnPort);
+    _address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(_fd, reinterpret_cast<sockaddr*>(&_address), sizeof(_address)) != 0) {
+        ::close(_fd);
+        return false;
+    }
+
+    socketFd = _fd;
+
+    return true;
+}
+
+void ArtNetLinuxSacn::close() {
+
+    if (socketFd >= 0) {
+        ::close(socketFd);
+        socketFd = -1;
+    }
+}
+
+int ArtNetLinuxSacn::getSocket() {
+    return socketFd;
+}
+
+bool ArtNetLinuxSacn::joinUniverse(uint16_t universe, const uint8_t *interfaceIp) {
+
+    if (socketFd < 0 || universe < ArtNetSacnGateway::minSacnUniverse || universe > ArtNetSacnGateway::maxSacnUniverse) {
+        return false;
+    }
+
+    uint8_t _group[4];
+    ArtNetSacnGateway::sacnMulticastIp(universe, _group);
+
+    ip_mreq _request = {};
+    memcpy(&_request.imr_multiaddr.s_addr, _group, sizeof(_group));
+    if (interfaceIp != nullptr) {
+        memcpy(&_request.imr_interface.s_addr, interfaceIp, 4);
+    }
+    else {
+        _request.imr_interface.s_addr = htonl(INADDR_ANY);
+    }
+
+    return setsockopt(socketFd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &_request, sizeof(_request)) == 0;
+}
+
+bool ArtNetLinuxSacn::sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort) {
+
+    if (socketFd < 0 || targetIpLen < 4) {
+        return false;
+    }
+
+    sockaddr_in _target = {};
+    _target.sin_family = AF_INET;
+    _target.sin_port = htons(targetPort);
+    memcpy(&_target.sin_addr.s_addr, targetIp, 4);
+
+    return sendto(socketFd, packet, packetLen, 0, reinterpret_cast<sockaddr*>(&_target), sizeof(_target)) == packetLen;
+}
+
+uint16_t ArtNetLinuxSacn::receive(ArtNetSacnGateway &gateway, uint16_t maxPackets) {
+
+    if (socketFd < 0) {
+        return 0;
+    }
+
+    static thread_local uint8_t _buffers[maxBatchLen][maxPacketLen];
+    mmsghdr _messages[maxBatchLen];
+    iovec _vectors[maxBatchLen];
+    sockaddr_in _senders[maxBatchLen];
+
+    uint16_t _handled = 0;
+
+    while (_handled < maxPackets) {
+
+        uint16_t _chunkLen = maxPackets - _handled < maxBatchLen ? maxPackets - _handled : maxBatchLen;
+
+        for (uint16_t i = 0; i < _chunkLen; i++) {
+
+            _vectors[i].iov_base = _buffers[i];
+            _vectors[i].iov_len = maxPacketLen;
+
+            memset(&_messages[i].msg_hdr, 0, sizeof(_messages[i].msg_hdr));
+            _messages[i].msg_hdr.msg_name = &_senders[i];
+            _messages[i].msg_hdr.msg_namelen = sizeof(_senders[i]);
+            _messages[i].msg_hdr.msg_iov = &_vectors[i];
+            _messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int _result = recvmmsg(socketFd, _messages, _chunkLen, MSG_DONTWAIT, nullptr);
+
+        if (_result <= 0) {
+            break;
+        }
+
+        for (int i = 0; i < _result; i++) {
+            gateway.handleSacnPacket(_buffers[i], static_cast<uint16_t>(_messages[i].msg_len),
+                reinterpret_cast<uint8_t*>(&_senders[i].sin_addr.s_addr), 4);
+        }
+
+        _handled += static_cast<uint16_t>(_result);
+
+        if (_result < _chunkLen) {
+            break;
+        }
+    }
+
+    return _handled;
+}
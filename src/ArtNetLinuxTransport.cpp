@@ -0,0 +1,332 @@
+#include <ArtNetLinuxTransport.hpp>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+
+ArtNetLinuxTransport::ArtNetLinuxTransport(ArtNet &target, rxSlot *ringStorage, uint16_t ringSize, uint8_t workerThreads)
+    : device(target), ring(ringStorage), workerCount(workerThreads) {
+
+    bool _validSize = ringSize >= rxBatchLen && ringSize <= maxRingSize && (ringSize & (ringSize - 1)) == 0;
+
+    //an invalid ring is reported by start()
+    ringMask = _validSize ? static_cast<uint16_t>(ringSize - 1) : 0;
+}
+
+ArtNetLinuxTransport::~ArtNetLinuxTransport() {
+    stop();
+}
+
+bool ArtNetLinuxTransport::start(uint16_t localPort) {
+
+    if (rxThread.joinable() || ring == nullptr || ringMask == 0 || workerCount == 0 || workerCount > maxWorkers) {
+        return false;
+    }
+
+    if (!ArtNetLinuxUdp::open(localPort)) {
+        return false;
+    }
+
+    int _fd = ArtNetLinuxUdp::getSocket();
+
+    //bursts of many universes are absorbed by the kernel while the ring is full
+    int _bufferSize = rxBufferSize;
+    setsockopt(_fd, SOL_SOCKET, SO_RCVBUF, &_bufferSize, sizeof(_bufferSize));
+
+    timeval _timeOut = {0, rxTimeOut};
+    setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &_timeOut, sizeof(_timeOut));
+
+    device.setUnicastCallback(ArtNetLinuxUdp::sendUnicast);
+    device.setBatchCallback(ArtNetLinuxUdp::sendBatch);
+
+    for (uint32_t i = 0; i <= ringMask; i++) {
+        ring[i].pending.store(0, std::memory_order_relaxed);
+    }
+
+    ringHead = 0;
+    port = localPort;
+    nextService = 0;
+    barrierArrived.store(0, std::memory_order_relaxed);
+
+    //from here on the receive state is only touched while all workers wait
+    device.setReceiveServiceExternal(true);
+
+    running.store(true, std::memory_order_release);
+    workersRunning.store(true, std::memory_order_release);
+
+    for (uint8_t i = 0; i < workerCount; i++) {
+        workers[i].head.store(0, std::memory_order_relaxed);
+        workers[i].tail.store(0, std::memory_order_relaxed);
+        workers[i].thread = std::thread(&ArtNetLinuxTransport::workerLoop, this, i);
+    }
+
+    rxThread = std::thread(&ArtNetLinuxTransport::receiveLoop, this);
+
+    return true;
+}
+
+void ArtNetLinuxTransport::stop() {
+
+    if (!rxThread.joinable()) {
+        return;
+    }
+
+    running.store(false, std::memory_order_release);
+    rxThread.join();
+
+    //nothing is queued anymore, the workers leave once their queue is empty
+    workersRunning.store(false, std::memory_order_seq_cst);
+
+    for (uint8_t i = 0; i < workerCount; i++) {
+        {
+            std::lock_guard<std::mutex> _lock(workers[i].wakeLock);
+        }
+        workers[i].wake.notify_one();
+        workers[i].thread.join();
+    }
+
+    device.setReceiveServiceExternal(false);
+    ArtNetLinuxUdp::close();
+}
+
+void ArtNetLinuxTransport::receiveLoop() {
+
+    mmsghdr _messages[rxBatchLen];
+    iovec _vectors[rxBatchLen];
+    sockaddr_in _senders[rxBatchLen];
+
+    int _fd = ArtNetLinuxUdp::getSocket();
+    bool _wasFull = false;
+
+    while (running.load(std::memory_order_acquire)) {
+
+        queueServiceTask();
+
+        //slots are reused in ring order, a slot still handled by a worker ends the batch
+        uint8_t _free = 0;
+        while (_free < rxBatchLen) {
+
+            rxSlot &_slot = ring[(ringHead + _free) & ringMask];
+
+            if (_slot.pending.load(std::memory_order_acquire) != 0) {
+                break;
+            }
+
+            _vectors[_free].iov_base = _slot.data;
+            _vectors[_free].iov_len = slotDataLen;
+
+            memset(&_messages[_free].msg_hdr, 0, sizeof(_messages[_free].msg_hdr));
+            _messages[_free].msg_hdr.msg_name = &_senders[_free];
+            _messages[_free].msg_hdr.msg_namelen = sizeof(_senders[_free]);
+            _messages[_free].msg_hdr.msg_iov = &_vectors[_free];
+            _messages[_free].msg_hdr.msg_iovlen = 1;
+
+            _free++;
+        }
+
+        if (_free == 0) {
+            counters.ringFull.fetch_add(1, std::memory_order_relaxed);
+            //reported once per stall, the kernel drops packets until the workers catch up
+            if (!_wasFull) {
+                device.reportFailure(ArtNet::rcDmxUdpFull);
+                _wasFull = true;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        _wasFull = false;
+
+        int _result = recvmmsg(_fd, _messages, _free, MSG_WAITFORONE, nullptr);
+
+        if (_result <= 0) {
+            continue;
+        }
+
+        counters.batches.fetch_add(1, std::memory_order_relaxed);
+        counters.received.fetch_add(static_cast<uint64_t>(_result), std::memory_order_relaxed);
+
+        uint32_t _notify = 0;
+
+        for (int i = 0; i < _result; i++) {
+
+            uint16_t _slotIdx = static_cast<uint16_t>((ringHead + i) & ringMask);
+            rxSlot &_slot = ring[_slotIdx];
+
+            _slot.length = static_cast<uint16_t>(_messages[i].msg_len);
+            _slot.task = false;
+            memcpy(_slot.senderIp, &_senders[i].sin_addr.s_addr, sizeof(_slot.senderIp));
+
+            dispatchSlot(_slotIdx, _notify);
+        }
+
+        ringHead += static_cast<uint32_t>(_result);
+
+        //pairs with the fence of a worker going to sleep, either it sees the new entries or we see it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        for (uint8_t i = 0; i < workerCount; i++) {
+            if ((_notify & (1u << i)) && workers[i].sleeping.load(std::memory_order_relaxed)) {
+                {
+                    std::lock_guard<std::mutex> _lock(workers[i].wakeLock);
+                }
+                workers[i].wake.notify_one();
+            }
+        }
+    }
+}
+
+void ArtNetLinuxTransport::dispatchSlot(uint16_t slotIdx, uint32_t &notify) {
+
+    rxSlot &_slot = ring[slotIdx];
+
+    uint16_t _portAddress = 0;
+    ArtNet::packetScope _scope = _slot.task ? ArtNet::scopeDevice : ArtNet::classifyPacket(_slot.data, _slot.length, _portAddress);
+
+    //timing packets are stamped before they wait in a worker queue, they go to the first worker without a barrier
+    _slot.receivedAt = _scope == ArtNet::scopeTime ? device.getMicros() : 0;
+
+    uint8_t _first = 0;
+    uint8_t _last = 0;
+
+    if (_scope == ArtNet::scopeUniverse) {
+        //all packets of a universe go to the same worker to keep them in order
+        _first = static_cast<uint8_t>(_portAddress % workerCount);
+        _last = _first;
+    }
+    else if (_scope == ArtNet::scopeDevice && workerCount > 1) {
+        _last = static_cast<uint8_t>(workerCount - 1);
+    }
+
+    _slot.barrier = _first != _last;
+    _slot.pending.store(static_cast<uint8_t>(_last - _first + 1), std::memory_order_relaxed);
+
+    for (uint8_t i = _first; i <= _last; i++) {
+
+        worker &_worker = workers[i];
+        uint32_t _tail = _worker.tail.load(std::memory_order_relaxed);
+
+        //a slot is queued at most once per worker, so the queue can never overflow
+        _worker.entries[_tail & (maxRingSize - 1)] = slotIdx;
+        _worker.tail.store(_tail + 1, std::memory_order_release);
+
+        notify |= 1u << i;
+    }
+}
+
+void ArtNetLinuxTransport::workerLoop(uint8_t workerIdx) {
+
+    worker &_worker = workers[workerIdx];
+    uint16_t _spins = 0;
+
+    while (true) {
+
+        uint32_t _head = _worker.head.load(std::memory_order_relaxed);
+
+        if (_head == _worker.tail.load(std::memory_order_acquire)) {
+
+            if (!workersRunning.load(std::memory_order_acquire)) {
+                //the last entries may have been queued after the check above
+                if (_head == _worker.tail.load(std::memory_order_acquire)) {
+                    break;
+                }
+                continue;
+            }
+
+            if (++_spins < idleSpins) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> _lock(_worker.wakeLock);
+            _worker.sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            _worker.wake.wait(_lock, [&]() {
+                return _worker.tail.load(std::memory_order_acquire) != _head || !workersRunning.load(std::memory_order_acquire);
+            });
+
+            _worker.sleeping.store(false, std::memory_order_relaxed);
+            _spins = 0;
+            continue;
+        }
+
+        _spins = 0;
+
+        rxSlot &_slot = ring[_worker.entries[_head & (maxRingSize - 1)]];
+
+        if (_slot.barrier) {
+            handleBarrier(_slot);
+        }
+        else if (_slot.task) {
+            device.serviceReceive();
+        }
+        else {
+            device.handlePacket(_slot.data, _slot.length, _slot.senderIp, sizeof(_slot.senderIp), port, _slot.receivedAt);
+        }
+
+        if (!_slot.task) {
+            counters.handled[workerIdx].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _worker.head.store(_head + 1, std::memory_order_relaxed);
+        _slot.pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void ArtNetLinuxTransport::handleBarrier(rxSlot &slot) {
+
+    uint32_t _generation = barrierGeneration.load(std::memory_order_acquire);
+
+    if (barrierArrived.fetch_add(1, std::memory_order_acq_rel) + 1 == workerCount) {
+        //every other worker waits below, so the packet sees no ArtDmx in flight
+        if (slot.task) {
+            device.serviceReceive();
+        }
+        else {
+            device.handlePacket(slot.data, slot.length, slot.senderIp, sizeof(slot.senderIp), port);
+        }
+        counters.barriers.fetch_add(1, std::memory_order_relaxed);
+
+        barrierArrived.store(0, std::memory_order_relaxed);
+        barrierGeneration.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    while (barrierGeneration.load(std::memory_order_acquire) == _generation) {
+        std::this_thread::yield();
+    }
+}
+
+void ArtNetLinuxTransport::queueServiceTask() {
+
+    timespec _time;
+    clock_gettime(CLOCK_MONOTONIC, &_time);
+    uint64_t _now = static_cast<uint64_t>(_time.tv_sec) * 1000000ULL + static_cast<uint64_t>(_time.tv_nsec) / 1000;
+
+    uint16_t _slotIdx = static_cast<uint16_t>(ringHead & ringMask);
+
+    if (_now < nextService || ring[_slotIdx].pending.load(std::memory_order_acquire) != 0) {
+        return;
+    }
+
+    ring[_slotIdx].task = true;
+    ring[_slotIdx].length = 0;
+
+    uint32_t _notify = 0;
+    dispatchSlot(_slotIdx, _notify);
+    ringHead++;
+    nextService = _now + serviceInterval;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (uint8_t i = 0; i < workerCount; i++) {
+        if ((_notify & (1u << i)) && workers[i].sleeping.load(std::memory_order_relaxed)) {
+            {
+                std::lock_guard<std::mutex> _lock(workers[i].wakeLock);
+            }
+            workers[i].wake.notify_one();
+        }
+    }
+}
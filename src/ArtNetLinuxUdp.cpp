@@ -0,0 +1,109 @@
+#include <ArtNetLinuxUdp.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+int ArtNetLinuxUdp::socketFd = -1;
+
+bool ArtNetLinuxUdp::open(uint16_t port) {
+
+    close();
+
+    int _fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (_fd < 0) {
+        return false;
+    }
+
+    int _enable = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &_enable, sizeof(_enable));
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEPORT, &_enable, sizeof(_enable));
+    setsockopt(_fd, SOL_SOCKET, SO_BROADCAST, &_enable, sizeof(_enable));
+
+    sockaddr_in _address = {};
+    _address.sin_family = AF_INET;
+    _address.sin_port = htons(port);
+    _address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(_fd, reinterpret_cast<sockaddr*>(&_address), sizeof(_address)) != 0) {
+        ::close(_fd);
+        return false;
+    }
+
+    socketFd = _fd;
+
+    return true;
+}
+
+void ArtNetLinuxUdp::close() {
+
+    if (socketFd >= 0) {
+        ::close(socketFd);
+        socketFd = -1;
+    }
+}
+
+int ArtNetLinuxUdp::getSocket() {
+    return socketFd;
+}
+
+bool ArtNetLinuxUdp::sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort) {
+
+    if (socketFd < 0 || targetIpLen < 4) {
+        return false;
+    }
+
+    sockaddr_in _target = {};
+    _target.sin_family = AF_INET;
+    _target.sin_port = htons(targetPort);
+    memcpy(&_target.sin_addr.s_addr, targetIp, 4);
+
+    return sendto(socketFd, packet, packetLen, 0, reinterpret_cast<sockaddr*>(&_target), sizeof(_target)) == packetLen;
+}
+
+uint16_t ArtNetLinuxUdp::sendBatch(const ArtNet::txPacket *packets, uint16_t packetCount) {
+
+    if (socketFd < 0) {
+        return 0;
+    }
+
+    mmsghdr _messages[maxBatchLen];
+    iovec _vectors[maxBatchLen];
+    sockaddr_in _targets[maxBatchLen];
+
+    uint16_t _sent = 0;
+
+    while (_sent < packetCount) {
+
+        uint16_t _chunkLen = packetCount - _sent < maxBatchLen ? packetCount - _sent : maxBatchLen;
+
+        for (uint16_t i = 0; i < _chunkLen; i++) {
+
+            const ArtNet::txPacket &_packet = packets[_sent + i];
+
+            _targets[i].sin_family = AF_INET;
+            _targets[i].sin_port = htons(_packet.targetPort);
+            memcpy(&_targets[i].sin_addr.s_addr, _packet.targetIp, 4);
+
+            _vectors[i].iov_base = const_cast<uint8_t*>(_packet.data);
+            _vectors[i].iov_len = _packet.dataLen;
+
+            memset(&_messages[i].msg_hdr, 0, sizeof(_messages[i].msg_hdr));
+            _messages[i].msg_hdr.msg_name = &_targets[i];
+            _messages[i].msg_hdr.msg_namelen = sizeof(_targets[i]);
+            _messages[i].msg_hdr.msg_iov = &_vectors[i];
+            _messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int _result = sendmmsg(socketFd, _messages, _chunkLen, 0);
+
+        if (_result <= 0) {
+            break;
+        }
+
+        _sent += static_cast<uint16_t>(_result);
+    }
+
+    return _sent;
+}
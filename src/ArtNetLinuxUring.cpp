@@ -0,0 +1,559 @@
+#include <ArtNetLinuxUring.hpp>
+#include <ArtNetLinuxUdp.hpp>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+ArtNetLinuxUring *ArtNetLinuxUring::instance = nullptr;
+
+namespace {
+
+//memory shared with the kernel is accessed with the builtins, the kernel side does not know std::atomic
+inline uint32_t loadAcquire(const uint32_t *value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+inline void storeRelease(uint32_t *value, uint32_t newValue) {
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+void *mapAnonymous(size_t size) {
+    void *_memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    return _memory == MAP_FAILED ? nullptr : _memory;
+}
+
+}
+
+ArtNetLinuxUring::ArtNetLinuxUring(ArtNet &target) : device(target) {
+}
+
+ArtNetLinuxUring::~ArtNetLinuxUring() {
+    stop();
+}
+
+bool ArtNetLinuxUring::start(uint16_t localPort, uint16_t bufferCount) {
+
+    if (ringFd >= 0 || instance != nullptr) {
+        return false;
+    }
+
+    if (bufferCount < 16 || bufferCount > maxRxBuffers || (bufferCount & (bufferCount - 1)) != 0) {
+        return false;
+    }
+
+    if (!ArtNetLinuxUdp::open(localPort)) {
+        return false;
+    }
+
+    socketFd = ArtNetLinuxUdp::getSocket();
+    port = localPort;
+
+    int _bufferSize = 4 * 1024 * 1024;
+    setsockopt(socketFd, SOL_SOCKET, SO_RCVBUF, &_bufferSize, sizeof(_bufferSize));
+
+    //every send completes twice (result and buffer release), every receive buffer once
+    io_uring_params _params = {};
+    _params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    _params.cq_entries = bufferCount + 2u * txSlotCount;
+
+    ringFd = static_cast<int>(syscall(__NR_io_uring_setup, sqEntries, &_params));
+
+    if (ringFd < 0) {
+        //kernels before 6.1 do not know the task run flags
+        uint32_t _cqEntries = _params.cq_entries;
+        _params = {};
+        _params.flags = IORING_SETUP_CQSIZE;
+        _params.cq_entries = _cqEntries;
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, sqEntries, &_params));
+    }
+
+    if (ringFd < 0) {
+        release();
+        return false;
+    }
+
+    sqRingSize = _params.sq_off.array + _params.sq_entries * sizeof(uint32_t);
+    cqRingSize = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+
+    if (_params.features & IORING_FEAT_SINGLE_MMAP) {
+        sqRingSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+        cqRingSize = sqRingSize;
+    }
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        release();
+        return false;
+    }
+
+    if (_params.features & IORING_FEAT_SINGLE_MMAP) {
+        cqRing = sqRing;
+    }
+    else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            release();
+            return false;
+        }
+    }
+
+    sqesSize = _params.sq_entries * sizeof(io_uring_sqe);
+    void *_sqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (_sqes == MAP_FAILED) {
+        release();
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe*>(_sqes);
+
+    uint8_t *_sq = static_cast<uint8_t*>(sqRing);
+    uint8_t *_cq = static_cast<uint8_t*>(cqRing);
+
+    sqHead = reinterpret_cast<uint32_t*>(_sq + _params.sq_off.head);
+    sqTail = reinterpret_cast<uint32_t*>(_sq + _params.sq_off.tail);
+    sqArray = reinterpret_cast<uint32_t*>(_sq + _params.sq_off.array);
+    sqMask = *reinterpret_cast<uint32_t*>(_sq + _params.sq_off.ring_mask);
+    sqLocalTail = *sqTail;
+
+    cqHead = reinterpret_cast<uint32_t*>(_cq + _params.cq_off.head);
+    cqTail = reinterpret_cast<uint32_t*>(_cq + _params.cq_off.tail);
+    cqes = reinterpret_cast<io_uring_cqe*>(_cq + _params.cq_off.cqes);
+    cqMask = *reinterpret_cast<uint32_t*>(_cq + _params.cq_off.ring_mask);
+
+    //receive buffers, the kernel picks one per packet from the buffer ring
+    rxBufferCount = bufferCount;
+    bufferRingSize = bufferCount * sizeof(io_uring_buf);
+    bufferRing = static_cast<io_uring_buf_ring*>(mapAnonymous(bufferRingSize));
+    rxBuffers = static_cast<uint8_t*>(mapAnonymous(static_cast<size_t>(bufferCount) * rxBufferLen));
+
+    deferredSize = _params.cq_entries;
+    deferred = static_cast<deferredReceive*>(mapAnonymous(deferredSize * sizeof(deferredReceive)));
+
+    txSlots = static_cast<txSlot*>(mapAnonymous(txSlotCount * sizeof(txSlot)));
+
+    if (bufferRing == nullptr || rxBuffers == nullptr || deferred == nullptr || txSlots == nullptr) {
+        release();
+        return false;
+    }
+
+    io_uring_buf_reg _bufferReg = {};
+    _bufferReg.ring_addr = reinterpret_cast<uint64_t>(bufferRing);
+    _bufferReg.ring_entries = bufferCount;
+    _bufferReg.bgid = rxBufferGroup;
+
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PBUF_RING, &_bufferReg, 1) != 0) {
+        release();
+        return false;
+    }
+
+    bufferRingTail = 0;
+    for (uint16_t i = 0; i < bufferCount; i++) {
+        recycleBuffer(i);
+    }
+    commitBuffers();
+
+    //all transmit slots form one registered buffer, pinned once instead of on every send
+    iovec _txVector = {txSlots, txSlotCount * sizeof(txSlot)};
+
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, &_txVector, 1) != 0) {
+        release();
+        return false;
+    }
+
+    for (uint16_t i = 0; i < txSlotCount; i++) {
+        txSlots[i].nextFree = i + 1 < txSlotCount ? i + 1 : noTxSlot;
+    }
+    txFreeHead = 0;
+
+    //the sender address is written in front of the payload of every receive buffer
+    memset(&receiveHeader, 0, sizeof(receiveHeader));
+    receiveHeader.msg_namelen = sizeof(sockaddr_in);
+
+    counters = {};
+    deferredCount = 0;
+
+    if (!armReceive() || !submit(0, 0)) {
+        release();
+        return false;
+    }
+
+    instance = this;
+    device.setUnicastCallback(sendUnicast);
+    device.setBatchCallback(sendBatch);
+
+    return true;
+}
+
+void ArtNetLinuxUring::stop() {
+    release();
+}
+
+void ArtNetLinuxUring::release() {
+
+    if (instance == this) {
+        instance = nullptr;
+    }
+
+    //closing the ring cancels the multishot receive and all pending sends
+    if (ringFd >= 0) {
+        close(ringFd);
+        ringFd = -1;
+    }
+
+    if (sqes != nullptr) {
+        munmap(sqes, sqesSize);
+        sqes = nullptr;
+    }
+    if (cqRing != nullptr && cqRing != sqRing) {
+        munmap(cqRing, cqRingSize);
+    }
+    cqRing = nullptr;
+    if (sqRing != nullptr) {
+        munmap(sqRing, sqRingSize);
+        sqRing = nullptr;
+    }
+
+    if (bufferRing != nullptr) {
+        munmap(bufferRing, bufferRingSize);
+        bufferRing = nullptr;
+    }
+    if (rxBuffers != nullptr) {
+        munmap(rxBuffers, static_cast<size_t>(rxBufferCount) * rxBufferLen);
+        rxBuffers = nullptr;
+    }
+    if (deferred != nullptr) {
+        munmap(deferred, deferredSize * sizeof(deferredReceive));
+        deferred = nullptr;
+    }
+    if (txSlots != nullptr) {
+        munmap(txSlots, txSlotCount * sizeof(txSlot));
+        txSlots = nullptr;
+    }
+
+    if (socketFd >= 0) {
+        ArtNetLinuxUdp::close();
+        socketFd = -1;
+    }
+
+    receiveArmed = false;
+}
+
+io_uring_sqe *ArtNetLinuxUring::getSqe() {
+
+    if (sqLocalTail - loadAcquire(sqHead) > sqMask) {
+        submit(0, 0);
+
+        if (sqLocalTail - loadAcquire(sqHead) > sqMask) {
+            return nullptr;
+        }
+    }
+
+    uint32_t _index = sqLocalTail & sqMask;
+    sqArray[_index] = _index;
+    sqLocalTail++;
+
+    io_uring_sqe *_sqe = &sqes[_index];
+    memset(_sqe, 0, sizeof(*_sqe));
+
+    return _sqe;
+}
+
+bool ArtNetLinuxUring::submit(uint32_t waitFor, uint32_t timeOut) {
+
+    storeRelease(sqTail, sqLocalTail);
+
+    uint32_t _toSubmit = sqLocalTail - loadAcquire(sqHead);
+
+    //GETEVENTS also runs the deferred task work which posts the completions
+    unsigned _flags = IORING_ENTER_GETEVENTS;
+    __kernel_timespec _timeSpec = {};
+    io_uring_getevents_arg _arg = {};
+    void *_argPtr = nullptr;
+    size_t _argLen = 0;
+
+    if (waitFor > 0 && timeOut > 0) {
+        _timeSpec.tv_sec = timeOut / 1000000;
+        _timeSpec.tv_nsec = (timeOut % 1000000) * 1000;
+        _arg.ts = reinterpret_cast<uint64_t>(&_timeSpec);
+        _flags |= IORING_ENTER_EXT_ARG;
+        _argPtr = &_arg;
+        _argLen = sizeof(_arg);
+        counters.waits++;
+    }
+    else {
+        waitFor = 0;
+    }
+
+    long _result = syscall(__NR_io_uring_enter, ringFd, _toSubmit, waitFor, _flags, _argPtr, _argLen);
+
+    return _result >= 0 || errno == ETIME || errno == EINTR || errno == EBUSY;
+}
+
+bool ArtNetLinuxUring::armReceive() {
+
+    io_uring_sqe *_sqe = getSqe();
+
+    if (_sqe == nullptr) {
+        return false;
+    }
+
+    _sqe->opcode = IORING_OP_RECVMSG;
+    _sqe->fd = socketFd;
+    _sqe->addr = reinterpret_cast<uint64_t>(&receiveHeader);
+    _sqe->len = 1;
+    _sqe->ioprio = IORING_RECV_MULTISHOT;
+    _sqe->flags = IOSQE_BUFFER_SELECT;
+    _sqe->buf_group = rxBufferGroup;
+    _sqe->user_data = tagReceive;
+
+    receiveArmed = true;
+
+    return true;
+}
+
+void ArtNetLinuxUring::recycleBuffer(uint16_t bufferId) {
+
+    //only the fields of the entry are written, the tail shares the memory of the first entry.
+    //the flexible bufs member of the kernel header is laid out differently by C++, so the ring is indexed directly
+    io_uring_buf &_buffer = reinterpret_cast<io_uring_buf*>(bufferRing)[bufferRingTail & (rxBufferCount - 1)];
+    _buffer.addr = reinterpret_cast<uint64_t>(rxBuffers + static_cast<size_t>(bufferId) * rxBufferLen);
+    _buffer.len = rxBufferLen;
+    _buffer.bid = bufferId;
+
+    bufferRingTail++;
+}
+
+void ArtNetLinuxUring::commitBuffers() {
+    __atomic_store_n(&bufferRing->tail, bufferRingTail, __ATOMIC_RELEASE);
+}
+
+uint32_t ArtNetLinuxUring::reapCompletions(bool deferReceive) {
+
+    uint32_t _handled = 0;
+    uint32_t _head = *cqHead;
+
+    while (_head != loadAcquire(cqTail)) {
+
+        io_uring_cqe _cqe = cqes[_head & cqMask];
+
+        //released before handling, a reply sent by the handler may reap completions again
+        _head++;
+        storeRelease(cqHead, _head);
+
+        if (_cqe.user_data & tagReceive) {
+            if (deferReceive && deferredCount < deferredSize) {
+                deferred[deferredCount++] = {_cqe.res, _cqe.flags};
+            }
+            else {
+                _handled += handleReceive(_cqe.res, _cqe.flags);
+            }
+            continue;
+        }
+
+        uint16_t _slotIdx = static_cast<uint16_t>(_cqe.user_data);
+        bool _releaseSlot;
+
+        if (_cqe.flags & IORING_CQE_F_NOTIF) {
+            if (static_cast<uint32_t>(_cqe.res) & IORING_NOTIF_USAGE_ZC_COPIED) {
+                counters.sendCopied++;
+            }
+            _releaseSlot = true;
+        }
+        else {
+            if (_cqe.res < 0) {
+                counters.sendFailed++;
+            }
+            else {
+                counters.sent++;
+            }
+            //without F_MORE no notification follows
+            _releaseSlot = !(_cqe.flags & IORING_CQE_F_MORE);
+        }
+
+        if (_releaseSlot && _slotIdx < txSlotCount) {
+            txSlots[_slotIdx].nextFree = txFreeHead;
+            txFreeHead = _slotIdx;
+        }
+    }
+
+    return _handled;
+}
+
+uint32_t ArtNetLinuxUring::handleReceive(int32_t result, uint32_t flags) {
+
+    if (!(flags & IORING_CQE_F_MORE)) {
+        //the kernel stopped the multishot receive, usually because it ran out of buffers
+        receiveArmed = false;
+    }
+
+    if (!(flags & IORING_CQE_F_BUFFER)) {
+        return 0;
+    }
+
+    uint16_t _bufferId = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+
+    if (result < 0 || _bufferId >= rxBufferCount) {
+        return 0;
+    }
+
+    //buffer layout: recvmsg_out, sender address, payload
+    uint8_t *_buffer = rxBuffers + static_cast<size_t>(_bufferId) * rxBufferLen;
+    const io_uring_recvmsg_out *_out = reinterpret_cast<const io_uring_recvmsg_out*>(_buffer);
+    sockaddr_in *_sender = reinterpret_cast<sockaddr_in*>(_buffer + sizeof(io_uring_recvmsg_out));
+    uint32_t _payloadOffset = sizeof(io_uring_recvmsg_out) + receiveHeader.msg_namelen + receiveHeader.msg_controllen;
+    uint32_t _payloadLen = _out->payloadlen;
+
+    if ((_out->flags & MSG_TRUNC) || _payloadLen > rxBufferLen - _payloadOffset) {
+        counters.truncated++;
+        _payloadLen = rxBufferLen - _payloadOffset;
+    }
+
+    counters.received++;
+    device.handlePacket(_buffer + _payloadOffset, static_cast<uint16_t>(_payloadLen),
+        reinterpret_cast<uint8_t*>(&_sender->sin_addr.s_addr), 4, port);
+
+    recycleBuffer(_bufferId);
+
+    return 1;
+}
+
+bool ArtNetLinuxUring::queueSend(const uint8_t *packet, uint16_t packetLen, const uint8_t *targetIp, uint16_t targetPort) {
+
+    if (packetLen > txSlotLen) {
+        counters.sendFailed++;
+        return false;
+    }
+
+    if (txFreeHead == noTxSlot) {
+        //collect released slots, received packets are kept for the next processEvents()
+        submit(0, 0);
+        reapCompletions(true);
+
+        if (txFreeHead == noTxSlot) {
+            submit(1, 1000);
+            reapCompletions(true);
+        }
+
+        if (txFreeHead == noTxSlot) {
+            counters.txFull++;
+            return false;
+        }
+    }
+
+    io_uring_sqe *_sqe = getSqe();
+
+    if (_sqe == nullptr) {
+        counters.txFull++;
+        return false;
+    }
+
+    uint16_t _slotIdx = txFreeHead;
+    txSlot &_slot = txSlots[_slotIdx];
+    txFreeHead = _slot.nextFree;
+
+    memcpy(_slot.data, packet, packetLen);
+    _slot.target = {};
+    _slot.target.sin_family = AF_INET;
+    _slot.target.sin_port = htons(targetPort);
+    memcpy(&_slot.target.sin_addr.s_addr, targetIp, 4);
+
+    _sqe->opcode = IORING_OP_SEND_ZC;
+    _sqe->fd = socketFd;
+    _sqe->addr = reinterpret_cast<uint64_t>(_slot.data);
+    _sqe->len = packetLen;
+    _sqe->ioprio = IORING_RECVSEND_FIXED_BUF | IORING_SEND_ZC_REPORT_USAGE;
+    _sqe->buf_index = 0;
+    _sqe->addr2 = reinterpret_cast<uint64_t>(&_slot.target);
+    _sqe->addr_len = sizeof(_slot.target);
+    _sqe->user_data = _slotIdx;
+
+    return true;
+}
+
+uint32_t ArtNetLinuxUring::processEvents(uint32_t timeOut) {
+
+    if (ringFd < 0) {
+        return 0;
+    }
+
+    inEvents = true;
+
+    uint32_t _handled = 0;
+
+    //packets which arrived while the send path waited for transmit slots
+    for (uint32_t i = 0; i < deferredCount; i++) {
+        _handled += handleReceive(deferred[i].result, deferred[i].flags);
+    }
+    deferredCount = 0;
+
+    commitBuffers();
+
+    if (!receiveArmed && armReceive()) {
+        counters.receiveRearmed++;
+    }
+
+    bool _ready = *cqHead != loadAcquire(cqTail);
+    submit(_ready || _handled > 0 ? 0 : 1, timeOut);
+
+    _handled += reapCompletions(false);
+
+    commitBuffers();
+
+    if (!receiveArmed && armReceive()) {
+        counters.receiveRearmed++;
+    }
+
+    //replies queued by the handlers leave right away
+    if (sqLocalTail != loadAcquire(sqHead)) {
+        submit(0, 0);
+    }
+
+    inEvents = false;
+
+    return _handled;
+}
+
+bool ArtNetLinuxUring::sendUnicast(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort) {
+
+    if (instance == nullptr || targetIpLen < 4) {
+        return false;
+    }
+
+    if (!instance->queueSend(packet, packetLen, targetIp, targetPort)) {
+        return false;
+    }
+
+    if (!instance->inEvents) {
+        instance->submit(0, 0);
+    }
+
+    return true;
+}
+
+uint16_t ArtNetLinuxUring::sendBatch(const ArtNet::txPacket *packets, uint16_t packetCount) {
+
+    if (instance == nullptr) {
+        return 0;
+    }
+
+    uint16_t _queued = 0;
+
+    while (_queued < packetCount) {
+        const ArtNet::txPacket &_packet = packets[_queued];
+
+        if (!instance->queueSend(_packet.data, _packet.dataLen, _packet.targetIp, _packet.targetPort)) {
+            break;
+        }
+        _queued++;
+    }
+
+    if (!instance->inEvents) {
+        instance->submit(0, 0);
+    }
+
+    return _queued;
+}
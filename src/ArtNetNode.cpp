@@ -0,0 +1,956 @@
+#include <ArtNetNode.hpp>
+#include <ArtNetSimd.hpp>
+#include <stdio.h>
+#include <string.h>
+
+ArtNetNode::ArtNetNode(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, portConfig *configs, nodePort *portStates,
+    ArtPollReplyPacket *replies, portMapEntry *portMapStorage, uint16_t portCount, uint16_t mapSize,
+    nzsFrame *nzsStorage, uint8_t nzsLen)
+    :ArtNet(oemCode, MAC, MACLen), nodePorts(portStates), portMap(portMapStorage), portMapMask(mapSize - 1),
+    nzsFrames(nzsStorage), nzsQueueLen(nzsLen){
+
+    sysConf.deviceStyle = StNode;
+    sysConf.VLCActive = true;
+    setPortStorage(configs, portCount, replies);
+    rebuildPortMap();
+}
+
+ArtNetNode::~ArtNetNode() {
+}
+
+void ArtNetNode::setOutputDmxCallback(bool (*callback)(uint8_t *dmxData, uint16_t dmxDataSize, uint16_t portIdx)) {
+    callback_outputDmx = callback;
+}
+
+void ArtNetNode::setOutputNzsCallback(bool (*callback)(uint8_t startCode, uint8_t *data, uint16_t dataSize, uint16_t portIdx)) {
+    callback_outputNzs = callback;
+}
+
+void ArtNetNode::setOutputVlcCallback(bool (*callback)(const vlcFrame &frame, uint16_t portIdx)) {
+    callback_outputVlc = callback;
+}
+
+bool ArtNetNode::configureOutputPort(uint16_t portIdx, uint16_t portAddress) {
+
+    if (portIdx >= numPorts || portAddress > 0x7fff) {
+        return false;
+    }
+
+    //a page is reported with a single net and sub-net
+    uint16_t _pageStart = portIdx & ~3;
+    for (uint16_t i = _pageStart; i < numPorts && i < _pageStart + 4; i++) {
+        if (i != portIdx && (ports[i].isInput || ports[i].isOutput) && (ports[i].portAddress >> 4) != (portAddress >> 4)) {
+            return false;
+        }
+    }
+
+    ports[portIdx].portAddress = portAddress;
+    ports[portIdx].isOutput = true;
+
+    rebuildPortMap();
+    markPollReplyDirty();
+
+    return true;
+}
+
+void ArtNetNode::setNetSubSwitch(uint8_t netSwitch, uint8_t subSwitch) {
+
+    ArtNet::setNetSubSwitch(netSwitch, subSwitch);
+    rebuildPortMap();
+}
+
+void ArtNetNode::rebuildPortMap() {
+
+    for (uint16_t i = 0; i <= portMapMask; i++) {
+        portMap[i].portAddress = noPort;
+    }
+
+    //ports are inserted in reverse so every chain of equal Port-Addresses is in port order
+    for (uint16_t i = numPorts; i-- > 0;) {
+
+        nodePorts[i].nextSameAddress = noPort;
+
+        if (!ports[i].isOutput) {
+            continue;
+        }
+
+        uint16_t _slot = (ports[i].portAddress * 40503u) & portMapMask;
+
+        while (portMap[_slot].portAddress != noPort && portMap[_slot].portAddress != ports[i].portAddress) {
+            _slot = (_slot + 1) & portMapMask;
+        }
+
+        if (portMap[_slot].portAddress != noPort) {
+            nodePorts[i].nextSameAddress = portMap[_slot].portIdx;
+        }
+
+        portMap[_slot].portAddress = ports[i].portAddress;
+        portMap[_slot].portIdx = i;
+    }
+
+    //the output ports changed, service() rebuilds the fail-safe timers
+    failSafe.reset.store(true, std::memory_order_release);
+}
+
+uint16_t ArtNetNode::findPort(uint16_t portAddress) const {
+
+    uint16_t _slot = (portAddress * 40503u) & portMapMask;
+
+    while (portMap[_slot].portAddress != noPort) {
+
+        if (portMap[_slot].portAddress == portAddress) {
+            return portMap[_slot].portIdx;
+        }
+
+        _slot = (_slot + 1) & portMapMask;
+    }
+
+    return noPort;
+}
+
+void ArtNetNode::publishFrame(uint16_t portIdx) {
+
+    portFrameStore &_store = nodePorts[portIdx].frames;
+
+    uint8_t _previous = _store.handoff.exchange(_store.back | newFrameFlag, std::memory_order_acq_rel);
+    _store.back = _previous & frameIdxMask;
+}
+
+ArtNet::packetStatus ArtNetNode::handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t) {
+
+    wireReader<artDmxLayout> _packet(packet);
+
+    //SubUni and Net form the 15 bit Port-Address
+    uint16_t _portAddress = _packet.get<artDmxLayout::portAddress>() & 0x7fff;
+    uint16_t _length = _packet.get<artDmxLayout::dataLength>();
+    uint8_t _sequence = _packet.get<artDmxLayout::sequence>();
+
+    if (_length == 0 || _length > maxDmxSlots || _length > packetLen - artDmxHeaderLen) {
+        return psInvalidContent;
+    }
+
+    uint64_t _now = getMicros();
+
+    //leaving sync mode publishes the frames staged on all ports, which is done by serviceReceive()
+    //where no other port is handled at the same time
+    bool _syncActive = sync.active.load(std::memory_order_relaxed) && sync.enabled.load(std::memory_order_relaxed);
+
+    for (uint16_t i = findPort(_portAddress); i != noPort; i = nodePorts[i].nextSameAddress) {
+
+        countArrival(nodePorts[i].metrics, _length, _now);
+
+        if (!mergeFrame(i, _packet.bytes<artDmxLayout::data>(), _length, _sequence, senderIp, _now)) {
+            continue;
+        }
+
+        //stale frames and frames of sources beyond the merge limit keep the fail-safe timer running
+        nodePorts[i].failSafe.lastReceived.store(_now, std::memory_order_relaxed);
+
+        if (_syncActive) {
+            nodePorts[i].staged = true;
+        }
+        else {
+            publishFrame(i);
+            nodePorts[i].staged = false;
+        }
+    }
+
+    return psOk;
+}
+
+ArtNet::packetStatus ArtNetNode::handleArtSync(const uint8_t *, uint16_t, uint8_t *, uint8_t) {
+
+    if (!sync.enabled.load(std::memory_order_relaxed)) {
+        return psOk;
+    }
+
+    uint64_t _now = getMicros();
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        if (countActiveSources(i, _now) > 1) {
+            return psOk;
+        }
+    }
+
+    sync.active.store(true, std::memory_order_relaxed);
+    sync.lastSyncReceived.store(_now, std::memory_order_relaxed);
+
+    publishStagedFrames();
+
+    return psOk;
+}
+
+void ArtNetNode::publishStagedFrames() {
+
+    publishSequence.fetch_add(1, std::memory_order_acq_rel);
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        if (nodePorts[i].staged) {
+            publishFrame(i);
+            nodePorts[i].staged = false;
+        }
+    }
+
+    publishSequence.fetch_add(1, std::memory_order_release);
+}
+
+void ArtNetNode::enableSync(bool enable) {
+    sync.enabled.store(enable, std::memory_order_relaxed);
+}
+
+ArtNet::packetStatus ArtNetNode::handleArtNzs(const uint8_t *packet, uint16_t packetLen, uint8_t *, uint8_t) {
+
+    wireReader<artNzsLayout> _packet(packet);
+
+    uint16_t _portAddress = _packet.get<artNzsLayout::portAddress>() & 0x7fff;
+    uint16_t _length = _packet.get<artNzsLayout::dataLength>();
+    uint8_t _startCode = _packet.get<artNzsLayout::startCode>();
+    const uint8_t *_data = _packet.bytes<artNzsLayout::data>();
+
+    //zero start code data has to be sent as ArtDmx
+    if (_startCode == 0 || _length == 0 || _length > maxDmxSlots || _length > packetLen - artDmxHeaderLen) {
+        return psInvalidContent;
+    }
+
+    bool _isVlc = _startCode == vlcStartCode && _length >= sizeof(vlcMagic) && memcmp(_data, vlcMagic, sizeof(vlcMagic)) == 0;
+
+    if (_isVlc && !isValidVlc(_data, _length)) {
+        return psInvalidContent;
+    }
+
+    if ((_isVlc && !sysConf.VLCActive) || nzsQueueLen == 0) {
+        return psOk;
+    }
+
+    for (uint16_t i = findPort(_portAddress); i != noPort; i = nodePorts[i].nextSameAddress) {
+        queueNzsFrame(i, _startCode, _isVlc, _data, _length);
+    }
+
+    return psOk;
+}
+
+bool ArtNetNode::isValidVlc(const uint8_t *data, uint16_t length) {
+
+    if (length < artVlcHeaderLen) {
+        return false;
+    }
+
+    wireReader<artVlcLayout> _vlc(data);
+    uint16_t _payloadLen = _vlc.get<artVlcLayout::payloadCount>();
+
+    if (_payloadLen > length - artVlcHeaderLen) {
+        return false;
+    }
+
+    //the checksum is the 16 bit sum of the payload bytes
+    const uint8_t *_payload = _vlc.bytes<artVlcLayout::payload>();
+    uint16_t _checksum = 0;
+    for (uint16_t i = 0; i < _payloadLen; i++) {
+        _checksum = static_cast<uint16_t>(_checksum + _payload[i]);
+    }
+
+    return _checksum == _vlc.get<artVlcLayout::payloadChecksum>();
+}
+
+bool ArtNetNode::queueNzsFrame(uint16_t portIdx, uint8_t startCode, bool isVlc, const uint8_t *data, uint16_t length) {
+
+    nodePort &_port = nodePorts[portIdx];
+    portMetrics &_metrics = _port.metrics;
+    uint8_t _head = _port.nzsHead.load(std::memory_order_relaxed);
+
+    if (static_cast<uint8_t>(_head - _port.nzsTail.load(std::memory_order_acquire)) >= nzsQueueLen) {
+        _metrics.nzsDropped.store(_metrics.nzsDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    nzsFrame &_frame = nzsFrames[portIdx * nzsQueueLen + _head % nzsQueueLen];
+
+    memcpy(_frame.slots, data, length);
+    _frame.length = length;
+    _frame.startCode = startCode;
+    _frame.isVlc = isVlc;
+
+    _port.nzsHead.store(_head + 1, std::memory_order_release);
+    _metrics.nzsFrames.store(_metrics.nzsFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool ArtNetNode::mergeFrame(uint16_t portIdx, const uint8_t *slots, uint16_t length, uint8_t sequence, const uint8_t *senderIp, uint64_t now) {
+
+    portMergeState &_merge = nodePorts[portIdx].merge;
+    mergeSource *_source = nullptr;
+    mergeSource *_freeSource = nullptr;
+
+    for (mergeSource &_candidate : _merge.sources) {
+
+        if (_candidate.active && now - _candidate.lastReceived > mergeTimeOut * 1000000ULL) {
+            _candidate.active = false;
+            markPollReplyDirty();
+        }
+
+        if (_candidate.active && memcmp(_candidate.ip, senderIp, ipAddressLen) == 0) {
+            _source = &_candidate;
+        }
+        else if (!_candidate.active && _freeSource == nullptr) {
+            _freeSource = &_candidate;
+        }
+    }
+
+    if (_merge.cancelPending) {
+        //only the source of the first frame after the cancel command is kept
+        for (mergeSource &_candidate : _merge.sources) {
+            _candidate.active = &_candidate == _source;
+        }
+        _freeSource = _source == nullptr ? &_merge.sources[0] : nullptr;
+        _merge.cancelPending = false;
+        markPollReplyDirty();
+    }
+
+    if (_source == nullptr) {
+
+        if (_freeSource == nullptr) {
+            //the spec only merges two sources, further sources are ignored
+            return false;
+        }
+
+        //the slots of the source which left stay out of the HTP merge of the new one
+        _source = _freeSource;
+        memcpy(_source->ip, senderIp, ipAddressLen);
+        memset(_source->frame.slots, 0, _source->frame.length);
+        _source->frame.length = 0;
+        _source->lastSequence = 0;
+        _source->active = true;
+        markPollReplyDirty();
+    }
+
+    _source->lastReceived = now;
+
+    portMetrics &_metrics = nodePorts[portIdx].metrics;
+    reorderHold &_hold = nodePorts[portIdx].hold;
+    uint8_t _sourceIdx = static_cast<uint8_t>(_source - _merge.sources);
+    bool _updated = false;
+
+    //an expired hold goes out before the current frame
+    if (_hold.active && now >= _hold.until) {
+        _updated = releaseHold(portIdx);
+    }
+
+    //sequence 0 disables the check
+    int16_t _distance = sequence != 0 && _source->lastSequence != 0 ? sequenceDistance(_source->lastSequence, sequence) : 1;
+    bool _holdSource = _hold.active && _hold.source == _sourceIdx;
+
+    if (_distance <= 0 && _distance > -maxReorderDistance) {
+
+        _metrics.outOfOrder.store(_metrics.outOfOrder.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (sequenceCheck.dropStale) {
+            return _updated;
+        }
+    }
+    else {
+
+        if (_holdSource && (_distance <= 0 || sequenceDistance(_hold.sequence, sequence) >= 0)) {
+            //newer than the held frame or the source restarted, the held frame is outdated
+            _hold.active = false;
+            _holdSource = false;
+        }
+        else if (!_hold.active && _distance > 1 && sequenceCheck.reorderWindow != 0) {
+            //a frame is missing, give it a moment to arrive before this one is applied
+            memcpy(_hold.frame.slots, slots, length);
+            _hold.frame.length = length;
+            _hold.sequence = sequence;
+            _hold.source = _sourceIdx;
+            _hold.until = now + sequenceCheck.reorderWindow;
+            _hold.active = true;
+            _metrics.held.store(_metrics.held.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return _updated;
+        }
+
+        if (_distance > 1) {
+            _metrics.sequenceGaps.store(_metrics.sequenceGaps.load(std::memory_order_relaxed) + _distance - 1, std::memory_order_relaxed);
+        }
+
+        //large backwards jumps restart the sequence of the source
+        _source->lastSequence = sequence;
+    }
+
+    applyFrame(portIdx, *_source, slots, length);
+
+    if (_holdSource && sequenceDistance(sequence, _hold.sequence) == 1) {
+        //the last missing frame arrived, the held frame follows right away
+        releaseHold(portIdx);
+    }
+
+    return true;
+}
+
+void ArtNetNode::applyFrame(uint16_t portIdx, mergeSource &source, const uint8_t *slots, uint16_t length) {
+
+    portMergeState &_merge = nodePorts[portIdx].merge;
+
+    //slots beyond the new length have to be zero for the HTP merge
+    if (length < source.frame.length) {
+        memset(source.frame.slots + length, 0, source.frame.length - length);
+    }
+    memcpy(source.frame.slots, slots, length);
+    source.frame.length = length;
+
+    dmxFrame &_out = nodePorts[portIdx].frames.frames[nodePorts[portIdx].frames.back];
+    mergeSource &_other = _merge.sources[&source == &_merge.sources[0] ? 1 : 0];
+
+    if (_merge.ltpMode || !_other.active) {
+        memcpy(_out.slots, slots, length);
+        _out.length = length;
+        return;
+    }
+
+    dmxMergeHtp(_out.slots, _merge.sources[0].frame.slots, _merge.sources[1].frame.slots, maxDmxSlots);
+    _out.length = _other.frame.length > length ? _other.frame.length : length;
+}
+
+bool ArtNetNode::releaseHold(uint16_t portIdx) {
+
+    reorderHold &_hold = nodePorts[portIdx].hold;
+    mergeSource &_source = nodePorts[portIdx].merge.sources[_hold.source];
+    portMetrics &_metrics = nodePorts[portIdx].metrics;
+
+    _hold.active = false;
+
+    if (!_source.active) {
+        return false;
+    }
+
+    int16_t _distance = _source.lastSequence != 0 ? sequenceDistance(_source.lastSequence, _hold.sequence) : 1;
+
+    if (_distance > 1) {
+        _metrics.sequenceGaps.store(_metrics.sequenceGaps.load(std::memory_order_relaxed) + _distance - 1, std::memory_order_relaxed);
+    }
+
+    _source.lastSequence = _hold.sequence;
+    applyFrame(portIdx, _source, _hold.frame.slots, _hold.frame.length);
+    return true;
+}
+
+void ArtNetNode::setSequenceCheck(bool dropStale, uint16_t reorderWindow) {
+    sequenceCheck.dropStale = dropStale;
+    sequenceCheck.reorderWindow = reorderWindow;
+}
+
+void ArtNetNode::countArrival(portMetrics &metrics, uint16_t length, uint64_t now) {
+
+    //single writer, a plain load and store is enough
+    metrics.packets.store(metrics.packets.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    metrics.bytes.store(metrics.bytes.load(std::memory_order_relaxed) + length, std::memory_order_relaxed);
+
+    if (metrics.lastArrival != 0) {
+
+        uint64_t _interval = now - metrics.lastArrival;
+
+        if (metrics.lastInterval != 0) {
+            uint64_t _change = _interval > metrics.lastInterval ? _interval - metrics.lastInterval : metrics.lastInterval - _interval;
+
+            uint8_t _bucket = 0;
+            for (_change >>= 7; _change != 0 && _bucket < jitterBuckets - 1; _change >>= 1) {
+                _bucket++;
+            }
+
+            std::atomic<uint32_t> &_count = metrics.jitter[_bucket];
+            _count.store(_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        metrics.lastInterval = _interval;
+    }
+
+    metrics.lastArrival = now;
+}
+
+uint8_t ArtNetNode::countActiveSources(uint16_t portIdx, uint64_t now) {
+
+    uint8_t _count = 0;
+
+    for (const mergeSource &_source : nodePorts[portIdx].merge.sources) {
+        if (_source.active && now - _source.lastReceived <= mergeTimeOut * 1000000ULL) {
+            _count++;
+        }
+    }
+
+    return _count;
+}
+
+void ArtNetNode::updatePortStatus(ArtPollReplyPacket &reply, uint16_t page) {
+
+    wireWriter<artPollReplyLayout> _reply(reply.data);
+    uint64_t _now = getMicros();
+
+    for (uint8_t i = 0; i < 4 && page * 4 + i < numPorts; i++) {
+        _reply.set<artPollReplyLayout::isMergingArtNet>(i, countActiveSources(page * 4 + i, _now) > 1);
+        _reply.set<artPollReplyLayout::ltpIsMergeMode>(i, nodePorts[page * 4 + i].merge.ltpMode);
+    }
+
+    _reply.set<artPollReplyLayout::failSafeState>(failSafe.mode.load(std::memory_order_relaxed));
+    _reply.set<artPollReplyLayout::progFailSafeSupported>(true);
+}
+
+bool ArtNetNode::setMergeMode(uint16_t portIdx, bool ltp) {
+
+    if (portIdx >= numPorts) {
+        return false;
+    }
+
+    nodePorts[portIdx].merge.ltpMode = ltp;
+    markPollReplyDirty();
+
+    return true;
+}
+
+void ArtNetNode::applyAddressCommand(uint8_t command, uint16_t page) {
+
+    uint16_t _portIdx = static_cast<uint16_t>(page * 4 + (command & 0x03));
+
+    switch (command & 0xfc) {
+        case acMergeLtp0:
+        case acMergeHtp0:
+            if (_portIdx < numPorts) {
+                nodePorts[_portIdx].merge.ltpMode = (command & 0xfc) == acMergeLtp0;
+            }
+            break;
+        case acDirectionTx0:
+            if (_portIdx < numPorts) {
+                ports[_portIdx].isInput = false;
+                ports[_portIdx].isOutput = true;
+            }
+            break;
+        case acFailHold:
+            //acFailHold to acFailScene follow the order of failSafeStates
+            failSafe.mode.store(static_cast<uint8_t>(command - acFailHold), std::memory_order_relaxed);
+            failSafe.reset.store(true, std::memory_order_release);
+            break;
+        case acFailRecord:
+            recordFailSafeScene();
+            break;
+        default:
+            if (command == acCancelMerge) {
+                cancelMerge();
+            }
+            else {
+                ArtNet::applyAddressCommand(command, page);
+            }
+            break;
+    }
+}
+
+void ArtNetNode::portsChanged() {
+    rebuildPortMap();
+}
+
+void ArtNetNode::cancelMerge() {
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        nodePorts[i].merge.cancelPending = true;
+    }
+}
+
+uint16_t ArtNetNode::processOutputs() {
+
+    uint16_t _outputCount = 0;
+    uint32_t _sequence;
+
+    do {
+        _sequence = publishSequence.load(std::memory_order_acquire);
+
+        if (_sequence & 1) {
+            //a synchronous batch is being published, take it as a whole on the next call
+            return _outputCount;
+        }
+
+        for (uint16_t i = 0; i < numPorts; i++) {
+
+            portFrameStore &_store = nodePorts[i].frames;
+            failSafePort &_failSafe = nodePorts[i].failSafe;
+
+            if (!(_store.handoff.load(std::memory_order_relaxed) & newFrameFlag)) {
+
+                if (_failSafe.pending.load(std::memory_order_relaxed) && outputFailSafe(i)) {
+                    _outputCount++;
+                }
+            }
+            else {
+                uint8_t _previous = _store.handoff.exchange(_store.front, std::memory_order_acq_rel);
+                _store.front = _previous & frameIdxMask;
+
+                //data arrived again, a fail-safe output still due is dropped
+                _failSafe.pending.store(false, std::memory_order_relaxed);
+
+                dmxFrame &_frame = _store.frames[_store.front];
+
+                if (callback_outputDmx != nullptr && callback_outputDmx(_frame.slots, _frame.length, i)) {
+                    _outputCount++;
+                }
+            }
+
+            if (_failSafe.record.load(std::memory_order_relaxed) && _failSafe.record.exchange(false, std::memory_order_acq_rel)) {
+                const dmxFrame &_frame = _store.frames[_store.front];
+                memcpy(_failSafe.scene.slots, _frame.slots, _frame.length);
+                _failSafe.scene.length = _frame.length;
+            }
+        }
+    //a batch started while outputting, output the rest of it right away
+    } while (_sequence != publishSequence.load(std::memory_order_acquire));
+
+    return _outputCount;
+}
+
+uint16_t ArtNetNode::processNzsOutputs() {
+
+    uint16_t _outputCount = 0;
+
+    for (uint16_t i = 0; i < numPorts && nzsQueueLen > 0; i++) {
+
+        nodePort &_port = nodePorts[i];
+        uint8_t _tail = _port.nzsTail.load(std::memory_order_relaxed);
+        uint8_t _head = _port.nzsHead.load(std::memory_order_acquire);
+
+        while (_tail != _head) {
+
+            if (outputNzsFrame(nzsFrames[i * nzsQueueLen + _tail % nzsQueueLen], i)) {
+                _outputCount++;
+            }
+
+            //the slot is released once its frame was output
+            _port.nzsTail.store(++_tail, std::memory_order_release);
+        }
+    }
+
+    return _outputCount;
+}
+
+bool ArtNetNode::outputNzsFrame(nzsFrame &frame, uint16_t portIdx) {
+
+    if (!frame.isVlc || callback_outputVlc == nullptr) {
+        return callback_outputNzs != nullptr && callback_outputNzs(frame.startCode, frame.slots, frame.length, portIdx);
+    }
+
+    wireReader<artVlcLayout> _vlc(frame.slots);
+    vlcFrame _frame;
+
+    _frame.payload = _vlc.bytes<artVlcLayout::payload>();
+    _frame.payloadLen = _vlc.get<artVlcLayout::payloadCount>();
+    _frame.transaction = _vlc.get<artVlcLayout::transaction>();
+    _frame.slotAddress = _vlc.get<artVlcLayout::slotAddress>();
+    _frame.frequency = _vlc.get<artVlcLayout::frequency>();
+    _frame.modulation = _vlc.get<artVlcLayout::modulation>();
+    _frame.payloadLanguage = _vlc.get<artVlcLayout::payloadLanguage>();
+    _frame.beaconRepeat = _vlc.get<artVlcLayout::beaconRepeat>();
+    _frame.depth = _vlc.get<artVlcLayout::depth>();
+    _frame.ieee = _vlc.get<artVlcLayout::ieee>();
+    _frame.reply = _vlc.get<artVlcLayout::reply>();
+    _frame.beacon = _vlc.get<artVlcLayout::beacon>();
+
+    return callback_outputVlc(_frame, portIdx);
+}
+
+bool ArtNetNode::getPortMetrics(uint16_t portIdx, portMetricsSnapshot &snapshot) const {
+
+    if (portIdx >= numPorts) {
+        return false;
+    }
+
+    const portMetrics &_metrics = nodePorts[portIdx].metrics;
+
+    snapshot.packets = _metrics.packets.load(std::memory_order_relaxed);
+    snapshot.bytes = _metrics.bytes.load(std::memory_order_relaxed);
+    snapshot.sequenceGaps = _metrics.sequenceGaps.load(std::memory_order_relaxed);
+    snapshot.outOfOrder = _metrics.outOfOrder.load(std::memory_order_relaxed);
+    snapshot.held = _metrics.held.load(std::memory_order_relaxed);
+    snapshot.nzsFrames = _metrics.nzsFrames.load(std::memory_order_relaxed);
+    snapshot.nzsDropped = _metrics.nzsDropped.load(std::memory_order_relaxed);
+
+    for (uint8_t i = 0; i < jitterBuckets; i++) {
+        snapshot.jitter[i] = _metrics.jitter[i].load(std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+void ArtNetNode::setMetricsReport(uint16_t interval, bool toNodeReport, bool toDiagData) {
+
+    report.interval = interval * 1000000ULL;
+    report.lastReport = getMicros();
+    report.toNodeReport = toNodeReport;
+    report.toDiagData = toDiagData;
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        nodePorts[i].metrics.reportedPackets = nodePorts[i].metrics.packets.load(std::memory_order_relaxed);
+    }
+}
+
+void ArtNetNode::serviceReceive() {
+
+    ArtNet::serviceReceive();
+
+    bool _syncActive = sync.active.load(std::memory_order_relaxed);
+    uint64_t _now = getMicros();
+
+    //a source which stalled after a sequence gap sends no frame which would release its hold
+    for (uint16_t i = 0; i < numPorts; i++) {
+
+        reorderHold &_hold = nodePorts[i].hold;
+
+        if (!_hold.active || _now < _hold.until || !releaseHold(i)) {
+            continue;
+        }
+
+        if (_syncActive) {
+            nodePorts[i].staged = true;
+        }
+        else {
+            publishFrame(i);
+        }
+    }
+
+    if (!_syncActive) {
+        return;
+    }
+
+    if (!sync.enabled.load(std::memory_order_relaxed) || (callback_getMicros != nullptr &&
+        getMicros() - sync.lastSyncReceived.load(std::memory_order_relaxed) > syncTimeOut * 1000000ULL)) {
+        //sync stopped arriving, fall back to immediate output with what is staged
+        sync.active.store(false, std::memory_order_relaxed);
+        publishStagedFrames();
+    }
+}
+
+void ArtNetNode::service() {
+
+    ArtNet::service();
+
+    if (callback_getMicros != nullptr) {
+        serviceFailSafe(getMicros());
+    }
+
+    if (report.interval == 0) {
+        return;
+    }
+
+    uint64_t _now = getMicros();
+
+    if (_now - report.lastReport >= report.interval) {
+        publishMetrics(_now - report.lastReport);
+        report.lastReport = _now;
+    }
+}
+
+bool ArtNetNode::setFailSafe(uint8_t mode, uint16_t timeOut) {
+
+    if (mode > fssPlayScene || timeOut == 0) {
+        return false;
+    }
+
+    failSafe.mode.store(mode, std::memory_order_relaxed);
+    failSafe.timeOut = timeOut * 1000u / failSafeTick;
+    failSafe.reset.store(true, std::memory_order_release);
+    markPollReplyDirty();
+
+    return true;
+}
+
+void ArtNetNode::recordFailSafeScene() {
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        nodePorts[i].failSafe.record.store(true, std::memory_order_release);
+    }
+}
+
+void ArtNetNode::scheduleFailSafe(uint16_t portIdx, uint64_t due) {
+
+    failSafePort &_port = nodePorts[portIdx].failSafe;
+    uint16_t *_slot;
+
+    if (due < failSafe.tick) {
+        due = failSafe.tick;
+    }
+
+    //time outs are below wheelSlots * wheelSlots ticks, so a level 1 slot is never reached twice before it is due
+    if (due - failSafe.tick < wheelSlots) {
+        _slot = &failSafe.level0[due & wheelMask];
+    }
+    else {
+        _slot = &failSafe.level1[(due >> wheelBits) & wheelMask];
+    }
+
+    _port.timerDue = due;
+    _port.nextTimer = *_slot;
+    *_slot = portIdx;
+}
+
+void ArtNetNode::resetFailSafe(uint64_t tick) {
+
+    for (uint16_t i = 0; i < wheelSlots; i++) {
+        failSafe.level0[i] = noPort;
+        failSafe.level1[i] = noPort;
+    }
+
+    failSafe.tick = tick;
+
+    if (failSafe.mode.load(std::memory_order_relaxed) == fssLastState) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        if (ports[i].isOutput) {
+            scheduleFailSafe(i, tick + failSafe.timeOut);
+        }
+    }
+}
+
+void ArtNetNode::serviceFailSafe(uint64_t now) {
+
+    uint64_t _tick = now / failSafeTick;
+
+    //after a long pause of service() the timers are rebuilt instead of replaying every tick
+    if (failSafe.reset.exchange(false, std::memory_order_acq_rel) || _tick - failSafe.tick >= wheelSlots * wheelSlots) {
+        resetFailSafe(_tick);
+        return;
+    }
+
+    while (failSafe.tick < _tick) {
+
+        failSafe.tick++;
+
+        //every wheelSlots ticks the next level 1 slot moves down
+        if ((failSafe.tick & wheelMask) == 0) {
+
+            uint16_t _portIdx = failSafe.level1[(failSafe.tick >> wheelBits) & wheelMask];
+            failSafe.level1[(failSafe.tick >> wheelBits) & wheelMask] = noPort;
+
+            while (_portIdx != noPort) {
+                uint16_t _next = nodePorts[_portIdx].failSafe.nextTimer;
+                scheduleFailSafe(_portIdx, nodePorts[_portIdx].failSafe.timerDue);
+                _portIdx = _next;
+            }
+        }
+
+        uint16_t _portIdx = failSafe.level0[failSafe.tick & wheelMask];
+        failSafe.level0[failSafe.tick & wheelMask] = noPort;
+
+        while (_portIdx != noPort) {
+            uint16_t _next = nodePorts[_portIdx].failSafe.nextTimer;
+            expireFailSafe(_portIdx, now);
+            _portIdx = _next;
+        }
+    }
+}
+
+void ArtNetNode::expireFailSafe(uint16_t portIdx, uint64_t now) {
+
+    failSafePort &_port = nodePorts[portIdx].failSafe;
+    uint64_t _last = _port.lastReceived.load(std::memory_order_relaxed);
+    uint64_t _due = failSafe.tick + failSafe.timeOut;
+
+    //ports which never received a frame or already failed are checked again one time out later
+    if (_last != 0 && _last != _port.handled) {
+
+        if (_last + static_cast<uint64_t>(failSafe.timeOut) * failSafeTick <= now) {
+            _port.handled = _last;
+            _port.pending.store(true, std::memory_order_release);
+        }
+        else {
+            _due = _last / failSafeTick + failSafe.timeOut;
+        }
+    }
+
+    scheduleFailSafe(portIdx, _due > failSafe.tick ? _due : failSafe.tick + 1);
+}
+
+bool ArtNetNode::outputFailSafe(uint16_t portIdx) {
+
+    failSafePort &_failSafe = nodePorts[portIdx].failSafe;
+
+    if (!_failSafe.pending.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
+
+    //the front frame belongs to the output context and is replaced completely by the next frame
+    dmxFrame &_frame = nodePorts[portIdx].frames.frames[nodePorts[portIdx].frames.front];
+    uint16_t _length = _frame.length > 0 ? _frame.length : maxDmxSlots;
+
+    switch (failSafe.mode.load(std::memory_order_relaxed)) {
+        case fssOutputZero:
+            memset(_frame.slots, 0x00, _length);
+            break;
+        case fssOutputFull:
+            memset(_frame.slots, 0xff, _length);
+            break;
+        case fssPlayScene:
+            if (_failSafe.scene.length > 0) {
+                _length = _failSafe.scene.length;
+                memcpy(_frame.slots, _failSafe.scene.slots, _length);
+            }
+            else {
+                memset(_frame.slots, 0x00, _length);
+            }
+            break;
+        default:
+            return false;
+    }
+
+    _frame.length = _length;
+
+    return callback_outputDmx != nullptr && callback_outputDmx(_frame.slots, _frame.length, portIdx);
+}
+
+void ArtNetNode::publishMetrics(uint64_t elapsed) {
+
+    char _text[maxDiagDataLen];
+    size_t _textLen = 0;
+    uint32_t _rate = 0;
+    uint32_t _gaps = 0;
+    uint32_t _outOfOrder = 0;
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+
+        if (!ports[i].isOutput) {
+            continue;
+        }
+
+        portMetrics &_metrics = nodePorts[i].metrics;
+        uint32_t _packets = _metrics.packets.load(std::memory_order_relaxed);
+        uint32_t _portRate = static_cast<uint32_t>((_packets - _metrics.reportedPackets) * 1000000ULL / (elapsed ? elapsed : 1));
+        uint32_t _portGaps = _metrics.sequenceGaps.load(std::memory_order_relaxed);
+        uint32_t _portOutOfOrder = _metrics.outOfOrder.load(std::memory_order_relaxed);
+
+        _metrics.reportedPackets = _packets;
+        _rate += _portRate;
+        _gaps += _portGaps;
+        _outOfOrder += _portOutOfOrder;
+
+        if (report.toDiagData && _textLen < sizeof(_text)) {
+            int _written = snprintf(_text + _textLen, sizeof(_text) - _textLen, "%u: %u/s gap %u ooo %u\n",
+                ports[i].portAddress, _portRate, _portGaps, _portOutOfOrder);
+            _textLen += _written > 0 ? static_cast<size_t>(_written) : 0;
+        }
+    }
+
+    //the most severe failure since the last summary is reported, ok otherwise
+    nodeReportCodes _code = rcPowerOk;
+
+    for (nodeReportCodes _candidate : {rcUdpFail, rcParseFail, rcDmxUdpFull}) {
+        uint32_t _failures = counters.byReportCode[_candidate].load(std::memory_order_relaxed);
+        if (_failures != report.reportedFailures[_candidate]) {
+            report.reportedFailures[_candidate] = _failures;
+            _code = _candidate;
+        }
+    }
+
+    if (report.toNodeReport) {
+        report.reportCount = report.reportCount >= 9999 ? 0 : report.reportCount + 1;
+        snprintf(reinterpret_cast<char*>(sysConf.nodeReport), sizeof(sysConf.nodeReport), "#%04x [%04u] %u pkt/s gap %u ooo %u",
+            _code, report.reportCount, _rate, _gaps, _outOfOrder);
+        markPollReplyDirty();
+    }
+
+    if (report.toDiagData && _textLen > 0) {
+        sendDiagData(_code == rcPowerOk ? dpLow : dpMed, 0, _text);
+    }
+}
@@ -0,0 +1,317 @@
+#include <ArtNetNodeFarm.hpp>
+#include <ArtNetSimd.hpp>
+#include <stdio.h>
+#include <string.h>
+
+ArtNetNodeFarm::ArtNetNodeFarm(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, uint16_t count, uint16_t *portAddressStorage,
+    uint8_t *sequenceStorage, uint16_t *lengthStorage, uint32_t *packetStorage, uint32_t *gapStorage, uint32_t *outOfOrderStorage)
+    :ArtNet(oemCode, MAC, MACLen), nodeCount(count), portAddresses(portAddressStorage), lastSequences(sequenceStorage),
+    lastLengths(lengthStorage), packets(packetStorage), sequenceGaps(gapStorage), outOfOrder(outOfOrderStorage){
+
+    sysConf.deviceStyle = StNode;
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(nodeCount) * portsPerNode; i++) {
+        portAddresses[i] = noPort;
+        lastSequences[i] = 0;
+        lastLengths[i] = 0;
+        packets[i] = 0;
+        sequenceGaps[i] = 0;
+        outOfOrder[i] = 0;
+    }
+
+    //the default ip derived from the MAC is the ip of node 0
+    firstIp = static_cast<uint32_t>(sysConf.ipAddress[0]) << 24 | static_cast<uint32_t>(sysConf.ipAddress[1]) << 16 |
+        static_cast<uint32_t>(sysConf.ipAddress[2]) << 8 | sysConf.ipAddress[3];
+}
+
+ArtNetNodeFarm::~ArtNetNodeFarm() {
+}
+
+void ArtNetNodeFarm::setOutputDmxCallback(bool (*callback)(const uint8_t *dmxData, uint16_t dmxDataSize, uint16_t nodeIdx, uint8_t portIdx)) {
+    callback_outputDmx = callback;
+}
+
+bool ArtNetNodeFarm::setFirstIp(const uint8_t *ip, uint8_t ipLen) {
+
+    if (ipLen < ipAddressLen) {
+        return false;
+    }
+
+    uint32_t _ip = static_cast<uint32_t>(ip[0]) << 24 | static_cast<uint32_t>(ip[1]) << 16 | static_cast<uint32_t>(ip[2]) << 8 | ip[3];
+
+    if (_ip > UINT32_MAX - (nodeCount - 1)) {
+        return false;
+    }
+
+    firstIp = _ip;
+
+    return true;
+}
+
+void ArtNetNodeFarm::getNodeIp(uint16_t nodeIdx, uint8_t *ip) const {
+
+    uint32_t _ip = firstIp + nodeIdx;
+
+    ip[0] = static_cast<uint8_t>(_ip >> 24);
+    ip[1] = static_cast<uint8_t>(_ip >> 16);
+    ip[2] = static_cast<uint8_t>(_ip >> 8);
+    ip[3] = static_cast<uint8_t>(_ip);
+}
+
+int32_t ArtNetNodeFarm::findNode(const uint8_t *ip, uint8_t ipLen) const {
+
+    if (ip == nullptr || ipLen < ipAddressLen) {
+        return -1;
+    }
+
+    uint32_t _offset = (static_cast<uint32_t>(ip[0]) << 24 | static_cast<uint32_t>(ip[1]) << 16 |
+        static_cast<uint32_t>(ip[2]) << 8 | ip[3]) - firstIp;
+
+    return _offset < nodeCount ? static_cast<int32_t>(_offset) : -1;
+}
+
+bool ArtNetNodeFarm::configureNodePort(uint16_t nodeIdx, uint8_t portIdx, uint16_t portAddress) {
+
+    if (nodeIdx >= nodeCount || portIdx >= portsPerNode || portAddress > 0x7fff) {
+        return false;
+    }
+
+    //a node is reported with a single net and sub-net
+    uint32_t _base = static_cast<uint32_t>(nodeIdx) * portsPerNode;
+    for (uint8_t i = 0; i < portsPerNode; i++) {
+        if (i != portIdx && portAddresses[_base + i] != noPort && (portAddresses[_base + i] >> 4) != (portAddress >> 4)) {
+            return false;
+        }
+    }
+
+    portAddresses[_base + portIdx] = portAddress;
+    lastSequences[_base + portIdx] = 0;
+
+    return true;
+}
+
+bool ArtNetNodeFarm::getPortMetrics(uint16_t nodeIdx, uint8_t portIdx, virtualPortMetrics &snapshot) const {
+
+    if (nodeIdx >= nodeCount || portIdx >= portsPerNode) {
+        return false;
+    }
+
+    uint32_t i = static_cast<uint32_t>(nodeIdx) * portsPerNode + portIdx;
+
+    snapshot.packets = packets[i];
+    snapshot.sequenceGaps = sequenceGaps[i];
+    snapshot.outOfOrder = outOfOrder[i];
+    snapshot.lastLength = lastLengths[i];
+
+    return true;
+}
+
+ArtNet::packetStatus ArtNetNodeFarm::handleFarmPacket(void *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen,
+    const uint8_t *targetIp, uint8_t targetIpLen) {
+
+    int32_t _node = findNode(targetIp, targetIpLen);
+
+    targetNode = _node >= 0 ? static_cast<uint16_t>(_node) : allNodes;
+    packetStatus _status = handlePacket(packet, packetLen, senderIp, senderIpLen, artNetPort);
+    targetNode = allNodes;
+
+    return _status;
+}
+
+void ArtNetNodeFarm::patchPollReply(ArtPollReplyPacket &reply, uint16_t nodeIdx) const {
+
+    memcpy(reply.data, pollReplies[0].data, sizeof(reply.data));
+
+    wireWriter<artPollReplyLayout> _reply(reply.data);
+
+    uint8_t _ip[ipAddressLen];
+    getNodeIp(nodeIdx, _ip);
+    memcpy(_reply.bytes<artPollReplyLayout::ipAddress>(), _ip, ipAddressLen);
+    memcpy(_reply.bytes<artPollReplyLayout::bindIp>(), _ip, ipAddressLen);
+
+    //the MAC counts up in its last two bytes
+    uint8_t *_mac = _reply.bytes<artPollReplyLayout::MAC>();
+    uint16_t _macLow = static_cast<uint16_t>((_mac[4] << 8 | _mac[5]) + nodeIdx);
+    _mac[4] = static_cast<uint8_t>(_macLow >> 8);
+    _mac[5] = static_cast<uint8_t>(_macLow);
+
+    char _name[artPollReplyLayout::portName::size];
+    snprintf(_name, sizeof(_name), "%.11s %u", reinterpret_cast<const char*>(sysConf.shortName), nodeIdx);
+    _reply.setString<artPollReplyLayout::portName>(_name);
+
+    uint32_t _base = static_cast<uint32_t>(nodeIdx) * portsPerNode;
+    uint8_t _numPorts = 0;
+    bool _netReported = false;
+
+    for (uint8_t i = 0; i < portsPerNode; i++) {
+
+        uint16_t _portAddress = portAddresses[_base + i];
+
+        if (_portAddress == noPort) {
+            continue;
+        }
+
+        if (!_netReported) {
+            _reply.set<artPollReplyLayout::netSwitch>(static_cast<uint8_t>(_portAddress >> 8));
+            _reply.set<artPollReplyLayout::subSwitch>(static_cast<uint8_t>((_portAddress >> 4) & 0x0f));
+            _netReported = true;
+        }
+
+        _numPorts = i + 1;
+        _reply.set<artPollReplyLayout::isOutput>(i, true);
+        _reply.set<artPollReplyLayout::portType>(i, ptcDMX512);
+        _reply.set<artPollReplyLayout::outputActive>(i, packets[_base + i] > 0);
+        _reply.bytes<artPollReplyLayout::swOut>()[i] = _portAddress & 0x0f;
+    }
+
+    _reply.set<artPollReplyLayout::numPorts>(_numPorts);
+}
+
+bool ArtNetNodeFarm::isTargeted(uint16_t nodeIdx, uint16_t bottom, uint16_t top) const {
+
+    uint32_t _base = static_cast<uint32_t>(nodeIdx) * portsPerNode;
+
+    for (uint8_t i = 0; i < portsPerNode; i++) {
+        if (portAddresses[_base + i] != noPort && portAddresses[_base + i] >= bottom && portAddresses[_base + i] <= top) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint16_t ArtNetNodeFarm::flushReplies(uint16_t replyCount) {
+
+    if (callback_sendBatch != nullptr) {
+        return callback_sendBatch(replyTx, replyCount);
+    }
+
+    if (callback_unicast == nullptr) {
+        return 0;
+    }
+
+    uint16_t _sent = 0;
+
+    for (uint16_t i = 0; i < replyCount; i++) {
+        if (callback_unicast(replyBatch[i].data, sizeof(ArtPollReplyPacket), replyTargetIp, ipAddressLen, artNetPort)) {
+            _sent++;
+        }
+    }
+
+    return _sent;
+}
+
+ArtNet::packetStatus ArtNetNodeFarm::handleArtPoll(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artPollLayout> _poll(packet);
+
+    //the target fields are optional in short ArtPoll packets
+    bool _targeted = packetLen >= artPollPacketLen && _poll.get<artPollLayout::targetModeEnable>();
+    uint16_t _bottom = _targeted ? _poll.get<artPollLayout::targetPortAddressBottom>() : 0;
+    uint16_t _top = _targeted ? _poll.get<artPollLayout::targetPortAddressTop>() : 0;
+
+    //the shared part of every reply, patched per node
+    if (pollReplyDirty.exchange(false, std::memory_order_acq_rel)) {
+        buildPollReply(0);
+    }
+
+    if (senderIpLen >= ipAddressLen) {
+        memcpy(replyTargetIp, senderIp, ipAddressLen);
+    }
+    else {
+        memset(replyTargetIp, 255, ipAddressLen);
+    }
+
+    uint16_t _first = targetNode == allNodes ? 0 : targetNode;
+    uint16_t _last = targetNode == allNodes ? nodeCount : targetNode + 1;
+    uint16_t _pending = 0;
+    packetStatus _status = psOk;
+
+    for (uint16_t _node = _first; _node < _last; _node++) {
+
+        if (_targeted && !isTargeted(_node, _bottom, _top)) {
+            continue;
+        }
+
+        patchPollReply(replyBatch[_pending], _node);
+        replyTx[_pending] = {replyBatch[_pending].data, sizeof(ArtPollReplyPacket), replyTargetIp, artNetPort};
+
+        if (++_pending == replyBatchLen) {
+            _status = flushReplies(_pending) == _pending ? _status : psTransmitFailed;
+            _pending = 0;
+        }
+    }
+
+    if (_pending > 0) {
+        _status = flushReplies(_pending) == _pending ? _status : psTransmitFailed;
+    }
+
+    return _status;
+}
+
+void ArtNetNodeFarm::consumeDmx(uint32_t portIdx, const uint8_t *slots, uint16_t length, uint8_t sequence) {
+
+    uint8_t _last = lastSequences[portIdx];
+
+    //sequence 0 is not checked, the sequence wraps from 255 to 1
+    if (sequence != 0 && _last != 0) {
+
+        int16_t _distance = static_cast<int16_t>(sequence - _last);
+        if (_distance < 0) {
+            _distance += 255;
+        }
+        if (_distance > 127) {
+            _distance -= 255;
+        }
+
+        if (_distance <= 0) {
+            outOfOrder[portIdx]++;
+            return;
+        }
+
+        sequenceGaps[portIdx] += _distance - 1;
+    }
+
+    lastSequences[portIdx] = sequence;
+    lastLengths[portIdx] = length;
+    packets[portIdx]++;
+
+    if (callback_outputDmx != nullptr) {
+        callback_outputDmx(slots, length, static_cast<uint16_t>(portIdx / portsPerNode), static_cast<uint8_t>(portIdx % portsPerNode));
+    }
+}
+
+ArtNet::packetStatus ArtNetNodeFarm::handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *, uint8_t) {
+
+    wireReader<artDmxLayout> _packet(packet);
+
+    uint16_t _portAddress = _packet.get<artDmxLayout::portAddress>() & 0x7fff;
+    uint16_t _length = _packet.get<artDmxLayout::dataLength>();
+    uint8_t _sequence = _packet.get<artDmxLayout::sequence>();
+    const uint8_t *_slots = _packet.bytes<artDmxLayout::data>();
+
+    if (_length == 0 || _length > maxDmxSlots || _length > packetLen - artDmxHeaderLen) {
+        return psInvalidContent;
+    }
+
+    if (targetNode != allNodes) {
+
+        uint32_t _base = static_cast<uint32_t>(targetNode) * portsPerNode;
+        for (uint8_t i = 0; i < portsPerNode; i++) {
+            if (portAddresses[_base + i] == _portAddress) {
+                consumeDmx(_base + i, _slots, _length, _sequence);
+            }
+        }
+
+        return psOk;
+    }
+
+    //broadcast ArtDmx, the scan only touches the Port-Address array
+    uint32_t _portCount = static_cast<uint32_t>(nodeCount) * portsPerNode;
+    for (uint32_t i = findValue16(portAddresses, _portCount, _portAddress, 0); i < _portCount;
+        i = findValue16(portAddresses, _portCount, _portAddress, i + 1)) {
+        consumeDmx(i, _slots, _length, _sequence);
+    }
+
+    return psOk;
+}
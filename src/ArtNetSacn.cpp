@@ -0,0 +1,399 @@
+#include <ArtNetSacn.hpp>
+#include <string.h>
+
+ArtNetSacnGateway::ArtNetSacnGateway(uint16_t oemCode, uint8_t *MAC, uint8_t MACLen, portConfig *configs, gatewayPort *portStates,
+    std::atomic<uint16_t> *artNetKeyStorage, std::atomic<uint16_t> *sacnKeyStorage, ArtPollReplyPacket *replies, uint16_t portCount)
+    :ArtNet(oemCode, MAC, MACLen), gatewayPorts(portStates), artNetKeys(artNetKeyStorage), sacnKeys(sacnKeyStorage){
+
+    sysConf.deviceStyle = StRoute;
+    setPortStorage(configs, portCount, replies);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        artNetKeys[i].store(noMapping, std::memory_order_relaxed);
+        sacnKeys[i].store(noMapping, std::memory_order_relaxed);
+    }
+
+    //version 4 style UUID, the node part is the MAC so every gateway gets its own CID
+    static constexpr uint8_t _cidBase[sacnCidLen] = {'A', 'r', 't', 'N', 'e', 't', 0x40, 0x00, 0x80, 0x00};
+    memcpy(cid, _cidBase, sizeof(cid));
+    memcpy(cid + sacnCidLen - macAddressLen, sysConf.macAddress, macAddressLen);
+}
+
+ArtNetSacnGateway::~ArtNetSacnGateway() {
+}
+
+void ArtNetSacnGateway::setSacnCallback(bool (*callback)(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t targetIpLen, uint16_t targetPort)) {
+    callback_sacn = callback;
+}
+
+uint16_t ArtNetSacnGateway::findMapping(const std::atomic<uint16_t> *keys, uint16_t key, uint16_t from) const {
+
+    for (uint16_t i = from; i < numPorts; i++) {
+        if (keys[i].load(std::memory_order_acquire) == key) {
+            return i;
+        }
+    }
+
+    return noMapping;
+}
+
+bool ArtNetSacnGateway::canMap(uint16_t portIdx, uint16_t portAddress) const {
+
+    if (portIdx >= numPorts || portAddress > 0x7fff) {
+        return false;
+    }
+
+    //a page is reported with a single net and sub-net
+    uint16_t _pageStart = portIdx & ~3;
+    for (uint16_t i = _pageStart; i < numPorts && i < _pageStart + 4; i++) {
+        if (i != portIdx && (ports[i].isInput || ports[i].isOutput) && (ports[i].portAddress >> 4) != (portAddress >> 4)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ArtNetSacnGateway::buildSacnHeader(gatewayPort &port, uint8_t priority) {
+
+    wireWriter<sacnDataLayout> _packet(port.packet);
+
+    memset(port.packet, 0, sizeof(port.packet));
+
+    _packet.set<sacnDataLayout::preambleSize>(0x0010);
+    _packet.set<sacnDataLayout::postambleSize>(0x0000);
+    memcpy(_packet.bytes<sacnDataLayout::acnPid>(), acnPid, acnPidLen);
+    _packet.set<sacnDataLayout::rootVector>(vectorRootData);
+    memcpy(_packet.bytes<sacnDataLayout::cid>(), cid, sacnCidLen);
+    _packet.set<sacnDataLayout::framingVector>(vectorFramingData);
+    _packet.setString<sacnDataLayout::sourceName>(reinterpret_cast<const char*>(sysConf.longName));
+    _packet.set<sacnDataLayout::priority>(priority);
+    _packet.set<sacnDataLayout::universe>(port.universe);
+    _packet.set<sacnDataLayout::dmpVector>(vectorDmpSetProperty);
+    _packet.set<sacnDataLayout::addressType>(dmpAddressType);
+    _packet.set<sacnDataLayout::firstAddress>(0);
+    _packet.set<sacnDataLayout::addressIncrement>(1);
+    _packet.set<sacnDataLayout::startCode>(0);
+}
+
+bool ArtNetSacnGateway::mapArtNetToSacn(uint16_t portIdx, uint16_t portAddress, uint16_t universe, uint8_t priority) {
+
+    if (!canMap(portIdx, portAddress) || universe < minSacnUniverse || universe > maxSacnUniverse || priority > maxSacnPriority) {
+        return false;
+    }
+
+    gatewayPort &_port = gatewayPorts[portIdx];
+
+    //packets found after the keys are cleared skip the port, a packet which found it just before may still
+    //be forwarded while the header is rebuilt, so live ports are remapped only while none of their packets arrive
+    artNetKeys[portIdx].store(noMapping, std::memory_order_relaxed);
+    sacnKeys[portIdx].store(noMapping, std::memory_order_relaxed);
+
+    _port.universe = universe;
+    _port.direction = gdArtNetToSacn;
+    _port.sequence = 0;
+    _port.sourceActive = false;
+    sacnMulticastIp(universe, _port.targetIp);
+    buildSacnHeader(_port, priority);
+
+    ports[portIdx].portAddress = portAddress;
+    ports[portIdx].isOutput = true;
+    ports[portIdx].isInput = false;
+    artNetKeys[portIdx].store(portAddress, std::memory_order_release);
+
+    markPollReplyDirty();
+
+    return true;
+}
+
+bool ArtNetSacnGateway::mapSacnToArtNet(uint16_t portIdx, uint16_t universe, uint16_t portAddress, uint8_t *targetIp, uint8_t targetIpLen) {
+
+    if (!canMap(portIdx, portAddress) || universe < minSacnUniverse || universe > maxSacnUniverse ||
+        (targetIp != nullptr && targetIpLen < ipAddressLen)) {
+        return false;
+    }
+
+    gatewayPort &_port = gatewayPorts[portIdx];
+
+    artNetKeys[portIdx].store(noMapping, std::memory_order_relaxed);
+    sacnKeys[portIdx].store(noMapping, std::memory_order_relaxed);
+
+    _port.universe = universe;
+    _port.direction = gdSacnToArtNet;
+    _port.sequence = 0;
+    _port.sourceActive = false;
+
+    if (targetIp != nullptr) {
+        memcpy(_port.targetIp, targetIp, ipAddressLen);
+    }
+    else {
+        memset(_port.targetIp, 255, ipAddressLen);
+    }
+
+    memset(_port.packet, 0, artDmxLayout::length);
+
+    wireWriter<artDmxLayout> _packet(_port.packet);
+    memcpy(_packet.bytes<artDmxLayout::ident>(), artNetIdent, artNetIdentLen);
+    _packet.set<artDmxLayout::opCode>(opDmx);
+    _packet.set<artDmxLayout::protVer>(protVersion);
+    _packet.set<artDmxLayout::physical>(static_cast<uint8_t>(portIdx));
+    _packet.set<artDmxLayout::portAddress>(portAddress);
+
+    ports[portIdx].portAddress = portAddress;
+    ports[portIdx].isInput = true;
+    ports[portIdx].isOutput = false;
+    sacnKeys[portIdx].store(universe, std::memory_order_release);
+
+    markPollReplyDirty();
+
+    return true;
+}
+
+bool ArtNetSacnGateway::unmap(uint16_t portIdx) {
+
+    if (portIdx >= numPorts) {
+        return false;
+    }
+
+    artNetKeys[portIdx].store(noMapping, std::memory_order_relaxed);
+    sacnKeys[portIdx].store(noMapping, std::memory_order_relaxed);
+    ports[portIdx].isInput = false;
+    ports[portIdx].isOutput = false;
+
+    markPollReplyDirty();
+
+    return true;
+}
+
+bool ArtNetSacnGateway::setAcnPriority(uint16_t portIdx, uint8_t priority) {
+
+    if (portIdx >= numPorts || priority > maxSacnPriority || artNetKeys[portIdx].load(std::memory_order_relaxed) == noMapping) {
+        return false;
+    }
+
+    wireWriter<sacnDataLayout>(gatewayPorts[portIdx].packet).set<sacnDataLayout::priority>(priority);
+    markPollReplyDirty();
+
+    return true;
+}
+
+void ArtNetSacnGateway::setCid(const uint8_t *newCid) {
+
+    memcpy(cid, newCid, sacnCidLen);
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        if (artNetKeys[i].load(std::memory_order_relaxed) != noMapping) {
+            memcpy(wireWriter<sacnDataLayout>(gatewayPorts[i].packet).bytes<sacnDataLayout::cid>(), cid, sacnCidLen);
+        }
+    }
+}
+
+void ArtNetSacnGateway::portsChanged() {
+
+    for (uint16_t i = 0; i < numPorts; i++) {
+        if (artNetKeys[i].load(std::memory_order_relaxed) != noMapping) {
+            artNetKeys[i].store(ports[i].portAddress, std::memory_order_release);
+        }
+        if (sacnKeys[i].load(std::memory_order_relaxed) != noMapping) {
+            wireWriter<artDmxLayout>(gatewayPorts[i].packet).set<artDmxLayout::portAddress>(ports[i].portAddress);
+        }
+    }
+}
+
+void ArtNetSacnGateway::applyAcnPriority(uint8_t priority, uint16_t page) {
+
+    for (uint16_t i = page * 4; i < numPorts && i < page * 4 + 4; i++) {
+        if (artNetKeys[i].load(std::memory_order_relaxed) != noMapping) {
+            wireWriter<sacnDataLayout>(gatewayPorts[i].packet).set<sacnDataLayout::priority>(priority);
+        }
+    }
+}
+
+ArtNet::packetStatus ArtNetSacnGateway::handleArtDmx(const uint8_t *packet, uint16_t packetLen, uint8_t *senderIp, uint8_t senderIpLen) {
+
+    wireReader<artDmxLayout> _packet(packet);
+
+    uint16_t _portAddress = _packet.get<artDmxLayout::portAddress>() & 0x7fff;
+    uint16_t _length = _packet.get<artDmxLayout::dataLength>();
+
+    if (_length == 0 || _length > maxDmxSlots || _length > packetLen - artDmxHeaderLen) {
+        return psInvalidContent;
+    }
+
+    //ArtDmx of the sACN -> Art-Net mappings comes back on broadcast
+    if (senderIpLen >= ipAddressLen && memcmp(senderIp, sysConf.ipAddress, ipAddressLen) == 0) {
+        return psOk;
+    }
+
+    packetStatus _status = psOk;
+    uint16_t _packetLen = sacnHeaderLen + _length;
+
+    for (uint16_t i = findMapping(artNetKeys, _portAddress, 0); i != noMapping; i = findMapping(artNetKeys, _portAddress, i + 1)) {
+
+        gatewayPort &_port = gatewayPorts[i];
+        wireWriter<sacnDataLayout> _sacn(_port.packet);
+
+        memcpy(_sacn.bytes<sacnDataLayout::data>(), _packet.bytes<artDmxLayout::data>(), _length);
+
+        //the flags and length of every PDU cover the rest of the packet
+        _sacn.set<sacnDataLayout::rootFlagsLength>(pduFlags | (_packetLen - sacnDataLayout::rootFlagsLength::offset));
+        _sacn.set<sacnDataLayout::framingFlagsLength>(pduFlags | (_packetLen - sacnDataLayout::framingFlagsLength::offset));
+        _sacn.set<sacnDataLayout::dmpFlagsLength>(pduFlags | (_packetLen - sacnDataLayout::dmpFlagsLength::offset));
+        _sacn.set<sacnDataLayout::propertyCount>(_length + 1);
+        _sacn.set<sacnDataLayout::sequence>(_port.sequence++);
+
+        if (callback_sacn != nullptr && callback_sacn(_port.packet, _packetLen, _port.targetIp, ipAddressLen, sacnPort)) {
+            counters.toSacn.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+            counters.sendFailed.fetch_add(1, std::memory_order_relaxed);
+            _status = psTransmitFailed;
+        }
+    }
+
+    return _status;
+}
+
+ArtNet::packetStatus ArtNetSacnGateway::handleSacnPacket(void *packet, uint16_t packetLen, uint8_t *, uint8_t) {
+
+    const uint8_t *_data = static_cast<const uint8_t*>(packet);
+
+    if (packetLen < sacnHeaderLen) {
+        counters.sacnInvalid.fetch_add(1, std::memory_order_relaxed);
+        return psTooShort;
+    }
+
+    wireReader<sacnDataLayout> _packet(_data);
+
+    if (_packet.get<sacnDataLayout::preambleSize>() != 0x0010 || _packet.get<sacnDataLayout::postambleSize>() != 0 ||
+        memcmp(_packet.bytes<sacnDataLayout::acnPid>(), acnPid, acnPidLen) != 0) {
+        counters.sacnInvalid.fetch_add(1, std::memory_order_relaxed);
+        return psInvalidContent;
+    }
+
+    //synchronization and discovery packets carry no slots
+    if (_packet.get<sacnDataLayout::rootVector>() != vectorRootData) {
+        counters.sacnIgnored.fetch_add(1, std::memory_order_relaxed);
+        return psOk;
+    }
+
+    uint16_t _propertyCount = _packet.get<sacnDataLayout::propertyCount>();
+    uint16_t _universe = _packet.get<sacnDataLayout::universe>();
+
+    if (_packet.get<sacnDataLayout::framingVector>() != vectorFramingData || _packet.get<sacnDataLayout::dmpVector>() != vectorDmpSetProperty ||
+        _packet.get<sacnDataLayout::addressType>() != dmpAddressType || _packet.get<sacnDataLayout::firstAddress>() != 0 ||
+        _packet.get<sacnDataLayout::addressIncrement>() != 1 || _propertyCount == 0 || _propertyCount > maxDmxSlots + 1 ||
+        _propertyCount > packetLen - sacnDataLayout::startCode::offset || _universe < minSacnUniverse || _universe > maxSacnUniverse) {
+        counters.sacnInvalid.fetch_add(1, std::memory_order_relaxed);
+        return psInvalidContent;
+    }
+
+    const uint8_t *_sourceCid = _packet.bytes<sacnDataLayout::cid>();
+    uint16_t _length = _propertyCount - 1;
+
+    if (_packet.get<sacnDataLayout::previewData>() || _packet.get<sacnDataLayout::startCode>() != 0 || _length == 0 ||
+        memcmp(_sourceCid, cid, sacnCidLen) == 0) {
+        counters.sacnIgnored.fetch_add(1, std::memory_order_relaxed);
+        return psOk;
+    }
+
+    uint8_t _priority = _packet.get<sacnDataLayout::priority>();
+    uint8_t _sequence = _packet.get<sacnDataLayout::sequence>();
+    bool _terminated = _packet.get<sacnDataLayout::streamTerminated>();
+    uint64_t _now = getMicros();
+
+    uint16_t i = findMapping(sacnKeys, _universe, 0);
+
+    if (i == noMapping) {
+        counters.sacnIgnored.fetch_add(1, std::memory_order_relaxed);
+        return psOk;
+    }
+
+    packetStatus _status = psOk;
+
+    for (; i != noMapping; i = findMapping(sacnKeys, _universe, i + 1)) {
+
+        gatewayPort &_port = gatewayPorts[i];
+
+        if (_port.sourceActive && _now - _port.sourceLastSeen > sacnSourceTimeOut * 1000ULL) {
+            _port.sourceActive = false;
+        }
+
+        if (!_port.sourceActive || memcmp(_port.sourceCid, _sourceCid, sacnCidLen) != 0) {
+
+            //a second source only takes over with a higher priority, equal priorities keep the first source
+            if (_port.sourceActive && _priority <= _port.sourcePriority) {
+                counters.sacnLowerPriority.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            memcpy(_port.sourceCid, _sourceCid, sacnCidLen);
+            _port.sourceActive = true;
+        }
+        else {
+            //E1.31 6.7.2: a difference in (-20, 0] is an old or duplicated packet
+            int8_t _difference = static_cast<int8_t>(_sequence - _port.sourceSequence);
+            if (_difference <= 0 && _difference > -20) {
+                counters.sacnOutOfOrder.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+        }
+
+        _port.sourcePriority = _priority;
+        _port.sourceSequence = _sequence;
+        _port.sourceLastSeen = _now;
+
+        if (_terminated) {
+            _port.sourceActive = false;
+            continue;
+        }
+
+        //ArtDmx carries an even number of slots
+        uint16_t _dmxLength = (_length + 1) & ~1;
+
+        wireWriter<artDmxLayout> _dmx(_port.packet);
+        memcpy(_dmx.bytes<artDmxLayout::data>(), _packet.bytes<sacnDataLayout::data>(), _length);
+        if (_dmxLength != _length) {
+            _dmx.bytes<artDmxLayout::data>()[_length] = 0;
+        }
+
+        _port.sequence = _port.sequence == 255 ? 1 : _port.sequence + 1;
+        _dmx.set<artDmxLayout::sequence>(_port.sequence);
+        _dmx.set<artDmxLayout::dataLength>(_dmxLength);
+
+        if (callback_unicast != nullptr && callback_unicast(_port.packet, artDmxHeaderLen + _dmxLength, _port.targetIp, ipAddressLen, artNetPort)) {
+            counters.toArtNet.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+            counters.sendFailed.fetch_add(1, std::memory_order_relaxed);
+            _status = psTransmitFailed;
+        }
+    }
+
+    return _status;
+}
+
+void ArtNetSacnGateway::updatePortStatus(ArtPollReplyPacket &reply, uint16_t page) {
+
+    wireWriter<artPollReplyLayout> _reply(reply.data);
+    bool _priorityReported = false;
+
+    _reply.set<artPollReplyLayout::sACNSupported>(true);
+
+    for (uint8_t i = 0; i < 4 && page * 4 + i < numPorts; i++) {
+
+        uint16_t _portIdx = page * 4 + i;
+
+        bool _toSacn = artNetKeys[_portIdx].load(std::memory_order_relaxed) != noMapping;
+
+        //each direction is reported in the status byte of its port type
+        _reply.set<artPollReplyLayout::outputToSacn>(i, _toSacn);
+        _reply.set<artPollReplyLayout::inputFromSacn>(i, sacnKeys[_portIdx].load(std::memory_order_relaxed) != noMapping);
+
+        //the reply holds one priority per page, the one of its first Art-Net -> sACN port
+        if (_toSacn && !_priorityReported) {
+            _reply.set<artPollReplyLayout::acnPriority>(wireReader<sacnDataLayout>(gatewayPorts[_portIdx].packet).get<sacnDataLayout::priority>());
+            _priorityReported = true;
+        }
+    }
+}
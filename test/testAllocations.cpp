@@ -0,0 +1,260 @@
+/**
+ * @file testAllocations.cpp
+ * @author your name (you@domain.com)
+ * @brief the packet paths of a node and a controller never use the heap after construction, every path
+ * is driven over the in memory transport while operator new is counted
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetFakeTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include "testCheck.hpp"
+#include "testFixture.hpp"
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+}
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *_memory = malloc(size ? size : 1);
+    if (_memory == nullptr) {
+#ifdef ARTNET_NO_EXCEPTIONS
+        abort();
+#else
+        throw std::bad_alloc();
+#endif
+    }
+    return _memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace {
+
+constexpr uint16_t iterations = 1000;
+constexpr uint16_t portCount = 16;
+constexpr uint16_t universeCount = 16;
+
+ArtNetController::controllerStorage<universeCount, 16> controllerTables;
+ArtNetController::rdmStorage<64, 16> rdmTables;
+
+bool acceptNzs(uint8_t, uint8_t *, uint16_t, uint16_t) {
+    return true;
+}
+
+/**
+ * @brief run one step of a packet path and check that it did not allocate
+ *
+ * @param name name of the path
+ * @param step function running one step
+ */
+template<typename stepFunction>
+void checkPath(const char *name, stepFunction step) {
+
+    uint64_t _before = allocations.load(std::memory_order_relaxed);
+
+    for (uint16_t i = 0; i < iterations; i++) {
+        testFixture::now += 1000;
+        step(i);
+    }
+
+    uint64_t _allocated = allocations.load(std::memory_order_relaxed) - _before;
+    if (!CHECK(_allocated == 0)) {
+        printf("  %s: %lu allocations\n", name, static_cast<unsigned long>(_allocated));
+    }
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    uint8_t _nodeIp[4] = {2, 0, 0, 2};
+    uint8_t _controllerIp[4] = {2, 0, 0, 1};
+
+    static testFixture::nodeFixture<portCount> _fixture(_mac);
+    ArtNetNode &_node = _fixture.node;
+    _node.setOutputNzsCallback(acceptNzs);
+    _node.setFailSafe(ArtNet::fssOutputZero, 100);
+    _node.setMetricsReport(1, true, true);
+    _node.setSequenceCheck(true, 5);
+
+    static ArtNetController _controller(0x0000, _mac, sizeof(_mac), controllerTables, rdmTables);
+    _controller.setUnicastCallback(ArtNetFakeTransport::sendUnicast);
+    _controller.setBroadcastCallback(ArtNetFakeTransport::sendBroadcast);
+    _controller.setTimeCallback(testFixture::fakeMicros);
+    _controller.setRdmPipeline(1, 5, 1);
+
+    uint8_t _dmx[512] = {};
+    for (uint16_t i = 0; i < universeCount; i++) {
+        uint16_t _idx;
+        _controller.addUniverse(i, _nodeIp, sizeof(_nodeIp), _idx);
+        _dmx[0] = static_cast<uint8_t>(i);
+        _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+    }
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    uint8_t _artIpProg[33] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0xf8, 0x00, 14, 0, 0, 0x80};
+    uint8_t _artDataRequest[40] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x27, 0x00, 14, 0, 0, 0xff, 0xff, 0x00, 0x01};
+    uint8_t _artAddress[107] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x60, 0x00, 14, 0x7f, 1, 't', 'e', 's', 't'};
+    uint8_t _artDmx[530] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x02, 0x00};
+    uint8_t _artNzs[82] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x51, 0x00, 14, 0, 0x17, 0x00, 0x00, 0x00, 0x40};
+    uint8_t _artSync[14] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x52, 0x00, 14};
+    uint8_t _artTimeCode[19] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x97, 0x00, 14, 0, 0, 0, 0, 0, 1, ArtNet::ttSmpte};
+    uint8_t _artTimeSync[24] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x98, 0x00, 14, 0, 0, 0, 30, 15, 12, 1, 0, 0, 126};
+    uint8_t _artTodData[28 + 8 * 6] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x81, 0x00, 14, 1, 1};
+
+    memset(_artAddress + 96, 0x7f, 8);
+    _artAddress[104] = 0x7f;
+    _artAddress[105] = 0xff;
+    _artAddress[106] = 0x02;    //acLedNormal
+
+    _artTodData[25] = 8;
+    _artTodData[27] = 8;
+    for (uint8_t i = 0; i < 8; i++) {
+        uint8_t _uid[6] = {0x7a, 0x70, 0, 0, 0, static_cast<uint8_t>(i + 1)};
+        memcpy(_artTodData + 28 + i * 6, _uid, sizeof(_uid));
+    }
+
+    ArtNetFakeTransport::reset();
+
+    checkPath("node ArtPoll", [&](uint16_t) {
+        _node.handlePacket(_artPoll, sizeof(_artPoll), _controllerIp, sizeof(_controllerIp), 0x1936);
+    });
+
+    //the last reply of the node is the page the controller discovers
+    uint16_t _replyLen;
+    const uint8_t *_lastReply = ArtNetFakeTransport::getLastPacket(_replyLen);
+    uint8_t _artPollReply[ArtNetFakeTransport::maxPacketLen];
+    memcpy(_artPollReply, _lastReply, _replyLen);
+
+    checkPath("node ArtIpProg", [&](uint16_t) {
+        _node.handlePacket(_artIpProg, sizeof(_artIpProg), _controllerIp, sizeof(_controllerIp), 0x1936);
+    });
+
+    checkPath("node ArtDataRequest", [&](uint16_t i) {
+        _artDataRequest[17] = static_cast<uint8_t>(i % 6);
+        _node.handlePacket(_artDataRequest, sizeof(_artDataRequest), _controllerIp, sizeof(_controllerIp), 0x1936);
+    });
+
+    checkPath("node ArtAddress", [&](uint16_t i) {
+        _artAddress[13] = static_cast<uint8_t>(i % (portCount / 4) + 1);
+        _node.handlePacket(_artAddress, sizeof(_artAddress), _controllerIp, sizeof(_controllerIp), 0x1936);
+        _node.service();
+    });
+
+    checkPath("node ArtDmx + outputs", [&](uint16_t i) {
+        _artDmx[12] = static_cast<uint8_t>(i % 255 + 1);
+        _artDmx[14] = static_cast<uint8_t>(i % portCount);
+        _artDmx[18] = static_cast<uint8_t>(i);
+        _node.handlePacket(_artDmx, sizeof(_artDmx), _controllerIp, sizeof(_controllerIp), 0x1936);
+        _node.service();
+        _node.processOutputs();
+    });
+
+    checkPath("node ArtDmx + ArtSync", [&](uint16_t i) {
+        _artDmx[14] = static_cast<uint8_t>(i % portCount);
+        _node.handlePacket(_artDmx, sizeof(_artDmx), _controllerIp, sizeof(_controllerIp), 0x1936);
+        if (i % portCount == portCount - 1) {
+            _node.handlePacket(_artSync, sizeof(_artSync), _controllerIp, sizeof(_controllerIp), 0x1936);
+        }
+        _node.processOutputs();
+    });
+
+    checkPath("node ArtNzs + outputs", [&](uint16_t i) {
+        _artNzs[14] = static_cast<uint8_t>(i % portCount);
+        _node.handlePacket(_artNzs, sizeof(_artNzs), _controllerIp, sizeof(_controllerIp), 0x1936);
+        _node.processNzsOutputs();
+    });
+
+    checkPath("node ArtTimeCode + ArtTimeSync", [&](uint16_t i) {
+        _artTimeCode[14] = static_cast<uint8_t>(i % 30);
+        _node.handlePacket(_artTimeCode, sizeof(_artTimeCode), _controllerIp, sizeof(_controllerIp), 0x1936);
+        _node.handlePacket(_artTimeSync, sizeof(_artTimeSync), _controllerIp, sizeof(_controllerIp), 0x1936);
+    });
+
+    checkPath("node fail-safe", [&](uint16_t) {
+        _node.service();
+        _node.processOutputs();
+    });
+
+    checkPath("controller ArtPollReply", [&](uint16_t) {
+        _controller.handlePacket(_artPollReply, _replyLen, _nodeIp, sizeof(_nodeIp), 0x1936);
+        _controller.expireNodes();
+    });
+
+    checkPath("controller ArtDmx transmit", [&](uint16_t) {
+        _controller.transmitDmx();
+    });
+
+    _controller.enableUnicastMode(true);
+    _controller.setBatchCallback(ArtNetFakeTransport::sendBatch);
+
+    checkPath("controller ArtDmx batch", [&](uint16_t) {
+        _controller.transmitDmx();
+    });
+
+    checkPath("controller ArtTodData", [&](uint16_t i) {
+        //every other table misses its last responder
+        _artTodData[25] = i % 2 ? 7 : 8;
+        _artTodData[27] = _artTodData[25];
+        _controller.handlePacket(_artTodData, 28 + _artTodData[27] * 6, _nodeIp, sizeof(_nodeIp), 0x1936);
+    });
+
+    uint8_t _request[26] = {0x01, 24, 0x7a, 0x70, 0, 0, 0, 1, 0x7a, 0x70, 0, 0, 0, 0x99};
+    _request[19] = 0x20;
+    _request[21] = 0x60;
+
+    checkPath("controller ArtRdm", [&](uint16_t i) {
+
+        uint16_t _idx;
+        _controller.queueRdm(0, _request, sizeof(_request), _idx);
+
+        //every other request times out and is retried, the others are answered
+        if (i % 2) {
+            testFixture::now += 10000;
+            _controller.service();
+            testFixture::now += 10000;
+            _controller.service();
+            return;
+        }
+
+        uint16_t _sentLen;
+        uint8_t _response[25 + 26];
+        memcpy(_response, ArtNetFakeTransport::getLastPacket(_sentLen), sizeof(_response));
+        memcpy(_response + 25 + 2, _request + 8, 6);
+        memcpy(_response + 25 + 8, _request + 2, 6);
+        _response[25 + 19] = 0x21;
+        _controller.handlePacket(_response, sizeof(_response), _nodeIp, sizeof(_nodeIp), 0x1936);
+    });
+
+    ArtNet::timeCode _start = {1, 0, 0, 0, ArtNet::ttSmpte, 0};
+    _controller.startTimeCode(_start);
+
+    checkPath("controller timecode", [&](uint16_t) {
+        _controller.service();
+    });
+
+    CHECK(ArtNetFakeTransport::getCounters().packets > 0);
+
+    return testCheck::result("testAllocations");
+}
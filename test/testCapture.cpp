@@ -0,0 +1,138 @@
+/**
+ * @file testCapture.cpp
+ * @author your name (you@domain.com)
+ * @brief behaviour of capture and replay: the packets a node receives are recorded through its capture
+ * callback and replayed into a second node, which ends up with the same outputs
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetCapture.hpp>
+#include <ArtNetFakeTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "testCheck.hpp"
+#include "testFixture.hpp"
+
+namespace {
+
+using namespace testFixture;
+
+constexpr uint16_t portCount = 4;
+constexpr uint8_t frameCount = 10;
+constexpr const char *capturePath = "/tmp/testCapture.cap";
+
+uint8_t consoleIp[4] = {2, 0, 0, 10};
+
+void testRecordAndReplay(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _live(MAC);
+    static nodeFixture<portCount> _replayed(MAC);
+
+    //live traffic recorded by the capture callback of the node
+    CHECK(ArtNetCapture::open(capturePath, 1024 * 1024));
+    _live.node.setCaptureCallback(ArtNetCapture::record);
+
+    uint8_t _artDmx[18 + 2] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0, 0x00, 0x00, 0x00, 0x02};
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+
+    for (uint8_t _frame = 0; _frame < frameCount; _frame++) {
+        for (uint16_t i = 0; i < portCount; i++) {
+            _artDmx[12] = static_cast<uint8_t>(_frame + 1);
+            _artDmx[14] = static_cast<uint8_t>(i);
+            _artDmx[18] = _frame;
+            _artDmx[19] = static_cast<uint8_t>(i);
+            _live.node.handlePacket(_artDmx, sizeof(_artDmx), consoleIp, sizeof(consoleIp), 0x1936);
+        }
+        now += 25000;
+        _live.node.processOutputs();
+    }
+    _live.node.handlePacket(_artPoll, sizeof(_artPoll), consoleIp, sizeof(consoleIp), 0x1936);
+
+    CHECK(ArtNetCapture::getCounters().recorded == frameCount * portCount + 1);
+    CHECK(ArtNetCapture::getCounters().dropped == 0);
+    ArtNetCapture::close();
+
+    uint8_t _liveSlots[portCount][2];
+    for (uint16_t i = 0; i < portCount; i++) {
+        memcpy(_liveSlots[i], outputSlots[i], 2);
+    }
+
+    //the replay hands the same packets to the second node, as fast as possible
+    ArtNetReplay _replay;
+    CHECK(_replay.open(capturePath));
+    CHECK(_replay.getRecordCount() == frameCount * portCount + 1);
+
+    ArtNetFakeTransport::reset();
+    ArtNetReplay::replayStats _stats;
+    clearOutputs();
+    CHECK(_replay.run(_replayed.node, 0, _stats));
+    _replayed.node.processOutputs();
+
+    CHECK(_stats.packets == frameCount * portCount + 1);
+    CHECK(_stats.byStatus[ArtNet::psOk] == _stats.packets);
+    CHECK(ArtNetFakeTransport::getCounters().packets == 1);
+
+    for (uint16_t i = 0; i < portCount; i++) {
+        CHECK(memcmp(_liveSlots[i], outputSlots[i], 2) == 0);
+        CHECK(outputSlots[i][0] == frameCount - 1 && outputSlots[i][1] == i);
+    }
+
+    //a second run replays the file again
+    CHECK(_replay.run(_replayed.node, 0, _stats));
+    CHECK(_stats.packets == frameCount * portCount + 1);
+    _replay.close();
+}
+
+void testGeneratedCapture() {
+
+    //a file smaller than the traffic drops the rest and counts it
+    CHECK(ArtNetCapture::open(capturePath, 32 + 3 * ArtNetCapture::recordSize(22)));
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    CHECK(ArtNetCapture::append(0, _artPoll, sizeof(_artPoll), consoleIp, sizeof(consoleIp), 0x1936));
+    CHECK(ArtNetCapture::append(1000000, _artPoll, sizeof(_artPoll), consoleIp, sizeof(consoleIp), 0x1936));
+    CHECK(ArtNetCapture::append(3000000, _artPoll, sizeof(_artPoll), consoleIp, sizeof(consoleIp), 0x1936));
+    CHECK(!ArtNetCapture::append(4000000, _artPoll, sizeof(_artPoll), consoleIp, sizeof(consoleIp), 0x1936));
+
+    CHECK(ArtNetCapture::getCounters().recorded == 3);
+    CHECK(ArtNetCapture::getCounters().dropped == 1);
+    ArtNetCapture::close();
+
+    //nothing is recorded once the capture is closed
+    CHECK(!ArtNetCapture::append(5000000, _artPoll, sizeof(_artPoll), consoleIp, sizeof(consoleIp), 0x1936));
+
+    ArtNetReplay _replay;
+    CHECK(_replay.open(capturePath));
+    CHECK(_replay.getRecordCount() == 3);
+    CHECK(_replay.getDuration() == 3000000);
+    _replay.close();
+
+    //other files are rejected
+    FILE *_file = fopen(capturePath, "wb");
+    if (_file != nullptr) {
+        fputs("not a capture file, only some text", _file);
+        fclose(_file);
+    }
+    CHECK(!_replay.open(capturePath));
+    CHECK(!_replay.open("/tmp/testCapture.missing"));
+
+    unlink(capturePath);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    testRecordAndReplay(_mac);
+    testGeneratedCapture();
+
+    return testCheck::result("testCapture");
+}
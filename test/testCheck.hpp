@@ -0,0 +1,45 @@
+/**
+ * @file testCheck.hpp
+ * @author your name (you@domain.com)
+ * @brief checks shared by the tests, a failed check is printed and counted and the test returns the count.
+ * unlike assert the checks stay active in release builds
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <stdio.h>
+
+namespace testCheck {
+
+inline int failures = 0;
+
+/**
+ * @brief count and print a failed check
+ *
+ * @return condition
+ */
+inline bool check(bool condition, const char *expression, const char *file, int line) {
+    if (!condition) {
+        printf("%s:%d: check failed: %s\n", file, line, expression);
+        failures++;
+    }
+    return condition;
+}
+
+/**
+ * @brief print the result of the test
+ *
+ * @return exit code of the test, 0 -> all checks passed
+ */
+inline int result(const char *name) {
+    printf("%s: %s (%d failed checks)\n", name, failures == 0 ? "passed" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+}
+
+}
+
+#define CHECK(condition) testCheck::check((condition), #condition, __FILE__, __LINE__)
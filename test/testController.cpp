@@ -0,0 +1,449 @@
+/**
+ * @file testController.cpp
+ * @author your name (you@domain.com)
+ * @brief behaviour of the controller on a simulated clock, the packets it sends are captured
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "testCheck.hpp"
+#include "testFixture.hpp"
+
+namespace {
+
+using testFixture::now;
+using testFixture::fakeMicros;
+
+constexpr uint16_t maxSent = 32;
+constexpr uint16_t maxSentLen = 600;
+
+/**
+ * @brief packet passed to a transmit callback
+ */
+struct sentPacket {
+    uint8_t data[maxSentLen];
+    uint16_t length;
+    uint8_t targetIp[4];
+};
+
+sentPacket sent[maxSent];
+uint16_t sentCount = 0;
+
+uint8_t controllerIp[4] = {2, 0, 0, 1};
+uint8_t nodeIp[4] = {2, 0, 0, 2};
+uint8_t fallbackIp[4] = {2, 0, 0, 99};
+
+bool capture(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t, uint16_t) {
+
+    if (sentCount < maxSent) {
+        sentPacket &_sent = sent[sentCount++];
+        _sent.length = packetLen < maxSentLen ? packetLen : maxSentLen;
+        memcpy(_sent.data, packet, _sent.length);
+        memcpy(_sent.targetIp, targetIp, 4);
+    }
+    return true;
+}
+
+uint16_t countSentTo(const uint8_t *ip, uint16_t opCode) {
+    uint16_t _count = 0;
+    for (uint16_t i = 0; i < sentCount; i++) {
+        uint16_t _opCode = static_cast<uint16_t>(sent[i].data[8] | sent[i].data[9] << 8);
+        _count += memcmp(sent[i].targetIp, ip, 4) == 0 && _opCode == opCode;
+    }
+    return _count;
+}
+
+void testSequence(uint8_t *MAC) {
+
+    static ArtNetController::controllerStorage<1, 4> _tables;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setUnicastCallback(capture);
+
+    uint16_t _idx;
+    uint8_t _dmx[512] = {};
+    _controller.addUniverse(0, nodeIp, 4, _idx);
+    _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+
+    //0 disables the sequence check of the node, the sequence wraps from 255 to 1
+    uint8_t _last = 0;
+    bool _valid = true;
+    for (uint16_t i = 0; i < 600; i++) {
+        sentCount = 0;
+        now += 100000;
+        _controller.transmitDmx();
+        if (!CHECK(sentCount == 1)) {
+            return;
+        }
+        uint8_t _sequence = sent[0].data[12];
+        _valid &= _sequence != 0 && _sequence == (_last == 255 ? 1 : _last + 1);
+        _last = _sequence;
+    }
+    CHECK(_valid);
+    CHECK(countSentTo(nodeIp, 0x5000) == 1);
+}
+
+/**
+ * @brief let the node answer an ArtPoll and return the reply of one page
+ */
+const sentPacket *pollNode(ArtNetNode &node, uint8_t bindIndex) {
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    sentCount = 0;
+    node.handlePacket(_artPoll, sizeof(_artPoll), controllerIp, 4, 0x1936);
+
+    for (uint16_t i = 0; i < sentCount; i++) {
+        if (sent[i].length >= 212 && sent[i].data[211] == bindIndex) {
+            return &sent[i];
+        }
+    }
+    return nullptr;
+}
+
+void feedReply(ArtNetController &controller, const sentPacket *reply) {
+    if (CHECK(reply != nullptr)) {
+        sentPacket _reply = *reply;
+        controller.handlePacket(_reply.data, _reply.length, nodeIp, 4, 0x1936);
+    }
+}
+
+void testSubscribers(uint8_t *MAC) {
+
+    static ArtNetNode::portStorage<8> _ports;
+    static ArtNetNode _node(0x0000, MAC, 6, _ports);
+    _node.setUnicastCallback(capture);
+    _node.updateIp(nodeIp, 4);
+
+    //the first port of both pages outputs universe 15
+    for (uint16_t i = 0; i < 8; i++) {
+        _node.configureOutputPort(i, i);
+    }
+    _node.configureOutputPort(0, 15);
+    _node.configureOutputPort(4, 15);
+
+    static ArtNetController::controllerStorage<4, 8> _tables;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setUnicastCallback(capture);
+    _controller.enableUnicastMode(true);
+
+    uint16_t _idx;
+    uint8_t _dmx[512] = {1};
+    CHECK(_controller.addUniverse(15, fallbackIp, 4, _idx));
+    _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+
+    feedReply(_controller, pollNode(_node, 1));
+    feedReply(_controller, pollNode(_node, 2));
+
+    //the node is subscribed once although two of its pages output the universe
+    sentCount = 0;
+    now += 100000;
+    _controller.transmitDmx();
+    CHECK(countSentTo(nodeIp, 0x5000) == 1);
+    CHECK(countSentTo(fallbackIp, 0x5000) == 0);
+
+    //the second page moves away, the first page keeps the subscription
+    _node.configureOutputPort(4, 5);
+    feedReply(_controller, pollNode(_node, 2));
+
+    sentCount = 0;
+    now += 100000;
+    _controller.transmitDmx();
+    CHECK(countSentTo(nodeIp, 0x5000) == 1);
+
+    //no page outputs the universe anymore, it goes to the target of the universe
+    _node.configureOutputPort(0, 6);
+    feedReply(_controller, pollNode(_node, 1));
+
+    sentCount = 0;
+    now += 100000;
+    _controller.transmitDmx();
+    CHECK(countSentTo(nodeIp, 0x5000) == 0);
+    CHECK(countSentTo(fallbackIp, 0x5000) == 1);
+
+    //back again, then the node expires
+    _node.configureOutputPort(0, 15);
+    feedReply(_controller, pollNode(_node, 1));
+    now += 7000000;
+    CHECK(_controller.expireNodes() == 2);
+
+    sentCount = 0;
+    _controller.transmitDmx();
+    CHECK(countSentTo(fallbackIp, 0x5000) == 1);
+}
+
+void testUniverseAfterDiscovery(uint8_t *MAC) {
+
+    static ArtNetNode::portStorage<4> _ports;
+    static ArtNetNode _node(0x0000, MAC, 6, _ports);
+    _node.setUnicastCallback(capture);
+    _node.updateIp(nodeIp, 4);
+    _node.configureOutputPort(0, 3);
+
+    static ArtNetController::controllerStorage<4, 8> _tables;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setUnicastCallback(capture);
+    _controller.enableUnicastMode(true);
+    _controller.enableDeltaMode(true);
+
+    //the node is known before the universe is added
+    feedReply(_controller, pollNode(_node, 1));
+    CHECK(_controller.getNodeCount() == 1);
+
+    uint16_t _idx;
+    uint8_t _dmx[512] = {1};
+    CHECK(_controller.addUniverse(3, fallbackIp, 4, _idx));
+    _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+
+    sentCount = 0;
+    now += 100000;
+    _controller.transmitDmx();
+    CHECK(countSentTo(nodeIp, 0x5000) == 1);
+    CHECK(countSentTo(fallbackIp, 0x5000) == 0);
+
+    //the refresh rate of the node limits changes sent faster than it can output them
+    uint32_t _limited = _controller.getTxCounters().savedRateLimit;
+    _dmx[0] = 2;
+    _controller.setUniverseData(_idx, _dmx, sizeof(_dmx));
+    now += 5000;
+    sentCount = 0;
+    _controller.transmitDmx();
+    CHECK(sentCount == 0);
+    CHECK(_controller.getTxCounters().savedRateLimit == _limited + 1);
+
+    now += 20000;
+    _controller.transmitDmx();
+    CHECK(countSentTo(nodeIp, 0x5000) == 1);
+}
+
+
+uint16_t todChanges = 0;
+uint16_t todChangedAddress = 0;
+
+void onTodChanged(uint16_t portAddress) {
+    todChanges++;
+    todChangedAddress = portAddress;
+}
+
+/**
+ * @brief report a full table of devices of a Port-Address in one ArtTodData
+ */
+void reportTod(ArtNetController &controller, uint16_t portAddress, const uint8_t *devices, uint8_t count) {
+
+    uint8_t _packet[28 + 16 * 6] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x81, 0x00, 14, 1, 1};
+    _packet[21] = portAddress >> 8;
+    _packet[23] = portAddress & 0xff;
+    _packet[25] = count;
+    _packet[27] = count;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t _uid[6] = {0x7a, 0x70, 0, 0, 0, devices[i]};
+        memcpy(_packet + 28 + i * 6, _uid, sizeof(_uid));
+    }
+
+    controller.handlePacket(_packet, 28 + count * 6, nodeIp, 4, 0x1936);
+}
+
+void testTableOfDevices(uint8_t *MAC) {
+
+    static ArtNetController::controllerStorage<1, 4> _tables;
+    static ArtNetController::rdmStorage<32, 4> _rdm;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables, _rdm);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setTodCallback(onTodChanged);
+
+    const uint8_t _devices[3] = {3, 1, 2};
+    reportTod(_controller, 0x12, _devices, 3);
+
+    uint64_t _uids[8];
+    CHECK(_controller.getTod(0x12, _uids, 8) == 3);
+    CHECK(_uids[0] == 0x7a7000000001ULL && _uids[1] == 0x7a7000000002ULL && _uids[2] == 0x7a7000000003ULL);
+    CHECK(todChanges == 1 && todChangedAddress == 0x12);
+
+    //another Port-Address is independent
+    const uint8_t _other[1] = {9};
+    reportTod(_controller, 0x13, _other, 1);
+    CHECK(_controller.getTodSize() == 4);
+
+    //the same table again changes nothing
+    todChanges = 0;
+    reportTod(_controller, 0x12, _devices, 3);
+    CHECK(todChanges == 0);
+
+    //a full table without device 2 removes it
+    const uint8_t _shrunk[2] = {1, 3};
+    reportTod(_controller, 0x12, _shrunk, 2);
+    CHECK(_controller.getTod(0x12, _uids, 8) == 2);
+    CHECK(_uids[0] == 0x7a7000000001ULL && _uids[1] == 0x7a7000000003ULL);
+    CHECK(todChanges == 1);
+    CHECK(_controller.getTodSize() == 3);
+    CHECK(_controller.getTod(0x13, _uids, 8) == 1);
+}
+
+uint16_t rdmResponses = 0;
+uint16_t rdmTimeouts = 0;
+uint16_t rdmLastIdx = 0xffff;
+uint8_t rdmLastPacket[maxSentLen];
+uint16_t rdmLastLen = 0;
+
+void onRdmResult(uint16_t requestIdx, ArtNetController::rdmResults result, const uint8_t *rdmPacket, uint16_t rdmPacketLen) {
+    if (result == ArtNetController::rrResponse) {
+        rdmResponses++;
+        rdmLastLen = rdmPacketLen < maxSentLen ? rdmPacketLen : maxSentLen;
+        memcpy(rdmLastPacket, rdmPacket, rdmLastLen);
+    }
+    else if (result == ArtNetController::rrTimeout && rdmPacket == nullptr) {
+        rdmTimeouts++;
+    }
+    rdmLastIdx = requestIdx;
+}
+
+void testRdm(uint8_t *MAC) {
+
+    static ArtNetController::controllerStorage<1, 4> _tables;
+    static ArtNetController::rdmStorage<32, 4> _rdm;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables, _rdm);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setUnicastCallback(capture);
+    _controller.setRdmCallback(onRdmResult);
+    _controller.setRdmPipeline(1, 10, 2);
+
+    const uint8_t _devices[1] = {1};
+    reportTod(_controller, 0, _devices, 1);
+
+    //GET DEVICE_INFO
+    uint8_t _request[26] = {0x01, 24, 0x7a, 0x70, 0, 0, 0, 1, 0x7a, 0x70, 0, 0, 0, 0x99};
+    _request[19] = 0x20;
+    _request[21] = 0x60;
+
+    //a responder missing from the table has no route
+    uint16_t _idx;
+    _request[7] = 2;
+    CHECK(!_controller.queueRdm(0, _request, sizeof(_request), _idx));
+    _request[7] = 1;
+
+    //unanswered, the request is sent again twice and then times out
+    sentCount = 0;
+    CHECK(_controller.queueRdm(0, _request, sizeof(_request), _idx));
+    CHECK(countSentTo(nodeIp, 0x8300) == 1);
+
+    for (uint16_t i = 0; i < 40; i++) {
+        now += 1000;
+        _controller.service();
+    }
+
+    CHECK(countSentTo(nodeIp, 0x8300) == 3);
+    CHECK(rdmTimeouts == 1 && rdmResponses == 0 && rdmLastIdx == _idx);
+    CHECK(_controller.getRdmPending() == 0);
+
+    //answered, the response of a retransmission completes the request once
+    sentCount = 0;
+    CHECK(_controller.queueRdm(0, _request, sizeof(_request), _idx));
+
+    for (uint16_t i = 0; i < 11; i++) {
+        now += 1000;
+        _controller.service();
+    }
+    CHECK(countSentTo(nodeIp, 0x8300) == 2);
+
+    uint8_t _response[24 + 26];
+    memcpy(_response, sent[sentCount - 1].data, sizeof(_response));
+    memcpy(_response + 24 + 2, _request + 8, 6);
+    memcpy(_response + 24 + 8, _request + 2, 6);
+    _response[24 + 19] = 0x21;
+
+    _controller.handlePacket(_response, sizeof(_response), nodeIp, 4, 0x1936);
+    _controller.handlePacket(_response, sizeof(_response), nodeIp, 4, 0x1936);
+    CHECK(rdmResponses == 1 && rdmTimeouts == 1);
+    CHECK(_controller.getRdmPending() == 0);
+
+    //a response from another node is not taken
+    uint8_t _otherIp[4] = {2, 0, 0, 50};
+    CHECK(_controller.queueRdm(0, _request, sizeof(_request), _idx));
+    memcpy(_response, sent[sentCount - 1].data, sizeof(_response));
+    memcpy(_response + 24 + 2, _request + 8, 6);
+    memcpy(_response + 24 + 8, _request + 2, 6);
+    _response[24 + 19] = 0x21;
+    _controller.handlePacket(_response, sizeof(_response), _otherIp, 4, 0x1936);
+    CHECK(_controller.getRdmPending() == 1);
+}
+
+void testRdmWireFormat(uint8_t *MAC) {
+
+    static ArtNetController::controllerStorage<1, 4> _tables;
+    static ArtNetController::rdmStorage<32, 4> _rdm;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables, _rdm);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setUnicastCallback(capture);
+    _controller.setRdmCallback(onRdmResult);
+
+    const uint8_t _devices[1] = {1};
+    reportTod(_controller, 0x0105, _devices, 1);
+
+    //GET DEVICE_INFO to Port-Address 0x0105
+    uint8_t _request[26] = {0x01, 24, 0x7a, 0x70, 0, 0, 0, 1, 0x7a, 0x70, 0, 0, 0, 0x99};
+    _request[19] = 0x20;
+    _request[21] = 0x60;
+
+    uint16_t _idx;
+    sentCount = 0;
+    CHECK(_controller.queueRdm(0x0105, _request, sizeof(_request), _idx));
+    if (!CHECK(sentCount == 1)) {
+        return;
+    }
+
+    //Net at 21, Command at 22, Address at 23, the RDM packet without start code from 24
+    const sentPacket &_sent = sent[0];
+    CHECK(_sent.data[12] == 0x01);
+    CHECK(_sent.data[21] == 0x01 && _sent.data[22] == 0x00 && _sent.data[23] == 0x05);
+    CHECK(_sent.data[24] == 0x01 && _sent.data[25] == 24);
+    CHECK(memcmp(_sent.data + 24 + 2, _request + 2, 12) == 0);
+    uint8_t _transaction = _sent.data[24 + 14];
+
+    //ArtRdm response as laid out by the spec, ACK with no parameter data
+    uint8_t _response[24 + 25] = {
+        'A', 'r', 't', '-', 'N', 'e', 't', 0x00,   //ID
+        0x00, 0x83,                                 //OpCode
+        0x00, 14,                                   //ProtVer
+        0x01, 0x00,                                 //RdmVer, Filler2
+        0x00, 0x00, 0x00, 0x00, 0x00,               //Spare1-5
+        0x00, 0x00,                                 //FifoAvail, FifoMax
+        0x01, 0x00, 0x05,                           //Net, Command ArProcess, Address
+        0x01, 24,                                   //sub start code, message length
+        0x7a, 0x70, 0x00, 0x00, 0x00, 0x99,         //destination UID
+        0x7a, 0x70, 0x00, 0x00, 0x00, 0x01,         //source UID
+        _transaction, 0x00, 0x00, 0x00, 0x00,       //transaction, response type, message count, sub-device
+        0x21, 0x00, 0x60, 0x00,                     //GET_COMMAND_RESPONSE, DEVICE_INFO, parameter data length
+        0x00, 0x00                                  //checksum
+    };
+
+    rdmResponses = 0;
+    _controller.handlePacket(_response, sizeof(_response), nodeIp, 4, 0x1936);
+    CHECK(rdmResponses == 1 && rdmLastIdx == _idx);
+    CHECK(rdmLastLen == 25 && rdmLastPacket[0] == 0x01 && rdmLastPacket[19] == 0x21 && rdmLastPacket[21] == 0x60);
+    CHECK(_controller.getRdmPending() == 0);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    testSequence(_mac);
+    testSubscribers(_mac);
+    testUniverseAfterDiscovery(_mac);
+    testTableOfDevices(_mac);
+    testRdm(_mac);
+    testRdmWireFormat(_mac);
+
+    return testCheck::result("testController");
+}
@@ -0,0 +1,81 @@
+/**
+ * @file testFixture.hpp
+ * @author your name (you@domain.com)
+ * @brief simulated clock and a node recording its outputs, shared by the tests
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <ArtNetFakeTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <string.h>
+
+namespace testFixture {
+
+constexpr uint16_t maxPorts = 16;
+constexpr uint16_t maxSlots = 512;
+
+inline uint64_t now = 0;                    //microseconds
+inline uint16_t outputCount[maxPorts];
+inline uint8_t outputSlots[maxPorts][maxSlots];  //last output, zero beyond its length
+inline uint16_t outputLength[maxPorts];
+
+inline uint64_t fakeMicros() {
+    return now;
+}
+
+inline bool recordOutput(uint8_t *dmxData, uint16_t dmxDataSize, uint16_t portIdx) {
+    if (portIdx < maxPorts) {
+        outputCount[portIdx]++;
+        memset(outputSlots[portIdx], 0, sizeof(outputSlots[portIdx]));
+        memcpy(outputSlots[portIdx], dmxData, dmxDataSize < sizeof(outputSlots[portIdx]) ? dmxDataSize : sizeof(outputSlots[portIdx]));
+        outputLength[portIdx] = dmxDataSize;
+    }
+    return true;
+}
+
+inline void clearOutputs() {
+    memset(outputCount, 0, sizeof(outputCount));
+    memset(outputSlots, 0, sizeof(outputSlots));
+    memset(outputLength, 0, sizeof(outputLength));
+}
+
+inline uint16_t totalOutputs() {
+    uint16_t _total = 0;
+    for (uint16_t i = 0; i < maxPorts; i++) {
+        _total += outputCount[i];
+    }
+    return _total;
+}
+
+/**
+ * @brief node on the simulated clock and the in memory transport, every port an output of the
+ * Port-Address of its index
+ *
+ * @tparam portCount number of ports, valid range 1:maxPorts
+ */
+template <uint16_t portCount>
+struct nodeFixture {
+    static_assert(portCount > 0 && portCount <= maxPorts, "the fixture records up to maxPorts outputs");
+
+    ArtNetNode::portStorage<portCount> ports;
+    ArtNetNode node;
+
+    nodeFixture(uint8_t *MAC) : node(0x0000, MAC, 6, ports) {
+        node.setTimeCallback(fakeMicros);
+        node.setUnicastCallback(ArtNetFakeTransport::sendUnicast);
+        node.setOutputDmxCallback(recordOutput);
+        for (uint16_t i = 0; i < portCount; i++) {
+            node.configureOutputPort(i, i);
+        }
+        ArtNetFakeTransport::reset();
+        clearOutputs();
+    }
+};
+
+}
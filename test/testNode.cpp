@@ -0,0 +1,474 @@
+/**
+ * @file testNode.cpp
+ * @author your name (you@domain.com)
+ * @brief behaviour of the node on a simulated clock over the in memory transport
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetFakeTransport.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "testCheck.hpp"
+#include "testFixture.hpp"
+
+namespace {
+
+using namespace testFixture;
+
+constexpr uint16_t portCount = 8;
+
+uint8_t controllerIp[4] = {2, 0, 0, 1};
+uint8_t otherIp[4] = {2, 0, 0, 3};
+uint8_t thirdIp[4] = {2, 0, 0, 4};
+
+ArtNet::packetStatus sendDmx(ArtNetNode &node, uint16_t portAddress, uint8_t sequence, uint8_t slot0, uint8_t slot1,
+    uint8_t *senderIp = controllerIp) {
+
+    uint8_t _packet[18 + 2] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, sequence, 0,
+        static_cast<uint8_t>(portAddress), static_cast<uint8_t>(portAddress >> 8), 0x00, 0x02, slot0, slot1};
+    return node.handlePacket(_packet, sizeof(_packet), senderIp, 4, 0x1936);
+}
+
+/**
+ * @brief send a full frame with every slot set to one value
+ */
+ArtNet::packetStatus sendFullDmx(ArtNetNode &node, uint16_t portAddress, uint8_t value, uint8_t *senderIp) {
+
+    uint8_t _packet[18 + 512] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0,
+        static_cast<uint8_t>(portAddress), static_cast<uint8_t>(portAddress >> 8), 0x02, 0x00};
+    memset(_packet + 18, value, 512);
+    return node.handlePacket(_packet, sizeof(_packet), senderIp, 4, 0x1936);
+}
+
+ArtNet::packetStatus sendSync(ArtNetNode &node) {
+    uint8_t _packet[14] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x52, 0x00, 14};
+    return node.handlePacket(_packet, sizeof(_packet), controllerIp, 4, 0x1936);
+}
+
+void testMerge(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+
+    //HTP takes the higher value of every slot
+    sendDmx(_node, 0, 0, 100, 0, controllerIp);
+    sendDmx(_node, 0, 0, 50, 200, otherIp);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 100 && outputSlots[0][1] == 200);
+
+    //a third source is ignored
+    sendDmx(_node, 0, 0, 255, 255, thirdIp);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 100 && outputSlots[0][1] == 200);
+
+    //LTP takes the latest frame
+    CHECK(_node.setMergeMode(0, true));
+    sendDmx(_node, 0, 0, 10, 20, controllerIp);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 10 && outputSlots[0][1] == 20);
+
+    //a source which stopped leaves the merge after the merge timeout
+    CHECK(_node.setMergeMode(0, false));
+    now += 11000000;
+    sendDmx(_node, 0, 0, 1, 2, controllerIp);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 1 && outputSlots[0][1] == 2);
+}
+
+void testMergeTakeOver(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+
+    //a full frame source next to a dark one
+    sendFullDmx(_node, 1, 200, controllerIp);
+    sendFullDmx(_node, 1, 0, otherIp);
+    _node.processOutputs();
+    CHECK(outputLength[1] == 512 && outputSlots[1][511] == 200);
+
+    //the first source stops, the dark one keeps sending
+    for (uint16_t i = 0; i < 11; i++) {
+        now += 1000000;
+        sendFullDmx(_node, 1, 0, otherIp);
+    }
+
+    //a short frame source takes over the free merge slot, nothing of the old source is left
+    sendDmx(_node, 1, 0, 7, 8, thirdIp);
+    _node.processOutputs();
+    CHECK(outputLength[1] == 512);
+    CHECK(outputSlots[1][0] == 7 && outputSlots[1][1] == 8);
+
+    bool _dark = true;
+    for (uint16_t i = 2; i < 512; i++) {
+        _dark &= outputSlots[1][i] == 0;
+    }
+    CHECK(_dark);
+}
+
+void testSync(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+
+    //the first ArtSync enters sync mode, frames wait for the next one
+    sendSync(_node);
+    for (uint16_t i = 0; i < 4; i++) {
+        sendDmx(_node, i, 0, static_cast<uint8_t>(i + 1), 0);
+    }
+    _node.processOutputs();
+    CHECK(totalOutputs() == 0);
+
+    sendSync(_node);
+    _node.processOutputs();
+    CHECK(totalOutputs() == 4);
+    CHECK(outputSlots[0][0] == 1 && outputSlots[3][0] == 4);
+
+    //ArtSync stops, the staged frames of all ports go out once the sync timeout passed
+    clearOutputs();
+    for (uint16_t i = 0; i < 4; i++) {
+        sendDmx(_node, i, 0, static_cast<uint8_t>(i + 11), 0);
+    }
+    now += 1000000;
+    _node.service();
+    _node.processOutputs();
+    CHECK(totalOutputs() == 0);
+
+    now += 4000000;
+    _node.service();
+    _node.processOutputs();
+    CHECK(totalOutputs() == 4);
+    CHECK(outputSlots[0][0] == 11 && outputSlots[3][0] == 14);
+
+    //back in immediate mode
+    clearOutputs();
+    sendDmx(_node, 5, 0, 21, 0);
+    _node.processOutputs();
+    CHECK(outputCount[5] == 1 && outputSlots[5][0] == 21);
+
+    //disabling sync publishes what is staged as well
+    sendSync(_node);
+    clearOutputs();
+    sendDmx(_node, 6, 0, 31, 0);
+    _node.enableSync(false);
+    _node.service();
+    _node.processOutputs();
+    CHECK(outputCount[6] == 1 && outputSlots[6][0] == 31);
+}
+
+void testReplyJitter(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+    _node.setReplyJitter(20);
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+    CHECK(_node.handlePacket(_artPoll, sizeof(_artPoll), controllerIp, 4, 0x1936) == ArtNet::psOk);
+    CHECK(ArtNetFakeTransport::getCounters().packets == 0);
+
+    //a transport running serviceReceive() itself sends the delayed replies, service() leaves them alone
+    _node.setReceiveServiceExternal(true);
+    now += 21000;
+    _node.service();
+    CHECK(ArtNetFakeTransport::getCounters().packets == 0);
+
+    _node.serviceReceive();
+    CHECK(ArtNetFakeTransport::getCounters().packets == portCount / 4);
+    CHECK(memcmp(ArtNetFakeTransport::getLastTargetIp(), controllerIp, 4) == 0);
+
+    //sent once
+    _node.setReceiveServiceExternal(false);
+    now += 21000;
+    _node.service();
+    CHECK(ArtNetFakeTransport::getCounters().packets == portCount / 4);
+}
+
+void testSequenceCheck(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+    _node.setSequenceCheck(true, 0);
+
+    sendDmx(_node, 0, 10, 1, 0);
+    _node.processOutputs();
+    CHECK(outputCount[0] == 1 && outputSlots[0][0] == 1);
+
+    //older than the last frame of the source
+    sendDmx(_node, 0, 9, 2, 0);
+    sendDmx(_node, 0, 10, 3, 0);
+    _node.processOutputs();
+    CHECK(outputCount[0] == 1 && outputSlots[0][0] == 1);
+
+    sendDmx(_node, 0, 11, 4, 0);
+    _node.processOutputs();
+    CHECK(outputCount[0] == 2 && outputSlots[0][0] == 4);
+
+    //wrap from 255 to 1 is newer
+    sendDmx(_node, 0, 100, 5, 0);
+    sendDmx(_node, 0, 200, 5, 0);
+    sendDmx(_node, 0, 255, 5, 0);
+    sendDmx(_node, 0, 1, 6, 0);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 6);
+
+    //sequence 0 is never checked
+    sendDmx(_node, 0, 0, 7, 0);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 7);
+}
+
+void testReorderWindow(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+    _node.setSequenceCheck(true, 2000);
+
+    sendDmx(_node, 0, 1, 1, 0);
+
+    //frame 3 is held until frame 2 arrives, then both are applied in order
+    sendDmx(_node, 0, 3, 3, 0);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 1);
+
+    sendDmx(_node, 0, 2, 2, 0);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 3);
+
+    //a gap which is never filled is applied once the window passed
+    sendDmx(_node, 0, 5, 5, 0);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 3);
+
+    now += 3000;
+    sendDmx(_node, 0, 6, 6, 0);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 6);
+
+    //the source stalls right after the gap, service() releases the held frame
+    clearOutputs();
+    sendDmx(_node, 0, 8, 8, 0);
+    now += 1000;
+    _node.service();
+    _node.processOutputs();
+    CHECK(outputCount[0] == 0);
+
+    now += 1500;
+    _node.service();
+    _node.processOutputs();
+    CHECK(outputCount[0] == 1 && outputSlots[0][0] == 8);
+
+    //once
+    now += 3000;
+    _node.service();
+    _node.processOutputs();
+    CHECK(outputCount[0] == 1);
+
+    //a hold released in sync mode waits for the next ArtSync
+    clearOutputs();
+    sendSync(_node);
+    sendDmx(_node, 0, 10, 10, 0);
+    now += 3000;
+    _node.service();
+    _node.processOutputs();
+    CHECK(outputCount[0] == 0);
+
+    sendSync(_node);
+    _node.processOutputs();
+    CHECK(outputCount[0] == 1 && outputSlots[0][0] == 10);
+}
+
+void testDataRequest(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+
+    CHECK(_node.setUrl(ArtNet::drUrlProduct, "https://example.com/node"));
+
+    uint8_t _request[40] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x27, 0x00, 14, 0, 0, 0x00, 0x00, 0x00, ArtNet::drUrlProduct};
+    CHECK(_node.handlePacket(_request, sizeof(_request), controllerIp, 4, 0x1936) == ArtNet::psOk);
+
+    uint16_t _replyLen;
+    const uint8_t *_reply = ArtNetFakeTransport::getLastPacket(_replyLen);
+    uint16_t _payloadLen = _replyLen >= 20 ? static_cast<uint16_t>(_reply[18] << 8 | _reply[19]) : 0;
+
+    CHECK(_replyLen >= 20 && _reply[9] == 0x28);
+    CHECK(_replyLen >= 20 && _reply[17] == ArtNet::drUrlProduct);
+    CHECK(_payloadLen >= strlen("https://example.com/node"));
+    CHECK(_payloadLen > 0 && memcmp(_reply + 20, "https://example.com/node", strlen("https://example.com/node")) == 0);
+}
+
+/**
+ * @brief build an ArtAddress which keeps everything except the given fields
+ */
+void buildAddress(uint8_t *packet, uint8_t bindIndex, const char *shortName) {
+    const uint8_t _header[12] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x60, 0x00, 14};
+    memset(packet, 0, 107);
+    memcpy(packet, _header, sizeof(_header));
+    packet[12] = 0x7f;                      //net unchanged
+    packet[13] = bindIndex;
+    strncpy(reinterpret_cast<char*>(packet + 14), shortName, 17);
+    memset(packet + 96, 0x7f, 8);           //swIn and swOut unchanged
+    packet[104] = 0x7f;                     //sub-net unchanged
+    packet[105] = 0xff;                     //acnPriority unchanged
+    packet[106] = 0x00;                     //acNone
+}
+
+void testArtAddress(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+
+    //bind index 2 is the second page, its first port moves from Port-Address 4 to 9
+    uint8_t _address[107];
+    buildAddress(_address, 2, "page two");
+    _address[100] = 0x80 | 0x09;
+
+    CHECK(_node.handlePacket(_address, sizeof(_address), controllerIp, 4, 0x1936) == ArtNet::psOk);
+
+    //answered to the sender with one reply per page, the changed page is the last one
+    uint16_t _replyLen;
+    const uint8_t *_reply = ArtNetFakeTransport::getLastPacket(_replyLen);
+    CHECK(ArtNetFakeTransport::getCounters().packets == portCount / 4);
+    CHECK(memcmp(ArtNetFakeTransport::getLastTargetIp(), controllerIp, 4) == 0);
+    CHECK(_replyLen >= 212 && _reply[9] == 0x21);
+    CHECK(_replyLen >= 212 && strcmp(reinterpret_cast<const char*>(_reply + 26), "page two") == 0);
+    CHECK(_replyLen >= 212 && _reply[190] == 0x09 && _reply[191] == 0x05);
+    CHECK(_replyLen >= 212 && _reply[211] == 2);
+
+    //the ports follow the new Port-Address right away, the other page is untouched
+    sendDmx(_node, 9, 0, 11, 12);
+    sendDmx(_node, 4, 0, 13, 14);
+    sendDmx(_node, 1, 0, 15, 16);
+    _node.processOutputs();
+
+    CHECK(outputCount[4] == 1 && outputSlots[4][0] == 11);
+    CHECK(outputCount[1] == 1 && outputSlots[1][0] == 15);
+    CHECK(totalOutputs() == 2);
+
+    //a page the node does not have changes nothing
+    uint64_t _sent = ArtNetFakeTransport::getCounters().packets;
+    buildAddress(_address, 5, "no page");
+    _address[100] = 0x80 | 0x01;
+    CHECK(_node.handlePacket(_address, sizeof(_address), controllerIp, 4, 0x1936) == ArtNet::psInvalidContent);
+    CHECK(ArtNetFakeTransport::getCounters().packets == _sent);
+
+    clearOutputs();
+    sendDmx(_node, 9, 0, 17, 18);
+    _node.processOutputs();
+    CHECK(outputCount[4] == 1 && outputSlots[4][0] == 17);
+}
+
+void testChangeReplyWindow(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+    _node.setChangeReplyWindow(10);
+
+    uint8_t _address[107];
+    buildAddress(_address, 1, "");
+
+    //a burst of two controllers inside the window is answered by one broadcast reply from service()
+    _node.handlePacket(_address, sizeof(_address), controllerIp, 4, 0x1936);
+    _node.handlePacket(_address, sizeof(_address), otherIp, 4, 0x1936);
+    _node.service();
+    CHECK(ArtNetFakeTransport::getCounters().packets == 0);
+
+    now += 5000;
+    _node.service();
+    CHECK(ArtNetFakeTransport::getCounters().packets == 0);
+
+    now += 6000;
+    _node.service();
+    CHECK(ArtNetFakeTransport::getCounters().packets == portCount / 4);
+
+    const uint8_t _broadcastIp[4] = {255, 255, 255, 255};
+    CHECK(memcmp(ArtNetFakeTransport::getLastTargetIp(), _broadcastIp, 4) == 0);
+
+    //a single controller gets its reply unicast
+    _node.handlePacket(_address, sizeof(_address), controllerIp, 4, 0x1936);
+    _node.service();
+    now += 11000;
+    _node.service();
+    CHECK(ArtNetFakeTransport::getCounters().packets == 2 * portCount / 4);
+    CHECK(memcmp(ArtNetFakeTransport::getLastTargetIp(), controllerIp, 4) == 0);
+}
+
+/**
+ * @brief run service() in steps of one millisecond
+ */
+void runMillis(ArtNetNode &node, uint32_t millis) {
+    for (uint32_t i = 0; i < millis; i++) {
+        now += 1000;
+        node.service();
+        node.processOutputs();
+    }
+}
+
+void testFailSafe(uint8_t *MAC) {
+
+    static nodeFixture<portCount> _fixture(MAC);
+    ArtNetNode &_node = _fixture.node;
+    CHECK(_node.setFailSafe(ArtNet::fssOutputZero, 100));
+    CHECK(!_node.setFailSafe(ArtNet::fssOutputZero, 0));
+
+    for (uint16_t k = 0; k < 10; k++) {
+        sendDmx(_node, 0, 0, 50, 60);
+        runMillis(_node, 20);
+    }
+    CHECK(outputSlots[0][0] == 50 && outputSlots[0][1] == 60);
+
+    //no frames for longer than the timeout, the last one arrived 20 ms ago
+    runMillis(_node, 70);
+    CHECK(outputSlots[0][0] == 50);
+    runMillis(_node, 20);
+    CHECK(outputSlots[0][0] == 0 && outputSlots[0][1] == 0);
+
+    //data returns
+    sendDmx(_node, 0, 0, 70, 80);
+    _node.processOutputs();
+    CHECK(outputSlots[0][0] == 70);
+
+    //stale frames do not keep the port alive
+    _node.setSequenceCheck(true, 0);
+    sendDmx(_node, 0, 20, 90, 90);
+    for (uint16_t k = 0; k < 10; k++) {
+        runMillis(_node, 20);
+        sendDmx(_node, 0, 19, 91, 91);
+    }
+    CHECK(outputSlots[0][0] == 0);
+
+    //the recorded scene is played after the timeout
+    CHECK(_node.setFailSafe(ArtNet::fssPlayScene, 100));
+    sendDmx(_node, 0, 0, 33, 44);
+    _node.processOutputs();
+    _node.recordFailSafeScene();
+    _node.processOutputs();
+    sendDmx(_node, 0, 0, 1, 1);
+    _node.processOutputs();
+    runMillis(_node, 150);
+    CHECK(outputSlots[0][0] == 33 && outputSlots[0][1] == 44);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    testMerge(_mac);
+    testMergeTakeOver(_mac);
+    testSync(_mac);
+    testReplyJitter(_mac);
+    testSequenceCheck(_mac);
+    testReorderWindow(_mac);
+    testDataRequest(_mac);
+    testArtAddress(_mac);
+    testChangeReplyWindow(_mac);
+    testFailSafe(_mac);
+
+    return testCheck::result("testNode");
+}
@@ -0,0 +1,313 @@
+/**
+ * @file testSacn.cpp
+ * @author your name (you@domain.com)
+ * @brief behaviour of the sACN gateway: both directions of the conversion, source arbitration, the
+ * reported port status and the acnPriority of ArtAddress, on a simulated clock
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetSacn.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "testCheck.hpp"
+#include "testFixture.hpp"
+
+namespace {
+
+using testFixture::now;
+using testFixture::fakeMicros;
+
+constexpr uint8_t maxCaptured = 8;
+constexpr uint16_t maxCaptureLen = 640;
+
+/**
+ * @brief packets sent on one side of the gateway
+ */
+struct capture {
+    uint8_t packets[maxCaptured][maxCaptureLen];
+    uint16_t lengths[maxCaptured];
+    uint8_t targetIps[maxCaptured][4];
+    uint16_t targetPorts[maxCaptured];
+    uint8_t count;
+
+    void clear() {
+        count = 0;
+    }
+
+    bool store(const uint8_t *packet, uint16_t packetLen, const uint8_t *targetIp, uint16_t targetPort) {
+        if (count == maxCaptured || packetLen > maxCaptureLen) {
+            return false;
+        }
+        memcpy(packets[count], packet, packetLen);
+        memcpy(targetIps[count], targetIp, 4);
+        lengths[count] = packetLen;
+        targetPorts[count] = targetPort;
+        count++;
+        return true;
+    }
+};
+
+capture artNetSent;
+capture sacnSent;
+
+uint8_t controllerIp[4] = {2, 0, 0, 1};
+uint8_t sourceIp[4] = {2, 0, 0, 5};
+const uint8_t cidA[16] = {0xa0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+const uint8_t cidB[16] = {0xb0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+bool captureArtNet(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t, uint16_t targetPort) {
+    return artNetSent.store(packet, packetLen, targetIp, targetPort);
+}
+
+bool captureSacn(uint8_t *packet, uint16_t packetLen, uint8_t *targetIp, uint8_t, uint16_t targetPort) {
+    return sacnSent.store(packet, packetLen, targetIp, targetPort);
+}
+
+uint16_t readBigEndian(const uint8_t *data) {
+    return static_cast<uint16_t>(data[0] << 8 | data[1]);
+}
+
+void writeBigEndian(uint8_t *data, uint32_t value, uint8_t len) {
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = static_cast<uint8_t>(value >> (8 * (len - 1 - i)));
+    }
+}
+
+/**
+ * @brief build an E1.31 data packet
+ *
+ * @return length of the packet
+ */
+uint16_t buildSacn(uint8_t *packet, const uint8_t *cid, uint16_t universe, uint8_t priority, uint8_t sequence,
+    const uint8_t *slots, uint16_t slotCount) {
+
+    static constexpr uint8_t _acnPid[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00};
+    uint16_t _packetLen = 126 + slotCount;
+
+    memset(packet, 0, 126);
+    writeBigEndian(packet, 0x0010, 2);
+    memcpy(packet + 4, _acnPid, sizeof(_acnPid));
+    writeBigEndian(packet + 16, 0x7000 | (_packetLen - 16), 2);
+    writeBigEndian(packet + 18, 0x00000004, 4);
+    memcpy(packet + 22, cid, 16);
+    writeBigEndian(packet + 38, 0x7000 | (_packetLen - 38), 2);
+    writeBigEndian(packet + 40, 0x00000002, 4);
+    packet[108] = priority;
+    packet[111] = sequence;
+    writeBigEndian(packet + 113, universe, 2);
+    writeBigEndian(packet + 115, 0x7000 | (_packetLen - 115), 2);
+    packet[117] = 0x02;
+    packet[118] = 0xa1;
+    writeBigEndian(packet + 121, 1, 2);
+    writeBigEndian(packet + 123, slotCount + 1, 2);
+    memcpy(packet + 126, slots, slotCount);
+
+    return _packetLen;
+}
+
+ArtNet::packetStatus sendDmx(ArtNetSacnGateway &gateway, uint16_t portAddress, uint8_t slot0, uint8_t slot1,
+    uint8_t *senderIp = controllerIp) {
+
+    uint8_t _packet[18 + 2] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14, 0, 0,
+        static_cast<uint8_t>(portAddress), static_cast<uint8_t>(portAddress >> 8), 0x00, 0x02, slot0, slot1};
+    return gateway.handlePacket(_packet, sizeof(_packet), senderIp, 4, 0x1936);
+}
+
+/**
+ * @brief poll the gateway and keep the reply of one page
+ *
+ * @return reply of the page, nullptr -> no reply
+ */
+const uint8_t *pollPage(ArtNetSacnGateway &gateway, uint8_t bindIndex) {
+
+    uint8_t _artPoll[22] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x20, 0x00, 14};
+
+    artNetSent.clear();
+    gateway.handlePacket(_artPoll, sizeof(_artPoll), controllerIp, 4, 0x1936);
+
+    for (uint8_t i = 0; i < artNetSent.count; i++) {
+        if (artNetSent.packets[i][9] == 0x21 && artNetSent.packets[i][211] == bindIndex) {
+            return artNetSent.packets[i];
+        }
+    }
+    return nullptr;
+}
+
+void testArtNetToSacn(ArtNetSacnGateway &gateway) {
+
+    CHECK(gateway.mapArtNetToSacn(0, 0x0001, 7, 150));
+    CHECK(!gateway.mapArtNetToSacn(1, 0x0011, 8));     //sub-net differs from port 0 of the page
+    CHECK(!gateway.mapArtNetToSacn(1, 0x0002, 64000));
+
+    sacnSent.clear();
+    CHECK(sendDmx(gateway, 0x0001, 11, 22) == ArtNet::psOk);
+    CHECK(sendDmx(gateway, 0x0001, 33, 44) == ArtNet::psOk);
+    CHECK(sendDmx(gateway, 0x0002, 55, 66) == ArtNet::psOk);   //not mapped
+
+    //sent to the multicast group of the universe with the priority of the mapping
+    const uint8_t _group[4] = {239, 255, 0, 7};
+    CHECK(sacnSent.count == 2);
+    CHECK(sacnSent.lengths[0] == 126 + 2);
+    CHECK(sacnSent.targetPorts[0] == 5568);
+    CHECK(memcmp(sacnSent.targetIps[0], _group, 4) == 0);
+
+    const uint8_t *_sacn = sacnSent.packets[1];
+    CHECK(readBigEndian(_sacn + 113) == 7);
+    CHECK(_sacn[108] == 150);
+    CHECK(readBigEndian(_sacn + 123) == 3);
+    CHECK(_sacn[125] == 0);
+    CHECK(_sacn[126] == 33 && _sacn[127] == 44);
+    CHECK(static_cast<uint8_t>(_sacn[111] - sacnSent.packets[0][111]) == 1);
+    CHECK(readBigEndian(_sacn + 16) == (0x7000 | (128 - 16)));
+    CHECK(gateway.getGatewayCounters().toSacn == 2);
+
+    //the gateway drops its own packets coming back, on Art-Net by the ip and on sACN by the CID
+    const uint8_t *_reply = pollPage(gateway, 1);
+    CHECK(_reply != nullptr);
+    uint8_t _gatewayIp[4];
+    memcpy(_gatewayIp, _reply + 10, sizeof(_gatewayIp));
+
+    sacnSent.clear();
+    CHECK(sendDmx(gateway, 0x0001, 1, 2, _gatewayIp) == ArtNet::psOk);
+    CHECK(sacnSent.count == 0);
+
+    CHECK(sendDmx(gateway, 0x0001, 1, 2) == ArtNet::psOk);
+    uint32_t _ignored = gateway.getGatewayCounters().sacnIgnored;
+    CHECK(gateway.handleSacnPacket(sacnSent.packets[0], sacnSent.lengths[0], _gatewayIp, 4) == ArtNet::psOk);
+    CHECK(gateway.getGatewayCounters().sacnIgnored == _ignored + 1);
+}
+
+void testSacnToArtNet(ArtNetSacnGateway &gateway) {
+
+    CHECK(gateway.mapSacnToArtNet(4, 9, 0x0012, controllerIp, 4));
+
+    uint8_t _sacn[126 + 512];
+    const uint8_t _slots[3] = {10, 20, 30};
+
+    //odd slot counts are padded to the even length of ArtDmx
+    artNetSent.clear();
+    uint16_t _len = buildSacn(_sacn, cidA, 9, 100, 1, _slots, sizeof(_slots));
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+
+    CHECK(artNetSent.count == 1);
+    const uint8_t *_dmx = artNetSent.packets[0];
+    CHECK(artNetSent.lengths[0] == 18 + 4);
+    CHECK(artNetSent.targetPorts[0] == 0x1936);
+    CHECK(memcmp(artNetSent.targetIps[0], controllerIp, 4) == 0);
+    CHECK(_dmx[8] == 0x00 && _dmx[9] == 0x50);
+    CHECK(_dmx[12] == 1);
+    CHECK(_dmx[14] == 0x12 && _dmx[15] == 0x00);
+    CHECK(readBigEndian(_dmx + 16) == 4);
+    CHECK(_dmx[18] == 10 && _dmx[19] == 20 && _dmx[20] == 30 && _dmx[21] == 0);
+
+    //a duplicate of the source is dropped
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    CHECK(gateway.getGatewayCounters().sacnOutOfOrder == 1);
+
+    //a second source of lower or equal priority is ignored while the first is active
+    artNetSent.clear();
+    _len = buildSacn(_sacn, cidB, 9, 50, 1, _slots, sizeof(_slots));
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    _len = buildSacn(_sacn, cidB, 9, 100, 2, _slots, sizeof(_slots));
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    CHECK(artNetSent.count == 0);
+    CHECK(gateway.getGatewayCounters().sacnLowerPriority == 2);
+
+    //a higher priority takes over
+    _len = buildSacn(_sacn, cidB, 9, 120, 3, _slots, sizeof(_slots));
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    CHECK(artNetSent.count == 1);
+    CHECK(artNetSent.packets[0][12] == 2);
+
+    //the first source is back to a lower priority than the active one
+    _len = buildSacn(_sacn, cidA, 9, 100, 2, _slots, sizeof(_slots));
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    CHECK(artNetSent.count == 1);
+
+    //after the source timeout any source is taken again
+    now += 3000000;
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    CHECK(artNetSent.count == 2);
+
+    //unmapped universes and malformed packets
+    uint32_t _ignored = gateway.getGatewayCounters().sacnIgnored;
+    _len = buildSacn(_sacn, cidA, 10, 100, 3, _slots, sizeof(_slots));
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psOk);
+    CHECK(gateway.getGatewayCounters().sacnIgnored == _ignored + 1);
+
+    _sacn[4] = 'X';
+    CHECK(gateway.handleSacnPacket(_sacn, _len, sourceIp, 4) == ArtNet::psInvalidContent);
+    CHECK(gateway.handleSacnPacket(_sacn, 100, sourceIp, 4) == ArtNet::psTooShort);
+    CHECK(gateway.getGatewayCounters().sacnInvalid == 2);
+}
+
+void testPortStatus(ArtNetSacnGateway &gateway) {
+
+    //each direction is reported in the status of its port type, the priority by the first sACN output
+    const uint8_t *_reply = pollPage(gateway, 1);
+    CHECK(_reply != nullptr);
+    if (_reply != nullptr) {
+        CHECK((_reply[182] & 0x01) != 0);
+        CHECK((_reply[178] & 0x01) == 0);
+        CHECK(_reply[194] == 150);
+        CHECK((_reply[212] & 0x10) != 0);
+    }
+
+    _reply = pollPage(gateway, 2);
+    CHECK(_reply != nullptr);
+    if (_reply != nullptr) {
+        CHECK((_reply[178] & 0x01) != 0);
+        CHECK((_reply[182] & 0x01) == 0);
+    }
+
+    //ArtAddress sets the priority of the page it is bound to
+    uint8_t _address[107] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x60, 0x00, 14, 0x7f, 1};
+    memset(_address + 96, 0x7f, 8);
+    _address[104] = 0x7f;
+    _address[105] = 60;
+    CHECK(gateway.handlePacket(_address, sizeof(_address), controllerIp, 4, 0x1936) == ArtNet::psOk);
+
+    sacnSent.clear();
+    CHECK(sendDmx(gateway, 0x0001, 1, 2) == ArtNet::psOk);
+    CHECK(sacnSent.count == 1 && sacnSent.packets[0][108] == 60);
+
+    _reply = pollPage(gateway, 1);
+    CHECK(_reply != nullptr && _reply[194] == 60);
+
+    //out of range priorities are rejected
+    CHECK(!gateway.setAcnPriority(0, 201));
+    CHECK(!gateway.setAcnPriority(4, 80));
+    CHECK(gateway.setAcnPriority(0, 80));
+
+    //an unmapped port is reported without sACN and sends nothing
+    CHECK(gateway.unmap(0));
+    sacnSent.clear();
+    CHECK(sendDmx(gateway, 0x0001, 1, 2) == ArtNet::psOk);
+    CHECK(sacnSent.count == 0);
+
+    _reply = pollPage(gateway, 1);
+    CHECK(_reply != nullptr && (_reply[182] & 0x01) == 0);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    static ArtNetSacnGateway::gatewayStorage<8> _storage;
+    static ArtNetSacnGateway _gateway(0x0000, _mac, sizeof(_mac), _storage);
+    _gateway.setTimeCallback(fakeMicros);
+    _gateway.setUnicastCallback(captureArtNet);
+    _gateway.setSacnCallback(captureSacn);
+
+    testArtNetToSacn(_gateway);
+    testSacnToArtNet(_gateway);
+    testPortStatus(_gateway);
+
+    return testCheck::result("testSacn");
+}
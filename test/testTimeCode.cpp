@@ -0,0 +1,162 @@
+/**
+ * @file testTimeCode.cpp
+ * @author your name (you@domain.com)
+ * @brief behaviour of the timecode chain: frame counting of every type, the generator of a controller
+ * and the clock of a node following it, on a simulated clock
+ * @version 0.1
+ * @date 2026-01-26
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <ArtNetController.hpp>
+#include <ArtNetNode.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "testCheck.hpp"
+#include "testFixture.hpp"
+
+namespace {
+
+using testFixture::now;
+using testFixture::fakeMicros;
+
+ArtNetNode *receiver = nullptr;
+
+uint32_t received = 0;
+uint32_t outOfOrder = 0;
+int64_t lastFrames = -1;
+uint8_t lastType = 0xff;
+
+/**
+ * @brief network without delay, the packets of the generator go straight to the node
+ */
+bool deliver(uint8_t *packet, uint16_t packetLen, uint8_t *, uint8_t, uint16_t targetPort) {
+    uint8_t _senderIp[4] = {2, 0, 0, 1};
+    return receiver->handlePacket(packet, packetLen, _senderIp, sizeof(_senderIp), targetPort, now) == ArtNet::psOk;
+}
+
+bool deliverBroadcast(uint8_t *packet, uint16_t packetLen, uint16_t targetPort) {
+    uint8_t _broadcastIp[4] = {255, 255, 255, 255};
+    return deliver(packet, packetLen, _broadcastIp, sizeof(_broadcastIp), targetPort);
+}
+
+void onTimeCode(const ArtNet::timeCode &tc, uint64_t) {
+
+    int64_t _frames = ArtNet::timeCodeToFrames(tc);
+    if (lastFrames >= 0 && _frames != lastFrames + 1) {
+        outOfOrder++;
+    }
+    lastFrames = _frames;
+    lastType = tc.type;
+    received++;
+}
+
+void testFrameCounting() {
+
+    //every frame of a day maps to a valid label and back
+    for (uint8_t _type = ArtNet::ttFilm; _type <= ArtNet::ttSmpte; _type++) {
+
+        uint32_t _perDay = ArtNet::timeCodeFramesPerDay(_type);
+        bool _roundTrip = true;
+
+        for (uint32_t _frames = 0; _frames < _perDay; _frames += 7) {
+            ArtNet::timeCode _tc = {};
+            ArtNet::framesToTimeCode(_frames, _type, _tc);
+            _tc.type = _type;
+            _roundTrip &= ArtNet::timeCodeToFrames(_tc) == _frames;
+        }
+
+        CHECK(_roundTrip);
+    }
+
+    CHECK(ArtNet::timeCodeFramesPerDay(ArtNet::ttEbu) == 25 * 86400);
+    CHECK(ArtNet::timeCodeFramesPerDay(ArtNet::ttDropFrame) == 2589408);
+
+    //drop frame skips the labels 0 and 1 at the start of a minute, except every tenth minute
+    ArtNet::timeCode _tc = {0, 0, 59, 29, ArtNet::ttDropFrame, 0};
+    ArtNet::framesToTimeCode(ArtNet::timeCodeToFrames(_tc) + 1, ArtNet::ttDropFrame, _tc);
+    CHECK(_tc.minutes == 1 && _tc.seconds == 0 && _tc.frames == 2);
+
+    _tc = {0, 9, 59, 29, ArtNet::ttDropFrame, 0};
+    ArtNet::framesToTimeCode(ArtNet::timeCodeToFrames(_tc) + 1, ArtNet::ttDropFrame, _tc);
+    CHECK(_tc.minutes == 10 && _tc.seconds == 0 && _tc.frames == 0);
+
+    CHECK(ArtNet::timeCodeFramesToMicros(25, ArtNet::ttEbu) == 1000000);
+    CHECK(ArtNet::timeCodeFramesToMicros(30000, ArtNet::ttDropFrame) == 1001000000);
+}
+
+void testGeneratorToNode(uint8_t *MAC) {
+
+    static ArtNetNode::portStorage<1> _ports;
+    static ArtNetNode _node(0x0000, MAC, 6, _ports);
+    _node.setTimeCallback(fakeMicros);
+    _node.setTimeCodeCallback(onTimeCode);
+    _node.setTimeCodeSource(0, 500);
+    receiver = &_node;
+
+    static ArtNetController::controllerStorage<1, 4, 1> _tables;
+    static ArtNetController _controller(0x0000, MAC, 6, _tables);
+    _controller.setTimeCallback(fakeMicros);
+    _controller.setUnicastCallback(deliver);
+    _controller.setBroadcastCallback(deliverBroadcast);
+
+    //one second of EBU timecode from 10:00:00:00, serviced every millisecond
+    ArtNet::timeCode _start = {10, 0, 0, 0, ArtNet::ttEbu, 0};
+    _controller.startTimeCode(_start);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        _controller.service();
+        now += 1000;
+    }
+
+    CHECK(received == 25);
+    CHECK(outOfOrder == 0);
+    CHECK(lastType == ArtNet::ttEbu);
+    CHECK(lastFrames == ArtNet::timeCodeToFrames(_start) + 24);
+    CHECK(_controller.getTimeCodeGeneratorStats().sent == 25);
+    CHECK(_controller.getTimeCodeGeneratorStats().skipped == 0);
+
+    //the clock of the node follows between the packets
+    ArtNet::timeCode _tc;
+    uint32_t _offset;
+    CHECK(_node.getTimeCode(_tc, _offset));
+    CHECK(_tc.hours == 10 && _tc.minutes == 0 && _tc.seconds == 1 && _tc.frames == 0);
+
+    //the generator stops, the clock is extrapolated for the hold time
+    _controller.stopTimeCode();
+    now += 200000;
+    _controller.service();
+    CHECK(received == 25);
+    CHECK(_node.getTimeCode(_tc, _offset));
+    CHECK(_tc.seconds == 1 && _tc.frames == 5);
+
+    now += 400000;
+    CHECK(!_node.getTimeCode(_tc, _offset));
+
+    //a generator serviced too late skips frames instead of sending a burst, a restart clears the counters
+    _controller.startTimeCode(_start);
+    _controller.service();
+    now += 200000;
+    _controller.service();
+    CHECK(_controller.getTimeCodeGeneratorStats().skipped == 4);
+    CHECK(_controller.getTimeCodeGeneratorStats().sent == 2);
+
+    //invalid labels are rejected
+    uint8_t _invalid[19] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x97, 0x00, 14, 0, 0, 25, 0, 0, 10, ArtNet::ttEbu};
+    uint8_t _senderIp[4] = {2, 0, 0, 1};
+    CHECK(_node.handlePacket(_invalid, sizeof(_invalid), _senderIp, 4, 0x1936) == ArtNet::psInvalidContent);
+}
+
+}
+
+int main() {
+
+    uint8_t _mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    testFrameCounting();
+    testGeneratorToNode(_mac);
+
+    return testCheck::result("testTimeCode");
+}